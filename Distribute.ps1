@@ -40,6 +40,19 @@ New-Item -ItemType Directory -Force -Path $distributeDirLib *>> $logFile
 New-Item -ItemType Directory -Force -Path $distributeDirInclude *>> $logFile
 
 Copy-Item .\Include\FmGui.hpp -Destination $distributeDirInclude *>> $logFile
+Copy-Item .\Include\FmGuiCore.hpp -Destination $distributeDirInclude *>> $logFile
+Copy-Item .\Include\FmGuiProfiler.hpp -Destination $distributeDirInclude *>> $logFile
+Copy-Item .\Include\FmGuiTelemetry.hpp -Destination $distributeDirInclude *>> $logFile
+Copy-Item .\Include\FmGuiCapture.hpp -Destination $distributeDirInclude *>> $logFile
+Copy-Item .\Include\FmGuiRecorder.hpp -Destination $distributeDirInclude *>> $logFile
+Copy-Item .\Include\FmGuiReplay.hpp -Destination $distributeDirInclude *>> $logFile
+Copy-Item .\Include\FmGuiHistory.hpp -Destination $distributeDirInclude *>> $logFile
+Copy-Item .\Include\FmGuiInput.hpp -Destination $distributeDirInclude *>> $logFile
+Copy-Item .\Include\FmGuiAllocator.hpp -Destination $distributeDirInclude *>> $logFile
+Copy-Item .\Include\FmGuiPanels.hpp -Destination $distributeDirInclude *>> $logFile
+Copy-Item .\Include\FmGuiStats.hpp -Destination $distributeDirInclude *>> $logFile
+Copy-Item .\Include\FmGuiSpectrum.hpp -Destination $distributeDirInclude *>> $logFile
+Copy-Item .\Include\FmGuiPlot.hpp -Destination $distributeDirInclude *>> $logFile
 Copy-Item .\Build\Release\* -Destination ($distributeDirLib + "\release") *>> $logFile
 Copy-Item .\Build\Debug\* -Destination ($distributeDirLib + "\debug") *>> $logFile
 
@@ -111,12 +111,13 @@ ed_fm_release(void)
 
 /*
  * The following is some additional ideas for using FmGui in your systems code:
- * - If you use classes to abstract your code you can make an interface class
- *   that your systems can inherit as seen below:
+ * - If you use classes to abstract your code your systems can inherit the
+ *   IFmGuiable interface class from FmGuiPanels.hpp:
  *
  *   class IFmGuiable
  *   {
  *   public:
+ *       virtual ~IFmGuiable(void) = default;
  *       virtual void VFmGui(void) = 0;
  *   };
  *   
@@ -138,14 +139,52 @@ ed_fm_release(void)
  *       double totalCapacity = 1000.0;
  *   };
  *
- *   // Now in your ImGuiRoutine you can perform a call to this virtual function
- *   // your systems class:
+ *   // Now register the object as a panel, which FmGui calls every frame
+ *   // after your FmGuiRoutine:
  *
  *   std::unique_ptr<FuelSystem> pFuelSystem = std::make_unique<FuelSystem>();
  *
+ *   FmGuiPanelConfig config;
+ *   config.refreshRate = 10.0f; // Fuel changes slowly, run it at 10 Hz.
+ *   FmGui::Panels::Register("Fuel System", pFuelSystem.get(), config);
+ *
+ *   // Each panel can be hidden on its own and costs nothing while it is.
+ *   // FmGui::Panels::SetListVisibility(true) lists their costs.
+ *
+ * - The routine above runs on the render thread, while ed_fm_simulate runs on
+ *   the simulation thread, so reading totalVolume directly is a data race.
+ *   Publish the values through a channel from FmGuiTelemetry.hpp instead:
+ *
+ *   struct FuelSample
+ *   {
+ *       double time, totalVolume;
+ *   };
+ *   static FmGui::Channel<FuelSample, 1024> fuelChannel;
+ *
+ *   void ed_fm_simulate(double dt)
+ *   {
+ *       // Simulate, then publish. Never blocks the simulation thread.
+ *       fuelChannel.Publish(FuelSample { simulationTime, totalVolume });
+ *   }
+ *
  *   static void FmGuiRoutine(void)
  *   {
- *       // Call the Gui routine for this particular object.
- *       pFuelSystem->VFmGui();
+ *       // Every sample since the last frame, at the simulation rate.
+ *       fuelChannel.Drain([](const FuelSample &sample) {
+ *           fuelHistory.push_back(sample);
+ *       });
  *   }
+ *
+ * - For whole state structs where only the latest state matters, use a
+ *   snapshot. The routine reads a consistent copy that the simulation thread
+ *   never waits on:
+ *
+ *   static FmGui::Snapshot<EngineState> engineSnapshot;
+ *
+ *   // In ed_fm_simulate:
+ *   engineSnapshot.Publish(engineState);
+ *
+ *   // In FmGuiRoutine:
+ *   engineSnapshot.Update();
+ *   ImGui::Text("N2 = %.1f %%", engineSnapshot.Read().n2);
  */
@@ -38,6 +38,16 @@
 #include <string>
 #include <vector>
 
+#include "FmGuiCore.hpp"
+#include "FmGuiProfiler.hpp"
+#include "FmGuiStats.hpp"
+#include "FmGuiTelemetry.hpp"
+#include "FmGuiCapture.hpp"
+#include "FmGuiRecorder.hpp"
+#include "FmGuiHistory.hpp"
+#include "FmGuiAllocator.hpp"
+#include "FmGuiPanels.hpp"
+
 /*
  * ImGui headers not included in this file. The user will need to do this
  * themselves
@@ -59,119 +69,18 @@
 // Forward declare IDXGISwapChain structure.
 struct IDXGISwapChain;
 
-enum struct FmGuiStyle
-{
-	CLASSIC,
-	DARK,
-	LIGHT
-};
-
-// Forward declare typedef for ImGuiConfigFlags.
-using ImGuiConfigFlags = int;
-
-struct FmGuiConfig
-{
-public:
-	FmGuiConfig(void);
-	FmGuiConfig(const FmGuiConfig &) = default;
-	FmGuiConfig &operator=(const FmGuiConfig &) = default;
-	FmGuiConfig(FmGuiConfig &&) noexcept = default;
-	FmGuiConfig &operator=(FmGuiConfig &&) noexcept = default;
-public:
-	/*
-	 * Enumeration that can be set to the three default styles provided by ImGui
-	 * in the form FmGuiStyle::CLASSIC, FmGuiStyle::DARK, & FmGuiStyle::LIGHT.
-	 * Default value: FmGuiStyle::DARK
-	 */
-	FmGuiStyle imGuiStyle;
-	/*
-	 * The configuration flags passed to the ImGui context. See ImGui
-	 * documentation for ImGuiConfigFlags.
-	 * Default value: ImGuiConfigFlags_NavNoCaptureKeyboard
-	 */
-	ImGuiConfigFlags imGuiConfigFlags;
-	/*
-	 * Full path and filename of the auto generated ImGui .ini configuration file.
-	 * This can be a full or relative path. See Examples/Fm.cpp for more info.
-	 * This string is empty by default and results in no configuration file.
-	 * Default value: "" (empty)
-	 */
-	std::string imGuiIniFileName;
-	/*
-	 * The rate in seconds at which the .ini configuration file is updated.
-	 * Only applicable when the ImGui .ini is enabled.
-	 * Default value: 5.0f
-	 */
-	float imGuiIniSavingRate;
-};
-
-enum struct FmGuiMessageSeverity
-{
-	NOTIFICATION,
-	LOW,
-	MEDIUM,
-	HIGH
-};
-
-struct FmGuiMessage
-{
-public:
-	FmGuiMessage(
-		FmGuiMessageSeverity severity,
-		const std::string &content,
-		const std::string &file,
-		const std::string &function,
-		std::size_t line
-	);
-	FmGuiMessage(const FmGuiMessage &) = default;
-	FmGuiMessage &operator=(const FmGuiMessage &) = default;
-	FmGuiMessage(FmGuiMessage &&) noexcept = default;
-	FmGuiMessage &operator=(FmGuiMessage &&) noexcept = default;
-public:
-	FmGuiMessageSeverity severity;
-	std::string content;
-	std::string file;
-	std::string function;
-	std::size_t line;
-};
-
-inline FmGuiMessage::FmGuiMessage(
-	 FmGuiMessageSeverity severity,
-	 const std::string &content,
-	 const std::string &file,
-	 const std::string &function,
-	 std::size_t line
-	)
-	: severity(severity),
-	  content(content),
-	  file(file),
-	  function(function),
-	  line(line)
-{
-}
-
-using FmGuiMessageCallback =
-	std::add_pointer<void(const FmGuiMessage &message)>::type;
-using FmGuiRoutinePtr = std::add_pointer<void(void)>::type;
 using FmGuiInputRoutinePtr = std::add_pointer<void(UINT uMsg, WPARAM wParam,
 												   LPARAM lParam)>::type;
 
 namespace FmGui
 {
-/*
- * Set pointer to function that uses the ImGui immediate mode widgets.
- * See FmGuiRoutinePtr for a specification.
- * Example:
- * void FmGuiRoutine(void)
- * {
- * 	   ImGui::ShowDemoWindow();
- * }
- * Elsewhere perform a call to SetRoutinePtr(FmGuiRoutine);
- */
-void SetRoutinePtr(FmGuiRoutinePtr pRoutine);
 /*
  * Set pointer to function that handles Win32 WndProc input.
- * See FmGuiInputRoutinePtr for a specification.
+ * See FmGuiInputRoutinePtr for a specification. Every window message received
+ * while the widgets are shown is queued and passed to the routine on the render
+ * thread, before the next frame. Messages are dropped if more than 512 arrive
+ * between two frames. Pointers passed in wParam or lParam may no longer be
+ * valid by then.
  * Example:
  * void FmGuiInputRoutine(UINT uMsg, WPARAM wParam, LPARAM lParam)
  * {
@@ -192,10 +101,6 @@ void SetRoutinePtr(FmGuiRoutinePtr pRoutine);
  * https://docs.microsoft.com/en-us/windows/win32/learnwin32/keyboard-input
  */
 void SetInputRoutinePtr(FmGuiInputRoutinePtr pInputRoutine);
-/*
- * Set all widget visibility and return previous value.
- */
-bool SetWidgetVisibility(bool isEnabled);
 /*
  * Start the FmGui and ImGui.
  * You can supply an optional configuration using an FmGuiConfig object.
@@ -212,24 +117,24 @@ bool StartupHook(const FmGuiConfig &config = FmGuiConfig());
  */
 std::string AddressDump(void);
 /*
- * Return a string message with the last error generated by FmGui.
+ * Write the D3D context memory addresses to pBuffer without allocating. Like
+ * std::snprintf the text is truncated to bufferSize, and the length of the
+ * whole text is returned.
  */
-const FmGuiMessage &GetLastError(void);
-/*
- * Return a vector of error messages in order of first to last occurence.
- */
-std::vector<FmGuiMessage> GetEveryMessage(void);
-/*
- * Sets the FmGuiMessageCallback to be used by FmGui.
- */
-void SetMessageCallback(FmGuiMessageCallback pMessageCallback);
+std::size_t AddressDump(char *pBuffer, std::size_t bufferSize);
 /*
  * Return formatted string of the D3D debug layer warning/error
- * messages. Note: DirectX 11 does not have a callback to do this
+ * messages, one per line. Note: DirectX 11 does not have a callback to do this
  * in real time. Only a vaild call if the hook was started successfully.
  * Returns an empty string to indicate and error.
  */
 std::string DebugLayerMessageDump(void);
+/*
+ * Write the D3D debug layer messages to pBuffer like AddressDump, without
+ * allocating once the largest message has been seen. The messages are removed
+ * from the queue, including those that did not fit. Returns 0 on error.
+ */
+std::size_t DebugLayerMessageDump(char *pBuffer, std::size_t bufferSize);
 /*
  * Shutdown the FmGui and ImGui.
  */
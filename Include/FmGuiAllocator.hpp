@@ -0,0 +1,185 @@
+/* =============================================================================
+** DCS-EFM-ImGui, file: FmGuiAllocator.hpp Created: 17-OCT-2026
+**
+** Copyright 2022 Brian Hoffpauir, USA
+** All rights reserved.
+**
+** Redistribution and use of this source file, with or without modification, is
+** permitted provided that the following conditions are met:
+**
+** 1. Redistributions of this source file must retain the above copyright
+**    notice, this list of conditions and the following disclaimer.
+**
+** 2. Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and/or other materials provided with the distribution.
+**
+** THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+** WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO
+** EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+** PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+** OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+** WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+** OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+** ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+** =============================================================================
+**/
+#ifndef _FMGUI_ALLOCATOR_HPP_
+#define _FMGUI_ALLOCATOR_HPP_ 0
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+/*
+ * FmGui's own memory, kept apart from the CRT heap that DCS: World uses from
+ * many threads.
+ *
+ * With FmGuiConfig::useDedicatedAllocator, ImGui and ImPlot allocate through
+ * ImGui::SetAllocatorFunctions from size class pools. Small blocks are carved
+ * from 256 KiB slabs and large ones rounded up to a power of two, both mapped
+ * straight from the operating system. Freed blocks go back to their pool and
+ * are only returned to the system at shutdown, so once ImGui's buffers reached
+ * their working size a frame makes no heap or system calls at all.
+ *
+ * The frame arena holds transient buffers of the widget routine, e.g. sorted
+ * table rows, that only need to live until the next frame. It is a bump
+ * allocator reset at the start of every frame and is always available.
+ *
+ * Without the dedicated allocator ImGui's allocations still pass through here
+ * to the previous allocator, so the frame statistics count them either way.
+ *
+ * FmGui's own containers that grow while frames run, those of the panels and
+ * of the input recording, use Allocator::Vector and are counted as well. Other
+ * allocations that bypass ImGui, e.g. a std::vector growing in the widget
+ * routine, are only counted where the global operator new calls
+ * CountExternalAllocation, as FmGuiReplay's does. The EFM DLL shares operator
+ * new with DCS: World and does not replace it, so in the sim the counts cover
+ * ImGui, ImPlot and FmGui but not the widget routine's own containers, unless
+ * they use Allocator::Vector too. Run your panels in FmGuiReplay with
+ * --max-frame-allocs to catch the rest.
+ */
+
+struct FmGuiAllocatorStats
+{
+	// Bytes requested by the live allocations, and their highest value.
+	std::size_t liveBytes;
+	std::size_t peakLiveBytes;
+	// Bytes mapped from the operating system for the pools.
+	std::size_t reservedBytes;
+	std::uint64_t liveAllocationCount;
+	std::uint64_t totalAllocationCount;
+	// Allocations made in the last complete frame, including external ones.
+	std::uint64_t frameAllocationCount;
+	// Mappings from the operating system, which level off in steady state.
+	std::uint64_t systemAllocationCount;
+	// Frame arena use of the last complete frame and its highest value.
+	std::size_t frameArenaBytes;
+	std::size_t frameArenaPeakBytes;
+	// Frame arena requests that did not fit and returned nullptr.
+	std::uint64_t frameArenaOverflowCount;
+};
+
+namespace FmGui
+{
+namespace Allocator
+{
+/*
+ * Allocation functions with the signature of ImGuiMemAllocFunc and
+ * ImGuiMemFreeFunc. Safe to call from any thread, although ImGui only
+ * allocates from the thread running the frames.
+ */
+void *Allocate(std::size_t size, void *pUserData);
+void Free(void *pBlock, void *pUserData);
+/*
+ * Memory that stays valid until the start of the next frame, aligned to 16
+ * bytes. Returns nullptr if the arena is full. Render thread only.
+ */
+void *AllocateFrame(std::size_t size);
+template <typename T>
+T *AllocateFrameArray(std::size_t count)
+{
+	return static_cast<T *>(AllocateFrame(count * sizeof(T)));
+}
+FmGuiAllocatorStats GetStats(void);
+/*
+ * Count an allocation that did not go through Allocate towards the frame
+ * statistics, e.g. from a global operator new replaced by a test harness.
+ * Wait free.
+ */
+void CountExternalAllocation(void);
+/*
+ * Number of allocations counted since startup. FmGui::Core takes the
+ * difference over each frame stage.
+ */
+std::uint64_t GetAllocationCount(void);
+
+/*
+ * Called by FmGui::Core. Initialize reserves the frame arena and Install
+ * routes ImGui's allocations through Allocate, to the pools with usePools and
+ * to the previous allocator otherwise; both must happen before the ImGui
+ * context is created. Uninstall restores the previous ImGui allocator once the
+ * contexts are destroyed and gives the pools' memory back to the system. If
+ * allocations are still live, Allocate and Free stay installed and the last
+ * Free does this instead, so no block reaches the wrong free function.
+ */
+bool Initialize(std::size_t frameArenaSize);
+void Install(bool usePools);
+void Uninstall(void);
+void BeginFrame(void);
+void Shutdown(void);
+
+/*
+ * Standard allocator whose allocations are counted towards the frame
+ * statistics. The memory comes from std::malloc rather than operator new, so
+ * it is not counted twice where operator new counts as well. Usable before
+ * Initialize and after Shutdown.
+ */
+template <typename T>
+class StdAllocator
+{
+public:
+	using value_type = T;
+
+	StdAllocator(void) = default;
+	template <typename U>
+	StdAllocator(const StdAllocator<U> &)
+	{
+	}
+
+	T *allocate(std::size_t count)
+	{
+		void *const pMemory = std::malloc(count * sizeof(T));
+		if (pMemory == nullptr)
+			throw std::bad_alloc();
+		CountExternalAllocation();
+		return static_cast<T *>(pMemory);
+	}
+	void deallocate(T *pMemory, std::size_t count)
+	{
+		std::free(pMemory);
+	}
+};
+
+template <typename T, typename U>
+bool operator==(const StdAllocator<T> &, const StdAllocator<U> &)
+{
+	return true;
+}
+
+template <typename T, typename U>
+bool operator!=(const StdAllocator<T> &, const StdAllocator<U> &)
+{
+	return false;
+}
+
+template <typename T>
+using Vector = std::vector<T, StdAllocator<T>>;
+} // namespace Allocator
+} // namespace FmGui
+
+#endif /* !_FMGUI_ALLOCATOR_HPP_ */
@@ -0,0 +1,274 @@
+/* =============================================================================
+** DCS-EFM-ImGui, file: FmGuiCapture.hpp Created: 17-OCT-2026
+**
+** Copyright 2022 Brian Hoffpauir, USA
+** All rights reserved.
+**
+** Redistribution and use of this source file, with or without modification, is
+** permitted provided that the following conditions are met:
+**
+** 1. Redistributions of this source file must retain the above copyright
+**    notice, this list of conditions and the following disclaimer.
+**
+** 2. Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and/or other materials provided with the distribution.
+**
+** THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+** WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO
+** EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+** PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+** OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+** WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+** OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+** ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+** =============================================================================
+**/
+#ifndef _FMGUI_CAPTURE_HPP_
+#define _FMGUI_CAPTURE_HPP_ 0
+
+#include "FmGuiTelemetry.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <atomic>
+#include <type_traits>
+
+/*
+ * Oscilloscope style triggered capture, for transient events like departures,
+ * stalls or gear collapses. The widget routine arms a trigger, the simulation
+ * thread pushes every sample together with the value the trigger looks at,
+ * and once the trigger fires the PreCount samples before the event, the event
+ * and the PostCount samples after it are frozen in place for inspection.
+ */
+
+enum struct FmGuiTriggerMode : std::uint8_t
+{
+	// The value is above, or below, the threshold.
+	ABOVE,
+	BELOW,
+	// The value crosses the threshold upwards, or downwards.
+	RISING_EDGE,
+	FALLING_EDGE,
+	// The change of the value since the previous sample is above the
+	// threshold, or below its negation. Divide a rate per second by the
+	// sample rate to get the threshold.
+	RATE_ABOVE,
+	RATE_BELOW
+};
+
+struct FmGuiTrigger
+{
+	FmGuiTriggerMode mode;
+	float threshold;
+};
+
+enum struct FmGuiCaptureState : std::uint8_t
+{
+	// Push() returns immediately.
+	IDLE,
+	// Samples are kept for the pre trigger window and the trigger is checked.
+	ARMED,
+	// The trigger fired, post trigger samples are being kept.
+	TRIGGERED,
+	// The capture is complete and frozen until armed again.
+	CAPTURED
+};
+
+namespace FmGui
+{
+/*
+ *     static FmGui::Capture<AeroSample, 500, 1500> stallCapture;
+ *
+ *     // Render thread, e.g. from an Arm button.
+ *     stallCapture.Arm(FmGuiTrigger { FmGuiTriggerMode::ABOVE, 0.3f });
+ *
+ *     // Simulation thread, in ed_fm_simulate.
+ *     stallCapture.Push(aeroSample, aeroSample.angleOfAttack);
+ *
+ *     // Render thread, in the widget routine.
+ *     if (stallCapture.GetState() == FmGuiCaptureState::CAPTURED) {
+ *         for (std::size_t index = 0; index < stallCapture.GetSize(); ++index)
+ *             ... stallCapture[index] ...
+ *     }
+ */
+template <typename T, std::size_t PreCount, std::size_t PostCount>
+class Capture
+{
+	static_assert(std::is_trivially_copyable<T>::value,
+				  "Capture samples must be trivially copyable.");
+public:
+	// Samples around and including the trigger sample.
+	static constexpr std::size_t capacity = PreCount + 1 + PostCount;
+
+	Capture(void)
+		: state(static_cast<std::uint8_t>(FmGuiCaptureState::IDLE)),
+		  mode(static_cast<std::uint8_t>(FmGuiTriggerMode::ABOVE)),
+		  threshold(0.0f),
+		  head(0),
+		  size(0),
+		  postCount(0),
+		  previousValue(0.0f),
+		  hasPreviousValue(false)
+	{
+	}
+	Capture(const Capture &) = delete;
+	Capture &operator=(const Capture &) = delete;
+
+	/*
+	 * Render thread. Arm the trigger, discarding any previous capture and the
+	 * samples kept so far. Returns false while a capture is in progress.
+	 */
+	bool Arm(const FmGuiTrigger &trigger)
+	{
+		std::uint8_t currentState = state.load(std::memory_order_acquire);
+		if (currentState == triggeredState)
+			return false;
+		mode.store(static_cast<std::uint8_t>(trigger.mode),
+				   std::memory_order_relaxed);
+		threshold.store(trigger.threshold, std::memory_order_relaxed);
+		// Fails if the simulation thread triggered meanwhile.
+		while (!state.compare_exchange_weak(currentState, armingState,
+											std::memory_order_acq_rel)) {
+			if (currentState == triggeredState)
+				return false;
+		}
+		return true;
+	}
+	/*
+	 * Render thread. Stop watching for the trigger. A capture in progress or
+	 * complete is kept.
+	 */
+	void Disarm(void)
+	{
+		std::uint8_t expected = armingState;
+		if (!state.compare_exchange_strong(expected, idleState,
+										   std::memory_order_acq_rel)) {
+			expected = armedState;
+			state.compare_exchange_strong(expected, idleState,
+										  std::memory_order_acq_rel);
+		}
+	}
+	FmGuiCaptureState GetState(void) const
+	{
+		const std::uint8_t currentState = state.load(std::memory_order_acquire);
+		if (currentState == armingState)
+			return FmGuiCaptureState::ARMED;
+		return static_cast<FmGuiCaptureState>(currentState);
+	}
+
+	/*
+	 * Simulation thread. value is what the trigger compares, e.g. the angle
+	 * of attack of the sample. Costs a load and a branch while idle or
+	 * captured.
+	 */
+	void Push(const T &sample, float value)
+	{
+		std::uint8_t currentState = state.load(std::memory_order_acquire);
+		if (currentState == idleState || currentState == capturedState)
+			return;
+		if (currentState == armingState) {
+			// Only this thread writes the buffer, so it also resets it.
+			head = 0;
+			size = 0;
+			postCount = 0;
+			hasPreviousValue = false;
+			if (!state.compare_exchange_strong(currentState, armedState,
+											   std::memory_order_acq_rel)) {
+				return;
+			}
+			currentState = armedState;
+		}
+		samples[head] = sample;
+		head = (head + 1 == capacity) ? 0 : head + 1;
+		if (size < capacity)
+			++size;
+		if (currentState == armedState) {
+			// Fails if the render thread disarmed or armed again meanwhile.
+			if (IsTriggered(value)
+				&& state.compare_exchange_strong(currentState,
+					triggeredState, std::memory_order_acq_rel)) {
+				// Keep at most PreCount samples before the trigger.
+				size = std::min(size, PreCount + 1);
+				if (PostCount == 0)
+					Complete();
+			}
+		} else if (++postCount == PostCount) {
+			Complete();
+		}
+		previousValue = value;
+		hasPreviousValue = true;
+	}
+
+	/*
+	 * Render thread, only while GetState() returns CAPTURED. Samples by age,
+	 * 0 is the oldest.
+	 */
+	std::size_t GetSize(void) const
+	{
+		return size;
+	}
+	std::size_t GetTriggerIndex(void) const
+	{
+		return size - 1 - PostCount;
+	}
+	const T &operator[](std::size_t index) const
+	{
+		const std::size_t oldest = (head + capacity - size) % capacity;
+		return samples[(oldest + index) % capacity];
+	}
+private:
+	static constexpr std::uint8_t idleState =
+		static_cast<std::uint8_t>(FmGuiCaptureState::IDLE);
+	static constexpr std::uint8_t armedState =
+		static_cast<std::uint8_t>(FmGuiCaptureState::ARMED);
+	static constexpr std::uint8_t triggeredState =
+		static_cast<std::uint8_t>(FmGuiCaptureState::TRIGGERED);
+	static constexpr std::uint8_t capturedState =
+		static_cast<std::uint8_t>(FmGuiCaptureState::CAPTURED);
+	// Armed by the render thread, not yet seen by the simulation thread.
+	static constexpr std::uint8_t armingState = capturedState + 1;
+
+	void Complete(void)
+	{
+		// Only from TRIGGERED, so a state set by the render thread is kept.
+		std::uint8_t expected = triggeredState;
+		state.compare_exchange_strong(expected, capturedState,
+									  std::memory_order_acq_rel);
+	}
+	bool IsTriggered(float value) const
+	{
+		const float level = threshold.load(std::memory_order_relaxed);
+		switch (static_cast<FmGuiTriggerMode>(
+			mode.load(std::memory_order_relaxed))) {
+		case FmGuiTriggerMode::ABOVE:
+			return value > level;
+		case FmGuiTriggerMode::BELOW:
+			return value < level;
+		case FmGuiTriggerMode::RISING_EDGE:
+			return hasPreviousValue && previousValue <= level && value > level;
+		case FmGuiTriggerMode::FALLING_EDGE:
+			return hasPreviousValue && previousValue >= level && value < level;
+		case FmGuiTriggerMode::RATE_ABOVE:
+			return hasPreviousValue && value - previousValue > level;
+		case FmGuiTriggerMode::RATE_BELOW:
+			return hasPreviousValue && value - previousValue < -level;
+		}
+		return false;
+	}
+
+	std::atomic<std::uint8_t> state;
+	std::atomic<std::uint8_t> mode;
+	std::atomic<float> threshold;
+	// Only written by the simulation thread.
+	alignas(cacheLineSize) std::size_t head, size, postCount;
+	float previousValue;
+	bool hasPreviousValue;
+	T samples[capacity];
+};
+} // namespace FmGui
+
+#endif /* !_FMGUI_CAPTURE_HPP_ */
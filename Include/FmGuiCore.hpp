@@ -0,0 +1,523 @@
+/* =============================================================================
+** DCS-EFM-ImGui, file: FmGuiCore.hpp Created: 17-OCT-2026
+**
+** Copyright 2022 Brian Hoffpauir, USA
+** All rights reserved.
+**
+** Redistribution and use of this source file, with or without modification, is
+** permitted provided that the following conditions are met:
+**
+** 1. Redistributions of this source file must retain the above copyright
+**    notice, this list of conditions and the following disclaimer.
+**
+** 2. Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and/or other materials provided with the distribution.
+**
+** THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+** WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO
+** EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+** PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+** OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+** WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+** OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+** ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+** =============================================================================
+**/
+#ifndef _FMGUI_CORE_HPP_
+#define _FMGUI_CORE_HPP_ 0
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <string>
+#include <vector>
+
+/*
+ * The platform neutral part of FmGui. Everything in this file builds without
+ * Windows.h, Direct3D or MinHook. FmGui.hpp includes this file, so users of
+ * the present hook do not need to include it themselves.
+ *
+ * The frame driver owns the ImGui (and optionally ImPlot) context and runs the
+ * NewFrame, user routine and Render sequence. Drawing is delegated to an
+ * FmGuiRenderer. The present hook supplies a Direct3D 11 renderer, while a
+ * null renderer is provided for running frames headless, e.g. to profile the
+ * CPU cost of a frame without starting DCS: World.
+ */
+
+// Forward declare ImDrawData structure.
+struct ImDrawData;
+
+enum struct FmGuiStyle
+{
+	CLASSIC,
+	DARK,
+	LIGHT
+};
+
+// Forward declare typedef for ImGuiConfigFlags.
+using ImGuiConfigFlags = int;
+
+struct FmGuiConfig
+{
+public:
+	FmGuiConfig(void);
+	FmGuiConfig(const FmGuiConfig &) = default;
+	FmGuiConfig &operator=(const FmGuiConfig &) = default;
+	FmGuiConfig(FmGuiConfig &&) noexcept = default;
+	FmGuiConfig &operator=(FmGuiConfig &&) noexcept = default;
+public:
+	/*
+	 * Enumeration that can be set to the three default styles provided by ImGui
+	 * in the form FmGuiStyle::CLASSIC, FmGuiStyle::DARK, & FmGuiStyle::LIGHT.
+	 * Default value: FmGuiStyle::DARK
+	 */
+	FmGuiStyle imGuiStyle;
+	/*
+	 * The configuration flags passed to the ImGui context. See ImGui
+	 * documentation for ImGuiConfigFlags.
+	 * Default value: ImGuiConfigFlags_NavNoCaptureKeyboard
+	 */
+	ImGuiConfigFlags imGuiConfigFlags;
+	/*
+	 * Full path and filename of the auto generated ImGui .ini configuration file.
+	 * This can be a full or relative path. See Examples/Fm.cpp for more info.
+	 * This string is empty by default and results in no configuration file.
+	 * Default value: "" (empty)
+	 */
+	std::string imGuiIniFileName;
+	/*
+	 * The rate in seconds at which the .ini configuration file is updated.
+	 * Only applicable when the ImGui .ini is enabled.
+	 * Default value: 5.0f
+	 */
+	float imGuiIniSavingRate;
+	/*
+	 * Number of failed initialization attempts after which FmGui gives up
+	 * attaching and stays out of the way. See FmGuiInitState.
+	 * Default value: 10
+	 */
+	unsigned int initAttemptLimit;
+	/*
+	 * Number of frames to wait after the first failed initialization attempt.
+	 * The delay doubles after every further failure, up to 600 frames.
+	 * Default value: 1
+	 */
+	unsigned int initRetryDelay;
+	/*
+	 * Have ImGui allocate from FmGui's own size class pools instead of the
+	 * CRT heap. See FmGuiAllocator.hpp.
+	 * Default value: false
+	 */
+	bool useDedicatedAllocator;
+	/*
+	 * Size of the frame arena in bytes, see FmGui::Allocator::AllocateFrame.
+	 * Zero disables the arena.
+	 * Default value: 262144
+	 */
+	std::size_t frameArenaSize;
+	/*
+	 * CPU time in microseconds the registered panels may take per frame, see
+	 * FmGui::Panels::Run. Panels over it are put off to later frames. Zero
+	 * runs every due panel.
+	 * Default value: 0.0f
+	 */
+	float panelBudget;
+	/*
+	 * Rate in Hz at which the widgets are rebuilt. In between, the draw data
+	 * of the last rebuild is submitted again, so the widgets stay on screen
+	 * every Present for a fraction of the cost. Input and
+	 * FmGui::Core::RequestRebuild force a rebuild in the next frame. Zero
+	 * rebuilds every frame.
+	 * Default value: 0.0f
+	 */
+	float refreshRate;
+};
+
+/*
+ * Initialization progresses through these states in order. Progress made by
+ * a failed attempt is kept, e.g. the ImGui context is only created once.
+ */
+enum struct FmGuiInitState : std::uint8_t
+{
+	// Creating the ImGui (and ImPlot) context.
+	CONTEXT,
+	// Initializing the renderer, see FmGuiRenderer::pInitialize.
+	RENDERER,
+	READY,
+	// FmGuiConfig::initAttemptLimit was reached. Frames are never run.
+	GAVE_UP
+};
+
+enum struct FmGuiMessageSeverity : std::uint8_t
+{
+	NOTIFICATION,
+	LOW,
+	MEDIUM,
+	HIGH
+};
+
+/*
+ * A message record. It owns no memory: the source location points at the
+ * string literals from __FILE__ and __func__ and the content is stored inline,
+ * so records can be created, copied and logged without touching the heap.
+ */
+struct FmGuiMessage
+{
+public:
+	static constexpr std::size_t contentSize = 128;
+public:
+	FmGuiMessage(void);
+	FmGuiMessage(const FmGuiMessage &) = default;
+	FmGuiMessage &operator=(const FmGuiMessage &) = default;
+public:
+	// Source location. Strings with static lifetime, never nullptr.
+	const char *file;
+	const char *function;
+	// Steady clock time of the push in nanoseconds.
+	std::uint64_t timestamp;
+	std::uint32_t line;
+	FmGuiMessageSeverity severity;
+	// NUL terminated and truncated to contentSize - 1 characters.
+	char content[contentSize];
+};
+
+inline FmGuiMessage::FmGuiMessage(void)
+	: file(""),
+	  function(""),
+	  timestamp(0),
+	  line(0),
+	  severity(FmGuiMessageSeverity::NOTIFICATION)
+{
+	content[0] = '\0';
+}
+
+/*
+ * Push a message from any thread. Prefer the macros, which fill in the source
+ * location. FMGUI_PUSH_MSGF takes a printf style format, which is formatted
+ * straight into the message record.
+ * Example:
+ * FMGUI_PUSH_MSGF(FmGuiMessageSeverity::HIGH, "MH_EnableHook failed: %s!",
+ *                 MH_StatusToString(mhStatus));
+ */
+#define FMGUI_PUSH_MSG(SEVERITY, CONTENT) \
+	FmGui::PushMessage((SEVERITY), __FILE__, __func__, __LINE__, "%s", \
+					   (CONTENT))
+#define FMGUI_PUSH_MSGF(SEVERITY, ...) \
+	FmGui::PushMessage((SEVERITY), __FILE__, __func__, __LINE__, __VA_ARGS__)
+/*
+ * Has GCC and Clang check the arguments of a printf style function against
+ * its format at compile time.
+ */
+#if defined __GNUC__
+#define FMGUI_PRINTF_FORMAT(FORMAT_INDEX, FIRST_ARG_INDEX) \
+	__attribute__((format(printf, FORMAT_INDEX, FIRST_ARG_INDEX)))
+#else
+#define FMGUI_PRINTF_FORMAT(FORMAT_INDEX, FIRST_ARG_INDEX)
+#endif
+
+using FmGuiMessageCallback =
+	std::add_pointer<void(const FmGuiMessage &message)>::type;
+using FmGuiRoutinePtr = std::add_pointer<void(void)>::type;
+using FmGuiRendererInitializePtr =
+	std::add_pointer<bool(void *pUserData)>::type;
+using FmGuiRendererNewFramePtr =
+	std::add_pointer<bool(void *pUserData)>::type;
+using FmGuiRendererRenderDrawDataPtr =
+	std::add_pointer<void(ImDrawData *pDrawData, void *pUserData)>::type;
+using FmGuiRendererPresentPtr = std::add_pointer<void(void *pUserData)>::type;
+using FmGuiRendererCreateTexturePtr = std::add_pointer<void *(
+	unsigned int width, unsigned int height, void *pUserData)>::type;
+using FmGuiRendererUpdateTexturePtr = std::add_pointer<bool(void *pTexture,
+	unsigned int y, unsigned int height, const std::uint32_t *pPixels,
+	void *pUserData)>::type;
+using FmGuiRendererDestroyTexturePtr =
+	std::add_pointer<void(void *pTexture, void *pUserData)>::type;
+
+struct FmGuiRenderer
+{
+public:
+	FmGuiRenderer(void);
+	FmGuiRenderer(const FmGuiRenderer &) = default;
+	FmGuiRenderer &operator=(const FmGuiRenderer &) = default;
+public:
+	/*
+	 * Called with the ImGui context current until it returns true. It should
+	 * keep track of its own partial progress, since a failed attempt is
+	 * retried with a backoff. May be nullptr.
+	 */
+	FmGuiRendererInitializePtr pInitialize;
+	/*
+	 * Called before ImGui::NewFrame. Must start the platform and renderer
+	 * backend frames, which at minimum set ImGuiIO::DisplaySize and
+	 * ImGuiIO::DeltaTime. Returning false skips the frame.
+	 */
+	FmGuiRendererNewFramePtr pNewFrame;
+	/*
+	 * Called after ImGui::Render with the draw data of the frame.
+	 */
+	FmGuiRendererRenderDrawDataPtr pRenderDrawData;
+	/*
+	 * Called last in every frame that was run, e.g. to present the swap chain.
+	 * Timed as FmGuiFrameStage::PRESENT. May be nullptr.
+	 */
+	FmGuiRendererPresentPtr pPresent;
+	/*
+	 * Create a width by height RGBA8 texture and return it as an ImTextureID,
+	 * or nullptr on failure. The contents are undefined until updated. May be
+	 * nullptr if the renderer has no textures of its own.
+	 */
+	FmGuiRendererCreateTexturePtr pCreateTexture;
+	/*
+	 * Replace the rows y to y + height - 1 of a texture with tightly packed
+	 * RGBA8 pixels, the first byte being red. May be nullptr only if
+	 * pCreateTexture is.
+	 */
+	FmGuiRendererUpdateTexturePtr pUpdateTexture;
+	/*
+	 * Release a texture returned by pCreateTexture. May be nullptr only if
+	 * pCreateTexture is.
+	 */
+	FmGuiRendererDestroyTexturePtr pDestroyTexture;
+	/*
+	 * Passed unmodified to the functions above.
+	 */
+	void *pUserData;
+};
+
+inline FmGuiRenderer::FmGuiRenderer(void)
+	: pInitialize(nullptr),
+	  pNewFrame(nullptr),
+	  pRenderDrawData(nullptr),
+	  pPresent(nullptr),
+	  pCreateTexture(nullptr),
+	  pUpdateTexture(nullptr),
+	  pDestroyTexture(nullptr),
+	  pUserData(nullptr)
+{
+}
+
+/*
+ * State of the null renderer. The caller owns this object and it must outlive
+ * the FmGuiRenderer returned by FmGui::Core::MakeNullRenderer.
+ */
+struct FmGuiNullRendererData
+{
+	float displayWidth;
+	float displayHeight;
+	// Fixed time step in seconds. Keeps headless runs deterministic.
+	float deltaTime;
+};
+
+/*
+ * The timed stages of a frame, in the order they run.
+ */
+enum struct FmGuiFrameStage : std::uint8_t
+{
+	// Renderer NewFrame and ImGui::NewFrame.
+	NEW_FRAME,
+	// The user routine, the registered panels and FmGui's own windows.
+	ROUTINE,
+	// ImGui::EndFrame, ImGui::Render and copying the output of the panels.
+	RENDER,
+	// Renderer RenderDrawData.
+	RENDER_DRAW_DATA,
+	// Renderer Present, the trampoline to DCS: World in the present hook.
+	PRESENT,
+	COUNT
+};
+
+/*
+ * Statistics of one stage, times in microseconds.
+ */
+struct FmGuiStageStats
+{
+	float last;
+	float minimum;
+	float average;
+	float p99;
+	// Allocations of the last frame and the most of any frame, see
+	// FmGui::Allocator.
+	unsigned int lastAllocationCount;
+	unsigned int maxAllocationCount;
+};
+
+struct FmGuiFrameStats
+{
+	// Number of frames the statistics are computed from.
+	std::size_t frameCount;
+	// Number of those frames that rebuilt the widgets, see
+	// FmGuiConfig::refreshRate. The others only submitted the last draw data.
+	std::size_t rebuiltFrameCount;
+	// NEW_FRAME, ROUTINE and RENDER only run in rebuilt frames, so their
+	// statistics are computed from those frames alone.
+	FmGuiStageStats stages[static_cast<std::size_t>(FmGuiFrameStage::COUNT)];
+	// The whole frame, from the start of NEW_FRAME to the end of PRESENT.
+	FmGuiStageStats total;
+	// The whole frame without PRESENT, which is the Present of DCS: World
+	// and its vsync wait. This is what FmGui adds to a Present.
+	FmGuiStageStats overhead;
+};
+
+namespace FmGui
+{
+/*
+ * Set pointer to function that uses the ImGui immediate mode widgets.
+ * See FmGuiRoutinePtr for a specification.
+ * Example:
+ * void FmGuiRoutine(void)
+ * {
+ * 	   ImGui::ShowDemoWindow();
+ * }
+ * Elsewhere perform a call to SetRoutinePtr(FmGuiRoutine);
+ * The routine runs every frame. To refresh systems separately, register them
+ * as panels instead, see FmGuiPanels.hpp.
+ */
+void SetRoutinePtr(FmGuiRoutinePtr pRoutine);
+/*
+ * Record a message in the message log. The log is a fixed size ring that is
+ * allocated up front; pushing never allocates and is safe from any thread,
+ * e.g. both the Present thread and the EFM simulation thread. Once the ring is
+ * full the oldest message is overwritten. A message identical to the previous
+ * one is dropped, so failures that repeat every frame are only logged once.
+ * A message whose slot is still being written by a thread a whole ring behind
+ * is dropped as well, see GetDroppedMessageCount.
+ * The file and function strings must have static lifetime. See the
+ * FMGUI_PUSH_MSG and FMGUI_PUSH_MSGF macros.
+ */
+void PushMessage(
+	FmGuiMessageSeverity severity,
+	const char *file,
+	const char *function,
+	std::uint32_t line,
+	const char *format,
+	...
+) FMGUI_PRINTF_FORMAT(5, 6);
+/*
+ * Return the last message generated by FmGui, or a default constructed
+ * FmGuiMessage if there is none. The log is not modified.
+ */
+FmGuiMessage GetLastError(void);
+/*
+ * Return the number of messages that were not logged because their slot was
+ * still being written. The callback is still called for them.
+ */
+std::uint64_t GetDroppedMessageCount(void);
+/*
+ * Return a vector of the messages in the log in order of first to last
+ * occurence. The log is not modified.
+ */
+std::vector<FmGuiMessage> GetEveryMessage(void);
+/*
+ * Sets the FmGuiMessageCallback to be used by FmGui. The callback is called on
+ * the thread that pushed the message and receives the record being logged.
+ * The reference is only valid for the duration of the call.
+ */
+void SetMessageCallback(FmGuiMessageCallback pMessageCallback);
+/*
+ * Return timing and allocation statistics over the last 256 frames that were
+ * run. Call from the Present thread, e.g. from the widget routine.
+ * Example:
+ * const FmGuiFrameStats stats = FmGui::GetFrameStats();
+ * ImGui::Text("FmGui p99: %.1f us", stats.overhead.p99);
+ */
+FmGuiFrameStats GetFrameStats(void);
+/*
+ * Show or hide the built-in frame statistics window and return the previous
+ * value.
+ */
+bool SetFrameStatsVisibility(bool isVisible);
+/*
+ * Set all widget visibility and return previous value. While the widgets are
+ * hidden no ImGui frame is run at all and the present hook forwards straight
+ * to DCS: World. Safe to call from any thread.
+ */
+bool SetWidgetVisibility(bool isEnabled);
+
+namespace Core
+{
+/*
+ * Start the frame driver with the given configuration. Initialization, which
+ * creates the ImGui (and ImPlot) context and initializes the renderer, is
+ * done by the following calls to Frame.
+ */
+bool Startup(const FmGuiConfig &config = FmGuiConfig());
+/*
+ * Set the renderer used by Frame. See FmGuiRenderer.
+ */
+void SetRenderer(const FmGuiRenderer &renderer);
+/*
+ * Return a renderer that draws nothing. The ImGui font atlas is built on the
+ * first frame but never uploaded anywhere.
+ * Example:
+ * FmGuiNullRendererData nullData = { 1920.0f, 1080.0f, 1.0f / 60.0f };
+ * FmGui::Core::Startup();
+ * FmGui::Core::SetRenderer(FmGui::Core::MakeNullRenderer(&nullData));
+ * for (int frame = 0; frame < 1000; ++frame)
+ *     FmGui::Core::Frame();
+ * FmGui::Core::Shutdown();
+ */
+FmGuiRenderer MakeNullRenderer(FmGuiNullRendererData *pData);
+/*
+ * Create, update and destroy textures with the current renderer, see
+ * FmGuiRenderer::pCreateTexture. Only call these from the frame routine or
+ * between Frame calls on the thread that runs them, after initialization.
+ * CreateTexture returns nullptr if the renderer has no texture support.
+ */
+void *CreateTexture(unsigned int width, unsigned int height);
+bool UpdateTexture(void *pTexture, unsigned int y, unsigned int height,
+	const std::uint32_t *pPixels);
+void DestroyTexture(void *pTexture);
+/*
+ * Return true between successful calls to Startup and Shutdown.
+ */
+bool IsStarted(void);
+/*
+ * Return the current initialization state.
+ */
+FmGuiInitState GetInitState(void);
+/*
+ * Make the next count initialization attempts fail at the given state, as if
+ * creating the context or initializing the renderer had failed. For testing
+ * the retry behaviour with the null renderer.
+ */
+void InjectInitFault(FmGuiInitState state, unsigned int count);
+/*
+ * Return the value last passed to FmGui::SetWidgetVisibility.
+ */
+bool AreWidgetsEnabled(void);
+/*
+ * Return true while initialized with the widgets hidden. Frame does nothing
+ * in this state.
+ */
+bool IsSuspended(void);
+/*
+ * Run one frame: renderer NewFrame, ImGui::NewFrame, the user routine,
+ * ImGui::Render, renderer RenderDrawData and renderer Present. Until
+ * initialized, each call instead makes an initialization attempt or counts down
+ * the backoff after a failed one. Returns false if no frame was run, which
+ * includes every frame while initializing, after giving up and while suspended.
+ * The first frame after a suspension has its delta time clamped and all keys
+ * and mouse buttons released.
+ * With FmGuiConfig::refreshRate set, frames between rebuilds only run the
+ * renderer RenderDrawData and Present with the last draw data.
+ */
+bool Frame(void);
+/*
+ * Have the next frame rebuild the widgets, e.g. after changing what they show
+ * from outside the widget routine. Safe to call from any thread.
+ */
+void RequestRebuild(void);
+/*
+ * Destroy the contexts created by Startup. Renderer backends must be shut
+ * down by the caller first.
+ */
+void Shutdown(void);
+
+} // namespace Core
+
+} // namespace FmGui
+
+#endif /* !_FMGUI_CORE_HPP_ */
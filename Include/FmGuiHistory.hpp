@@ -0,0 +1,202 @@
+/* =============================================================================
+** DCS-EFM-ImGui, file: FmGuiHistory.hpp Created: 17-OCT-2026
+**
+** Copyright 2022 Brian Hoffpauir, USA
+** All rights reserved.
+**
+** Redistribution and use of this source file, with or without modification, is
+** permitted provided that the following conditions are met:
+**
+** 1. Redistributions of this source file must retain the above copyright
+**    notice, this list of conditions and the following disclaimer.
+**
+** 2. Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and/or other materials provided with the distribution.
+**
+** THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+** WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO
+** EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+** PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+** OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+** WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+** OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+** ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+** =============================================================================
+**/
+#ifndef _FMGUI_HISTORY_HPP_
+#define _FMGUI_HISTORY_HPP_ 0
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+/*
+ * Time travel through the full state of the EFM. A state history keeps the
+ * last minutes of a POD state struct as periodic keyframes, which are plain
+ * copies, and in between the XOR of each state with the previous one, with
+ * runs of unchanged 8 byte words stored as a count. Most of an EFM state
+ * stays the same from one tick to the next, so a delta is usually a small
+ * fraction of the struct.
+ *
+ * The encoded states share one ring of byteCapacity bytes, so the memory use
+ * is fixed no matter the state size or tick rate; the oldest keyframe and its
+ * deltas are dropped to make room. Reconstructing a state decodes at most
+ * keyframeInterval deltas from the preceding keyframe, or fewer when stepping
+ * forward from the last reconstructed state while scrubbing.
+ *
+ * A history is not thread safe. Record and reconstruct from one thread, e.g.
+ * drain a FmGui::Channel of states published by ed_fm_simulate in the widget
+ * routine and stop recording while the UI is paused.
+ */
+
+struct FmGuiStateHistoryConfig
+{
+public:
+	FmGuiStateHistoryConfig(void);
+public:
+	/*
+	 * Size of the ring holding the encoded states. Must fit at least two
+	 * keyframes.
+	 * Default value: 32 MiB
+	 */
+	std::size_t byteCapacity;
+	/*
+	 * Maximum number of states kept, whatever their size.
+	 * Default value: 60000, ten minutes at 100 Hz
+	 */
+	std::size_t stateCapacity;
+	/*
+	 * A keyframe is stored every keyframeInterval states, bounding the work
+	 * of a reconstruction.
+	 * Default value: 64
+	 */
+	std::size_t keyframeInterval;
+};
+
+namespace FmGui
+{
+/*
+ * The untyped history behind StateHistory.
+ */
+class StateHistoryBuffer
+{
+public:
+	StateHistoryBuffer(std::size_t stateSize,
+					   const FmGuiStateHistoryConfig &config);
+
+	// Times must not decrease.
+	void Record(double time, const void *pState);
+	void Clear(void);
+	// Number of states kept. Index 0 is the oldest.
+	std::size_t GetSize(void) const;
+	double GetTime(std::size_t index) const;
+	/*
+	 * Index of the newest state recorded at or before time, or 0 if every
+	 * state is newer.
+	 */
+	std::size_t FindIndex(double time) const;
+	// Copies the state at index into pState. Returns false if out of range.
+	bool Reconstruct(std::size_t index, void *pState);
+	// Bytes of the ring taken by the encoded states.
+	std::size_t GetMemoryUsage(void) const;
+	std::size_t GetKeyframeCount(void) const;
+	const FmGuiStateHistoryConfig &GetConfig(void) const;
+private:
+	struct Entry
+	{
+		double time;
+		std::uint32_t offset, size;
+		bool isKeyframe;
+	};
+
+	std::size_t Encode(void);
+	std::size_t Allocate(std::size_t size);
+	void EvictOldest(void);
+	const Entry &GetEntry(std::size_t index) const;
+	void Decode(const Entry &entry, std::uint64_t *pWords) const;
+
+	FmGuiStateHistoryConfig config;
+	std::size_t stateSize, wordCount;
+	std::vector<std::uint8_t> bytes;
+	std::size_t writeOffset, usedBytes;
+	// Ring of entries, the oldest at entryHead.
+	std::vector<Entry> entries;
+	std::size_t entryHead, entryCount, keyframeCount;
+	std::size_t statesSinceKeyframe;
+	// Sequence number of the oldest entry, for the reconstruction cache.
+	std::uint64_t firstSequence;
+	// The last recorded state, the encoded record and the last reconstruction.
+	std::vector<std::uint64_t> previousWords, currentWords, cacheWords;
+	std::vector<std::uint8_t> encoded;
+	std::uint64_t cacheSequence;
+	bool isCacheValid;
+};
+
+/*
+ * State history of the trivially copyable type T.
+ * Example:
+ * static FmGui::StateHistory<FmState> stateHistory;
+ * ...
+ * stateHistory.Record(state.time, state);
+ * ...
+ * FmState pastState;
+ * stateHistory.Reconstruct(stateHistory.FindIndex(scrubTime), pastState);
+ */
+template <typename T>
+class StateHistory
+{
+	static_assert(std::is_trivially_copyable<T>::value,
+				  "StateHistory needs a trivially copyable state type.");
+public:
+	explicit StateHistory(
+		const FmGuiStateHistoryConfig &config = FmGuiStateHistoryConfig())
+		: buffer(sizeof(T), config)
+	{
+	}
+
+	void Record(double time, const T &state)
+	{
+		buffer.Record(time, &state);
+	}
+	void Clear(void)
+	{
+		buffer.Clear();
+	}
+	std::size_t GetSize(void) const
+	{
+		return buffer.GetSize();
+	}
+	double GetTime(std::size_t index) const
+	{
+		return buffer.GetTime(index);
+	}
+	std::size_t FindIndex(double time) const
+	{
+		return buffer.FindIndex(time);
+	}
+	bool Reconstruct(std::size_t index, T &state)
+	{
+		return buffer.Reconstruct(index, &state);
+	}
+	std::size_t GetMemoryUsage(void) const
+	{
+		return buffer.GetMemoryUsage();
+	}
+	std::size_t GetKeyframeCount(void) const
+	{
+		return buffer.GetKeyframeCount();
+	}
+	const FmGuiStateHistoryConfig &GetConfig(void) const
+	{
+		return buffer.GetConfig();
+	}
+private:
+	StateHistoryBuffer buffer;
+};
+} // namespace FmGui
+
+#endif /* !_FMGUI_HISTORY_HPP_ */
@@ -0,0 +1,140 @@
+/* =============================================================================
+** DCS-EFM-ImGui, file: FmGuiInput.hpp Created: 17-OCT-2026
+**
+** Copyright 2022 Brian Hoffpauir, USA
+** All rights reserved.
+**
+** Redistribution and use of this source file, with or without modification, is
+** permitted provided that the following conditions are met:
+**
+** 1. Redistributions of this source file must retain the above copyright
+**    notice, this list of conditions and the following disclaimer.
+**
+** 2. Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and/or other materials provided with the distribution.
+**
+** THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+** WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO
+** EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+** PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+** OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+** WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+** OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+** ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+** =============================================================================
+**/
+#ifndef _FMGUI_INPUT_HPP_
+#define _FMGUI_INPUT_HPP_ 0
+
+#include <cstdint>
+
+/*
+ * Input event queue between the thread receiving the platform's input, the
+ * window thread of DCS: World running FmGui's WndProc, and the render thread.
+ * The window thread translates messages into compact events and pushes them
+ * without waiting, and Core::Frame applies them to ImGuiIO once per frame
+ * before ImGui::NewFrame, so ImGuiIO is only ever touched by the render
+ * thread. Mouse moves are coalesced to the latest position instead of being
+ * queued one by one.
+ *
+ * The events applied in each frame can be recorded to a file and replayed
+ * frame by frame, e.g. by FmGuiReplay on the headless frame driver, to measure
+ * the cost of heavy panels under the exact same interaction every run. Input
+ * recordings are little endian:
+ *
+ *     Header  "FMGUIINP", u32 version, u32 zero, f32 display width,
+ *             f32 display height.
+ *     Frame   u32 'FRAM', u32 event count, f64 seconds since the recording
+ *             started, f32 delta time, u32 zero, then per event u8 type,
+ *             u8 isDown, u16 code, u16 nativeCode, u16 zero, f32 x, f32 y.
+ *
+ * A replay applies the events of one recorded frame per frame, regardless of
+ * the delta time, and ignores live input until it ends. The windows have to
+ * start out in the same place for clicks to land on the same widgets, e.g.
+ * record without an ImGui .ini file.
+ */
+
+enum struct FmGuiInputEventType : std::uint8_t
+{
+	// x and y, in client coordinates.
+	MOUSE_POS,
+	// code is the button, 0 left, 1 right, 2 middle, 3 and 4 the extra ones.
+	MOUSE_BUTTON,
+	// x and y are the horizontal and vertical wheel steps.
+	MOUSE_WHEEL,
+	// code is the ImGuiKey, nativeCode the platform's key code.
+	KEY,
+	// code holds the ImGuiKeyModFlags.
+	KEY_MODS,
+	// code is a UTF-16 code unit.
+	CHARACTER,
+	FOCUS
+};
+
+struct FmGuiInputEvent
+{
+	FmGuiInputEventType type;
+	// MOUSE_BUTTON and KEY: pressed or released. FOCUS: gained or lost.
+	bool isDown;
+	std::uint16_t code;
+	std::uint16_t nativeCode;
+	float x, y;
+};
+
+namespace FmGui
+{
+namespace Input
+{
+// Size of the queue. Events pushed while it is full are dropped and counted.
+static constexpr std::uint32_t eventCapacity = 256;
+
+/*
+ * From the input thread only. Mouse button and wheel events are preceded by
+ * the latest mouse position, so they apply where they happened. Returns false
+ * if the event was dropped.
+ */
+bool PushEvent(const FmGuiInputEvent &event);
+/*
+ * From the input thread only. Replaces the position not yet applied, if any.
+ * Pass -FLT_MAX for both when the mouse left the window.
+ */
+void PushMousePos(float x, float y);
+/*
+ * From the render thread, with the ImGui context current. Called by
+ * FmGui::Core::Frame.
+ */
+void ApplyEvents(void);
+/*
+ * From the render thread. Drops the queued events, e.g. while the widgets are
+ * hidden, so stale key presses are not applied once they are shown again.
+ */
+void DiscardEvents(void);
+/*
+ * From the render thread. Return true if ApplyEvents would apply anything,
+ * which is always the case during a replay. Core::Frame rebuilds the widgets
+ * right away when it does, see FmGuiConfig::refreshRate.
+ */
+bool HasPendingEvents(void);
+std::uint64_t GetDroppedEventCount(void);
+
+/*
+ * From the render thread, e.g. the widget routine. Frames are written through
+ * a large buffer, which reaches the disk every few minutes of input.
+ */
+bool StartRecording(const char *fileName);
+void StopRecording(void);
+bool IsRecording(void);
+/*
+ * Loads the recording into memory. The replay starts with the next frame and
+ * also sets ImGuiIO::DisplaySize to the recorded display size.
+ */
+bool StartReplay(const char *fileName);
+void StopReplay(void);
+bool IsReplaying(void);
+} // namespace Input
+} // namespace FmGui
+
+#endif /* !_FMGUI_INPUT_HPP_ */
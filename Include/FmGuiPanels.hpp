@@ -0,0 +1,158 @@
+/* =============================================================================
+** DCS-EFM-ImGui, file: FmGuiPanels.hpp Created: 17-OCT-2026
+**
+** Copyright 2022 Brian Hoffpauir, USA
+** All rights reserved.
+**
+** Redistribution and use of this source file, with or without modification, is
+** permitted provided that the following conditions are met:
+**
+** 1. Redistributions of this source file must retain the above copyright
+**    notice, this list of conditions and the following disclaimer.
+**
+** 2. Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and/or other materials provided with the distribution.
+**
+** THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+** WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO
+** EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+** PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+** OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+** WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+** OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+** ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+** =============================================================================
+**/
+#ifndef _FMGUI_PANELS_HPP_
+#define _FMGUI_PANELS_HPP_ 0
+
+#include "FmGuiCore.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+/*
+ * Registry of named panels run by FmGui::Core::Frame after the widget
+ * routine, so each system of an EFM can own its windows instead of sharing a
+ * single routine that runs every frame.
+ *
+ * Hidden panels are not called at all. A panel with a refresh rate is only
+ * called when it is due, and in the frames in between FmGui keeps its windows
+ * open and draws the vertices of its last run again, which costs a copy
+ * instead of the whole widget code. A panel runs every frame while one of its
+ * windows is hovered, focused, being moved or holds the active widget, and
+ * while any popup is open, so interaction is never throttled.
+ *
+ * The windows of a panel are the ones it began during its call. Popups and
+ * tooltips are not redrawn in between runs. This relies on the internals of
+ * ImGui 1.87.
+ */
+
+/*
+ * The interface of Examples/Fm.cpp. VFmGui is called on the render thread
+ * with the ImGui context current.
+ */
+class IFmGuiable
+{
+public:
+	virtual ~IFmGuiable(void) = default;
+	virtual void VFmGui(void) = 0;
+};
+
+struct FmGuiPanelConfig
+{
+	FmGuiPanelConfig(void);
+	/*
+	 * Hidden panels are not called and their windows are closed.
+	 * Default value: true
+	 */
+	bool isVisible;
+	/*
+	 * Runs per second, in ImGui time. Zero runs the panel every frame.
+	 * Default value: 0.0f
+	 */
+	float refreshRate;
+};
+
+struct FmGuiPanelStats
+{
+	const char *name;
+	bool isVisible;
+	float refreshRate;
+	// Microseconds of the last run and their moving average.
+	float lastCost;
+	float averageCost;
+	// Frames the panel ran in, and frames its last run was drawn again in.
+	std::uint64_t runCount;
+	std::uint64_t cachedFrameCount;
+	// Frames the panel was due in but put off for the budget, and runs that
+	// took longer than the whole budget on their own.
+	std::uint64_t deferredFrameCount;
+	std::uint64_t overBudgetRunCount;
+};
+
+namespace FmGui
+{
+namespace Panels
+{
+static constexpr std::size_t panelCapacity = 64;
+
+/*
+ * Register a panel under a unique name, a string literal or any other string
+ * that outlives FmGui, as the profiler records it. Returns false if the name
+ * is taken or panelCapacity is reached. Register and unregister before
+ * FmGui::StartupHook or from the render thread.
+ * Example:
+ * FmGui::Panels::Register("Fuel", pFuelSystem.get());
+ * FmGuiPanelConfig config;
+ * config.refreshRate = 10.0f;
+ * FmGui::Panels::Register("Engine", EngineRoutine, config);
+ */
+bool Register(const char *name, IFmGuiable *pPanel,
+			  const FmGuiPanelConfig &config = FmGuiPanelConfig());
+bool Register(const char *name, FmGuiRoutinePtr pRoutine,
+			  const FmGuiPanelConfig &config = FmGuiPanelConfig());
+bool Unregister(const char *name);
+/*
+ * Safe to call from any thread. Return false if no panel has the name.
+ */
+bool SetVisibility(const char *name, bool isVisible);
+bool SetRefreshRate(const char *name, float refreshRate);
+/*
+ * Copy the statistics of up to capacity panels in order of registration and
+ * return the number of registered panels. From the render thread.
+ */
+std::size_t GetStats(FmGuiPanelStats *pStats, std::size_t capacity);
+/*
+ * Show or hide the built-in panel list and return the previous value. The
+ * list shows what every panel costs and toggles their visibility.
+ */
+bool SetListVisibility(bool isVisible);
+
+/*
+ * Called by FmGui::Core::Frame. Run calls the due panels in the routine
+ * stage, and ShowList draws the panel list. PrepareDrawData takes the output
+ * of the panels that ran after ImGui::Render and returns the draw data to
+ * render, with the last output of the others put back in place.
+ *
+ * The budget is FmGuiConfig::panelBudget. Panels the user interacts with and
+ * panels shown again run regardless, the other due panels take turns in the
+ * rest of the budget. A panel that does not fit is put off to the next frame
+ * and its last output is drawn instead. One panel in turn always runs, so a
+ * panel costing more than the whole budget still runs every few frames.
+ */
+void Run(float budget);
+void ShowList(void);
+ImDrawData *PrepareDrawData(ImDrawData *pDrawData);
+/*
+ * Called by FmGui::Core::Shutdown before the ImGui context is destroyed.
+ * Frees the cached output, the panels stay registered.
+ */
+void Shutdown(void);
+} // namespace Panels
+} // namespace FmGui
+
+#endif /* !_FMGUI_PANELS_HPP_ */
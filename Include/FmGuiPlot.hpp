@@ -0,0 +1,659 @@
+/* =============================================================================
+** DCS-EFM-ImGui, file: FmGuiPlot.hpp Created: 17-OCT-2026
+**
+** Copyright 2022 Brian Hoffpauir, USA
+** All rights reserved.
+**
+** Redistribution and use of this source file, with or without modification, is
+** permitted provided that the following conditions are met:
+**
+** 1. Redistributions of this source file must retain the above copyright
+**    notice, this list of conditions and the following disclaimer.
+**
+** 2. Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and/or other materials provided with the distribution.
+**
+** THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+** WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO
+** EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+** PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+** OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+** WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+** OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+** ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+** =============================================================================
+**/
+#ifndef _FMGUI_PLOT_HPP_
+#define _FMGUI_PLOT_HPP_ 0
+
+#include "FmGuiCore.hpp"
+#include "FmGuiSpectrum.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+/* ImPlot Headers here: */
+#include <implot.h>
+
+/*
+ * Plotting helpers for the FmGui.ImPlot build. Only include this file when
+ * FMGUI_ENABLE_IMPLOT is defined.
+ */
+
+namespace FmGui
+{
+/*
+ * Fixed capacity ring of (x, y) points that ImPlot draws in place. ImPlot is
+ * handed the storage together with the offset of the oldest point and the
+ * stride between points, so plotting never copies or moves the data, and
+ * appending to a full series overwrites the oldest point instead of erasing
+ * the front of a vector.
+ *
+ * The storage is allocated once by the constructor, for at least one point.
+ * Fill the series from a Channel in the widget routine, so a published sample
+ * is copied exactly once, from the channel into the series:
+ *
+ *     static FmGui::PlotSeries<double> fuelSeries(60 * 1000);
+ *
+ *     fuelChannel.Drain([](const FuelSample &sample) {
+ *         fuelSeries.Append(sample.time, sample.totalVolume);
+ *     });
+ *     if (ImPlot::BeginPlot("Fuel")) {
+ *         fuelSeries.PlotLine("Total volume");
+ *         ImPlot::EndPlot();
+ *     }
+ */
+template <typename T>
+class PlotSeries
+{
+	static_assert(std::is_same<T, float>::value
+				  || std::is_same<T, double>::value,
+				  "PlotSeries values must be float or double.");
+public:
+	struct Point
+	{
+		T x, y;
+	};
+
+	explicit PlotSeries(std::size_t capacity)
+		: points(std::max<std::size_t>(capacity, 1)),
+		  head(0),
+		  size(0)
+	{
+	}
+
+	void Append(T x, T y)
+	{
+		Point &point = points[head];
+		point.x = x;
+		point.y = y;
+		head = (head + 1 == points.size()) ? 0 : head + 1;
+		if (size < points.size())
+			++size;
+	}
+	void Clear(void)
+	{
+		head = 0;
+		size = 0;
+	}
+	std::size_t GetSize(void) const
+	{
+		return size;
+	}
+	std::size_t GetCapacity(void) const
+	{
+		return points.size();
+	}
+	/*
+	 * Point by age, 0 is the oldest point.
+	 */
+	const Point &operator[](std::size_t index) const
+	{
+		return points[(GetOffset() + index) % points.size()];
+	}
+	const Point &Back(void) const
+	{
+		return points[(head == 0 ? points.size() : head) - 1];
+	}
+
+	void PlotLine(const char *label) const
+	{
+		if (size != 0) {
+			ImPlot::PlotLine(label, &points[0].x, &points[0].y,
+							 static_cast<int>(size),
+							 static_cast<int>(GetOffset()),
+							 static_cast<int>(sizeof(Point)));
+		}
+	}
+	void PlotScatter(const char *label) const
+	{
+		if (size != 0) {
+			ImPlot::PlotScatter(label, &points[0].x, &points[0].y,
+								static_cast<int>(size),
+								static_cast<int>(GetOffset()),
+								static_cast<int>(sizeof(Point)));
+		}
+	}
+private:
+	// Index of the oldest point.
+	std::size_t GetOffset(void) const
+	{
+		return size == points.size() ? head : 0;
+	}
+
+	std::vector<Point> points;
+	// Index the next point is written to.
+	std::size_t head;
+	std::size_t size;
+};
+
+/*
+ * Long history of (x, y) samples with a level of detail pyramid, for plotting
+ * e.g. 30 minutes of 1 kHz data. Every level summarizes bucketSize entries of
+ * the level below into a bucket holding their minimum and maximum, and is
+ * built incrementally as samples are appended. PlotLine() draws the visible
+ * samples directly while there are few enough, otherwise the coarsest level
+ * that still has about one bucket per pixel. A fully zoomed out plot therefore
+ * costs the same for 10M samples as for 10K, while spikes stay visible.
+ *
+ * x must not decrease between appends, e.g. the simulation time. All storage
+ * is allocated by the constructor.
+ */
+template <typename T>
+class PlotHistory
+{
+public:
+	static constexpr std::size_t bucketSize = 8;
+	// Levels are added until one holds at most this many buckets.
+	static constexpr std::size_t topLevelLimit = 2048;
+
+	explicit PlotHistory(std::size_t capacity)
+		: samples(capacity)
+	{
+		std::size_t levelCapacity = capacity / bucketSize + 1;
+		for (;;) {
+			levels.emplace_back(levelCapacity);
+			if (levelCapacity <= topLevelLimit)
+				break;
+			levelCapacity = levelCapacity / bucketSize + 1;
+		}
+	}
+
+	void Append(T x, T y)
+	{
+		samples.Append(x, y);
+		Bucket bucket = { x, x, y, y, true };
+		for (Level &level : levels) {
+			if (!level.Accumulate(bucket))
+				break;
+			bucket = level.Back();
+		}
+	}
+	void Clear(void)
+	{
+		samples.Clear();
+		for (Level &level : levels)
+			level.Clear();
+	}
+	const PlotSeries<T> &GetSamples(void) const
+	{
+		return samples;
+	}
+	std::size_t GetLevelCount(void) const
+	{
+		return levels.size();
+	}
+
+	/*
+	 * Plot the samples visible in the current plot, between BeginPlot and
+	 * EndPlot.
+	 */
+	void PlotLine(const char *label) const
+	{
+		const std::size_t sampleCount = samples.GetSize();
+		if (sampleCount == 0)
+			return;
+		const ImPlotLimits limits = ImPlot::GetPlotLimits();
+		const std::size_t pixels = static_cast<std::size_t>(
+			std::max(1.0f, ImPlot::GetPlotSize().x));
+		PlotRange range;
+		range.pHistory = this;
+		range.pLevel = nullptr;
+		std::size_t last;
+		FindRange(sampleCount, limits.X.Min, limits.X.Max,
+			[this](std::size_t index) -> T { return samples[index].x; },
+			[this](std::size_t index) -> T { return samples[index].x; },
+			range.first, last);
+		std::size_t visibleCount = last - range.first;
+		if (visibleCount <= 2 * pixels) {
+			ImPlot::PlotLineG(label, GetSamplePoint, &range,
+							  static_cast<int>(visibleCount));
+			return;
+		}
+		// Coarsest level needed for about one bucket per pixel.
+		std::size_t levelIndex = 0;
+		visibleCount /= bucketSize;
+		while (levelIndex + 1 < levels.size() && visibleCount > pixels) {
+			visibleCount /= bucketSize;
+			++levelIndex;
+		}
+		const Level &level = levels[levelIndex];
+		range.pLevel = &level;
+		FindRange(level.GetCount(), limits.X.Min, limits.X.Max,
+			[&level](std::size_t index) -> T { return level[index].x0; },
+			[&level](std::size_t index) -> T { return level[index].x1; },
+			range.first, last);
+		// Two points per bucket, its minimum and maximum in time order.
+		ImPlot::PlotLineG(label, GetBucketPoint, &range,
+						  static_cast<int>(2 * (last - range.first)));
+	}
+private:
+	struct Bucket
+	{
+		T x0, x1, yMin, yMax;
+		bool isMinFirst;
+	};
+
+	/*
+	 * Ring of buckets, plus the bucket being accumulated which is treated as
+	 * the newest one.
+	 */
+	class Level
+	{
+	public:
+		explicit Level(std::size_t capacity)
+			: buckets(capacity),
+			  head(0),
+			  size(0),
+			  pendingCount(0)
+		{
+		}
+
+		/*
+		 * Merge bucket into the pending one. Returns true when that completed
+		 * the pending bucket, which is then Back().
+		 */
+		bool Accumulate(const Bucket &bucket)
+		{
+			if (pendingCount == 0) {
+				pending = bucket;
+			} else {
+				const bool isNewMin = bucket.yMin < pending.yMin;
+				const bool isNewMax = bucket.yMax > pending.yMax;
+				if (isNewMin && isNewMax)
+					pending.isMinFirst = bucket.isMinFirst;
+				else if (isNewMin)
+					pending.isMinFirst = false;
+				else if (isNewMax)
+					pending.isMinFirst = true;
+				if (isNewMin)
+					pending.yMin = bucket.yMin;
+				if (isNewMax)
+					pending.yMax = bucket.yMax;
+				pending.x1 = bucket.x1;
+			}
+			if (++pendingCount < bucketSize)
+				return false;
+			buckets[head] = pending;
+			head = (head + 1 == buckets.size()) ? 0 : head + 1;
+			if (size < buckets.size())
+				++size;
+			pendingCount = 0;
+			return true;
+		}
+		void Clear(void)
+		{
+			head = 0;
+			size = 0;
+			pendingCount = 0;
+		}
+		std::size_t GetCount(void) const
+		{
+			return size + (pendingCount != 0 ? 1 : 0);
+		}
+		// Bucket by age, 0 is the oldest.
+		const Bucket &operator[](std::size_t index) const
+		{
+			if (index == size)
+				return pending;
+			const std::size_t offset = (size == buckets.size()) ? head : 0;
+			return buckets[(offset + index) % buckets.size()];
+		}
+		const Bucket &Back(void) const
+		{
+			return buckets[(head == 0 ? buckets.size() : head) - 1];
+		}
+	private:
+		std::vector<Bucket> buckets;
+		std::size_t head, size;
+		Bucket pending;
+		std::size_t pendingCount;
+	};
+
+	struct PlotRange
+	{
+		const PlotHistory *pHistory;
+		const Level *pLevel;
+		std::size_t first;
+	};
+
+	/*
+	 * Range [first, last) of entries overlapping [xMin, xMax], widened by one
+	 * entry on each side so the line runs off the plot edges.
+	 */
+	template <typename GetStart, typename GetEnd>
+	static void FindRange(std::size_t count, double xMin, double xMax,
+						  GetStart getStart, GetEnd getEnd, std::size_t &first,
+						  std::size_t &last)
+	{
+		std::size_t low = 0, high = count;
+		while (low < high) {
+			const std::size_t middle = low + (high - low) / 2;
+			if (static_cast<double>(getEnd(middle)) < xMin)
+				low = middle + 1;
+			else
+				high = middle;
+		}
+		first = (low == 0) ? 0 : low - 1;
+		high = count;
+		while (low < high) {
+			const std::size_t middle = low + (high - low) / 2;
+			if (static_cast<double>(getStart(middle)) <= xMax)
+				low = middle + 1;
+			else
+				high = middle;
+		}
+		last = std::min(count, low + 1);
+	}
+	static ImPlotPoint GetSamplePoint(void *pData, int index)
+	{
+		const PlotRange &range = *static_cast<const PlotRange *>(pData);
+		const typename PlotSeries<T>::Point &point =
+			range.pHistory->samples[range.first + index];
+		return ImPlotPoint(point.x, point.y);
+	}
+	static ImPlotPoint GetBucketPoint(void *pData, int index)
+	{
+		const PlotRange &range = *static_cast<const PlotRange *>(pData);
+		const Bucket &bucket = (*range.pLevel)[range.first + index / 2];
+		const bool isSecond = (index & 1) != 0;
+		const T y = (isSecond == bucket.isMinFirst) ? bucket.yMax : bucket.yMin;
+		return ImPlotPoint(isSecond ? bucket.x1 : bucket.x0, y);
+	}
+
+	PlotSeries<T> samples;
+	std::vector<Level> levels;
+};
+
+/*
+ * Draw the history of a Spectrum as a waterfall heatmap, between BeginPlot and
+ * EndPlot. x is the frequency in Hz and y the age of a row in seconds, with
+ * the newest row at the top at 0. Magnitudes are colored from scaleMin to
+ * scaleMax dB.
+ *
+ * ImPlot builds a rectangle for every cell it is handed on every frame. When
+ * the plot shows more rows or bins than it has pixels, the history is first
+ * reduced to about one cell per pixel, keeping the loudest cell of each
+ * block, so the cost is bounded by the plot size rather than historySize
+ * times the bin count. Otherwise it is drawn without a copy as at most two
+ * heatmaps, one on each side of the ring's wrap around. FmGui::Spectrogram
+ * avoids the per cell cost altogether where the renderer supports textures.
+ */
+inline void
+PlotSpectrogram(const char *label, const Spectrum &spectrum,
+				double scaleMin = -100.0, double scaleMax = 0.0)
+{
+	const std::size_t count = spectrum.GetHistoryCount();
+	if (count == 0)
+		return;
+	const std::size_t historySize = spectrum.GetConfig().historySize;
+	const std::size_t head = spectrum.GetHistoryHead();
+	const std::size_t binCount = spectrum.GetBinCount();
+	const double binWidth = spectrum.GetBinWidth();
+	const double rowPeriod = spectrum.GetRowPeriod();
+	const float *const pHistory = spectrum.GetHistory();
+	// Rows and bins per pixel over the visible part of the plot.
+	const ImPlotLimits limits = ImPlot::GetPlotLimits();
+	const ImVec2 plotSize = ImPlot::GetPlotSize();
+	const double binsPerPixel = (limits.X.Max - limits.X.Min)
+		/ (binWidth * std::max(1.0f, plotSize.x));
+	const double rowsPerPixel = (limits.Y.Max - limits.Y.Min)
+		/ (rowPeriod * std::max(1.0f, plotSize.y));
+	const std::size_t binStep = static_cast<std::size_t>(std::min(
+		static_cast<double>(binCount), std::max(1.0, binsPerPixel)));
+	const std::size_t rowStep = static_cast<std::size_t>(std::min(
+		static_cast<double>(count), std::max(1.0, rowsPerPixel)));
+	const double xMin = -0.5 * binWidth;
+	if (binStep == 1 && rowStep == 1) {
+		const double xMax = (static_cast<double>(binCount) - 0.5) * binWidth;
+		const int columns = static_cast<int>(binCount);
+		// Rows from the head to the end of the buffer are the newest.
+		const std::size_t newerCount = std::min(count, historySize - head);
+		ImPlot::PlotHeatmap(label, pHistory + head * binCount,
+							static_cast<int>(newerCount), columns, scaleMin,
+							scaleMax, nullptr,
+							ImPlotPoint(xMin, -rowPeriod
+										* static_cast<double>(newerCount)),
+							ImPlotPoint(xMax, 0.0));
+		if (count > newerCount) {
+			const std::size_t olderCount = count - newerCount;
+			ImPlot::PlotHeatmap(label, pHistory,
+								static_cast<int>(olderCount), columns,
+								scaleMin, scaleMax, nullptr,
+								ImPlotPoint(xMin, -rowPeriod
+											* static_cast<double>(count)),
+								ImPlotPoint(xMax, -rowPeriod
+											* static_cast<double>(newerCount)));
+		}
+		return;
+	}
+	// Render thread only. Grows to the largest reduced history once.
+	static std::vector<float> reduced;
+	const std::size_t rows = (count + rowStep - 1) / rowStep;
+	const std::size_t columns = (binCount + binStep - 1) / binStep;
+	reduced.assign(rows * columns, -std::numeric_limits<float>::infinity());
+	for (std::size_t age = 0; age < count; ++age) {
+		const float *const pRow =
+			pHistory + ((head + age) % historySize) * binCount;
+		float *const pReducedRow = &reduced[(age / rowStep) * columns];
+		for (std::size_t bin = 0; bin < binCount; ++bin) {
+			float &cell = pReducedRow[bin / binStep];
+			cell = std::max(cell, pRow[bin]);
+		}
+	}
+	// Every reduced cell is drawn as wide and tall as a full block.
+	ImPlot::PlotHeatmap(label, reduced.data(), static_cast<int>(rows),
+						static_cast<int>(columns), scaleMin, scaleMax, nullptr,
+						ImPlotPoint(xMin, -rowPeriod
+									* static_cast<double>(rows * rowStep)),
+						ImPlotPoint(xMin + binWidth
+									* static_cast<double>(columns * binStep),
+									0.0));
+}
+
+/*
+ * Waterfall of a Spectrum kept in a renderer texture, see
+ * FmGuiRenderer::pCreateTexture. Call Update() in place of Spectrum::Update()
+ * once per frame from the widget routine. It colors and uploads only the rows
+ * finished since the last call, usually one, into a texture laid out like the
+ * history ring, and Plot() draws the texture with at most two images, so a
+ * frame costs the same whatever the history size.
+ *
+ * The texture is created by the first Update() after FmGui initialized, with
+ * the colormap current at that time. If the renderer has no texture support,
+ * Plot() falls back to FmGui::PlotSpectrogram(). Call Release() before
+ * FmGui::ShutdownHook (or FmGui::Core::Shutdown), which also makes the next
+ * Update() create the texture again:
+ *
+ *     static FmGui::Spectrum pitchSpectrum;
+ *     static FmGui::Spectrogram pitchSpectrogram(pitchSpectrum);
+ *
+ *     pitchSpectrogram.Update();
+ *     if (ImPlot::BeginPlot("Pitch rate")) {
+ *         pitchSpectrogram.Plot("Spectrogram");
+ *         ImPlot::EndPlot();
+ *     }
+ */
+class Spectrogram
+{
+public:
+	explicit Spectrogram(Spectrum &spectrum, double scaleMin = -100.0,
+						 double scaleMax = 0.0)
+		: spectrum(spectrum),
+		  scaleMin(scaleMin),
+		  scaleMax(scaleMax),
+		  pTexture(nullptr),
+		  isUnsupported(false),
+		  rowPixels(spectrum.GetBinCount())
+	{
+	}
+	~Spectrogram(void)
+	{
+		Release();
+	}
+	Spectrogram(const Spectrogram &) = delete;
+	Spectrogram &operator=(const Spectrogram &) = delete;
+
+	/*
+	 * Render thread, once per frame. Calls Spectrum::Update() and returns its
+	 * result.
+	 */
+	std::size_t Update(void)
+	{
+		const std::size_t newRowCount = spectrum.Update();
+		if (pTexture == nullptr) {
+			if (isUnsupported || !CreateTexture())
+				return newRowCount;
+			// A new texture starts out with the whole valid history.
+			UploadRows(spectrum.GetHistoryCount());
+		} else {
+			UploadRows(newRowCount);
+		}
+		return newRowCount;
+	}
+	/*
+	 * Draw the waterfall between BeginPlot and EndPlot, with the axes of
+	 * FmGui::PlotSpectrogram().
+	 */
+	void Plot(const char *label) const
+	{
+		if (pTexture == nullptr) {
+			PlotSpectrogram(label, spectrum, scaleMin, scaleMax);
+			return;
+		}
+		const std::size_t count = spectrum.GetHistoryCount();
+		if (count == 0)
+			return;
+		const std::size_t historySize = spectrum.GetConfig().historySize;
+		const std::size_t head = spectrum.GetHistoryHead();
+		const double binWidth = spectrum.GetBinWidth();
+		const double rowPeriod = spectrum.GetRowPeriod();
+		const double xMin = -0.5 * binWidth;
+		const double xMax =
+			(static_cast<double>(spectrum.GetBinCount()) - 0.5) * binWidth;
+		const float rowHeight = 1.0f / static_cast<float>(historySize);
+		// The top of an image is at its maximum y, the newest row.
+		const std::size_t newerCount = std::min(count, historySize - head);
+		ImPlot::PlotImage(label, pTexture,
+						  ImPlotPoint(xMin, -rowPeriod
+									  * static_cast<double>(newerCount)),
+						  ImPlotPoint(xMax, 0.0),
+						  ImVec2(0.0f, static_cast<float>(head) * rowHeight),
+						  ImVec2(1.0f, static_cast<float>(head + newerCount)
+								 * rowHeight));
+		if (count > newerCount) {
+			const std::size_t olderCount = count - newerCount;
+			ImPlot::PlotImage(label, pTexture,
+							  ImPlotPoint(xMin, -rowPeriod
+										  * static_cast<double>(count)),
+							  ImPlotPoint(xMax, -rowPeriod
+										  * static_cast<double>(newerCount)),
+							  ImVec2(0.0f, 0.0f),
+							  ImVec2(1.0f, static_cast<float>(olderCount)
+									 * rowHeight));
+		}
+	}
+	/*
+	 * Destroy the texture. Render thread, while FmGui is still initialized.
+	 */
+	void Release(void)
+	{
+		Core::DestroyTexture(pTexture);
+		pTexture = nullptr;
+		isUnsupported = false;
+	}
+private:
+	static constexpr std::size_t colorCount = 256;
+
+	bool CreateTexture(void)
+	{
+		if (Core::GetInitState() != FmGuiInitState::READY)
+			return false;
+		pTexture = Core::CreateTexture(
+			static_cast<unsigned int>(spectrum.GetBinCount()),
+			static_cast<unsigned int>(spectrum.GetConfig().historySize));
+		if (pTexture == nullptr) {
+			isUnsupported = true;
+			return false;
+		}
+		for (std::size_t i = 0; i < colorCount; ++i) {
+			colors[i] = ImGui::ColorConvertFloat4ToU32(ImPlot::SampleColormap(
+				static_cast<float>(i) / static_cast<float>(colorCount - 1)));
+		}
+		return true;
+	}
+	void UploadRows(std::size_t rowCount)
+	{
+		const std::size_t historySize = spectrum.GetConfig().historySize;
+		const std::size_t binCount = spectrum.GetBinCount();
+		const std::size_t head = spectrum.GetHistoryHead();
+		const float *const pHistory = spectrum.GetHistory();
+		const double scale = static_cast<double>(colorCount - 1)
+			/ std::max(scaleMax - scaleMin, 1e-6);
+		rowCount = std::min(rowCount, spectrum.GetHistoryCount());
+		for (std::size_t age = 0; age < rowCount; ++age) {
+			const std::size_t row = (head + age) % historySize;
+			const float *const pRow = pHistory + row * binCount;
+			for (std::size_t bin = 0; bin < binCount; ++bin) {
+				const double index = std::min(std::max(
+					(static_cast<double>(pRow[bin]) - scaleMin) * scale, 0.0),
+					static_cast<double>(colorCount - 1));
+				rowPixels[bin] = colors[static_cast<std::size_t>(index)];
+			}
+			Core::UpdateTexture(pTexture, static_cast<unsigned int>(row), 1,
+								rowPixels.data());
+		}
+	}
+
+	Spectrum &spectrum;
+	double scaleMin, scaleMax;
+	void *pTexture;
+	// Set when the renderer could not create the texture, to not retry.
+	bool isUnsupported;
+	std::uint32_t colors[colorCount];
+	std::vector<std::uint32_t> rowPixels;
+};
+
+/*
+ * Draw the newest row of a Spectrum as a line, magnitude in dB over
+ * frequency in Hz.
+ */
+inline void
+PlotSpectrum(const char *label, const Spectrum &spectrum)
+{
+	const float *const pRow = spectrum.GetNewestRow();
+	if (pRow != nullptr) {
+		ImPlot::PlotLine(label, pRow, static_cast<int>(spectrum.GetBinCount()),
+						 static_cast<double>(spectrum.GetBinWidth()));
+	}
+}
+} // namespace FmGui
+
+#endif /* !_FMGUI_PLOT_HPP_ */
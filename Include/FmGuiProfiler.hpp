@@ -0,0 +1,184 @@
+/* =============================================================================
+** DCS-EFM-ImGui, file: FmGuiProfiler.hpp Created: 17-OCT-2026
+**
+** Copyright 2022 Brian Hoffpauir, USA
+** All rights reserved.
+**
+** Redistribution and use of this source file, with or without modification, is
+** permitted provided that the following conditions are met:
+**
+** 1. Redistributions of this source file must retain the above copyright
+**    notice, this list of conditions and the following disclaimer.
+**
+** 2. Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and/or other materials provided with the distribution.
+**
+** THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+** WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO
+** EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+** PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+** OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+** WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+** OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+** ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+** =============================================================================
+**/
+#ifndef _FMGUI_PROFILER_HPP_
+#define _FMGUI_PROFILER_HPP_ 0
+
+#include <cstddef>
+#include <cstdint>
+
+/*
+ * Scoped profiler for the EFM callbacks, e.g. ed_fm_simulate. Each thread that
+ * records events gets its own fixed size buffer, so recording a scope is wait
+ * free and never allocates. The render thread collects the buffers once per
+ * frame and the "FmGui Profiler" window draws a flame graph of the last ticks
+ * of a thread. While the widgets are hidden no frames run, so events past the
+ * buffer size are dropped.
+ *
+ * StartTrace streams the collected events to a Chrome trace JSON file, which
+ * opens in chrome://tracing and Perfetto. The frame stages of the present hook
+ * are recorded as scopes of the render thread.
+ *
+ * The FMGUI_PROFILE_ macros are compiled out unless FMGUI_ENABLE_PROFILER is
+ * defined, so they can be left in place in release builds of the EFM:
+ *
+ *     void ed_fm_simulate(double dt)
+ *     {
+ *         FMGUI_PROFILE_TICK();
+ *         FMGUI_PROFILE_SCOPE("ed_fm_simulate");
+ *         ...
+ *     }
+ */
+
+enum struct FmGuiProfileEventType : std::uint8_t
+{
+	BEGIN,
+	END,
+	TICK
+};
+
+struct FmGuiProfileEvent
+{
+	// String literal naming the scope, null for END and TICK events.
+	const char *name;
+	// Steady clock time in nanoseconds.
+	std::uint64_t timestamp;
+	FmGuiProfileEventType type;
+};
+
+/*
+ * A closed scope, as collected by the render thread. start and end are steady
+ * clock times in nanoseconds. depth is 0 for an outermost scope.
+ */
+struct FmGuiProfileScope
+{
+	const char *name;
+	std::uint64_t start, end;
+	std::uint32_t depth;
+};
+
+namespace FmGui
+{
+namespace Profiler
+{
+/*
+ * Maximum number of threads recording at the same time. The buffer of a
+ * thread is released when the thread exits. Threads past the limit record
+ * nothing.
+ */
+constexpr std::size_t threadLimit = 8;
+/*
+ * Events buffered per thread between two collections. Scopes that do not fit
+ * are dropped whole and counted, so nesting stays intact.
+ */
+constexpr std::size_t threadBufferSize = 4096;
+
+/*
+ * Begin a scope on the calling thread. name must be a string literal, or any
+ * other string that outlives the profiler.
+ */
+void BeginScope(const char *name);
+/*
+ * End the innermost scope of the calling thread.
+ */
+void EndScope(void);
+/*
+ * Mark the start of a simulation tick on the calling thread. The flame graph
+ * shows the scopes of the last ticks.
+ */
+void MarkTick(void);
+/*
+ * Name the calling thread in the profiler window, e.g. "Simulation". name must
+ * outlive the profiler.
+ */
+void SetThreadName(const char *name);
+/*
+ * Number of events dropped because a thread buffer was full.
+ */
+std::uint64_t GetDroppedEventCount(void);
+/*
+ * Set the visibility of the "FmGui Profiler" window. Returns the previous
+ * visibility.
+ */
+bool SetPanelVisibility(bool isVisible);
+/*
+ * Start streaming every collected event to the Chrome trace JSON file
+ * fileName. A background thread formats and writes the events, the render
+ * thread only copies them into a fixed pool of chunks. Events are dropped and
+ * counted while every chunk is waiting on the writer. Scopes already open at
+ * the start begin at the start of the trace, and scopes still open at the
+ * stop end there. Returns false if a trace is already being recorded or the
+ * file cannot be opened.
+ */
+bool StartTrace(const char *fileName);
+/*
+ * Stop the trace. The render thread hands the remaining events to the writer
+ * on its next frame and the writer then completes the file.
+ */
+void StopTrace(void);
+bool IsTracing(void);
+/*
+ * Number of events dropped from the trace because the writer fell behind.
+ */
+std::uint64_t GetTraceDroppedEventCount(void);
+/*
+ * Called by FmGui::Core on the render thread. Collect drains the thread
+ * buffers, ShowPanel draws the profiler window when it is visible and
+ * Shutdown completes a running trace.
+ */
+void Collect(void);
+void ShowPanel(void);
+void Shutdown(void);
+
+class Scope
+{
+public:
+	explicit Scope(const char *name) { BeginScope(name); }
+	~Scope(void) { EndScope(); }
+	Scope(const Scope &) = delete;
+	Scope &operator=(const Scope &) = delete;
+};
+} // namespace Profiler
+} // namespace FmGui
+
+#define FMGUI_PROFILE_CONCAT_IMPL(A, B) A##B
+#define FMGUI_PROFILE_CONCAT(A, B) FMGUI_PROFILE_CONCAT_IMPL(A, B)
+
+#if defined(FMGUI_ENABLE_PROFILER)
+#define FMGUI_PROFILE_SCOPE(NAME) \
+	FmGui::Profiler::Scope FMGUI_PROFILE_CONCAT(fmGuiProfileScope, \
+												__LINE__)((NAME))
+#define FMGUI_PROFILE_TICK() FmGui::Profiler::MarkTick()
+#define FMGUI_PROFILE_THREAD_NAME(NAME) FmGui::Profiler::SetThreadName((NAME))
+#else
+#define FMGUI_PROFILE_SCOPE(NAME) static_cast<void>(0)
+#define FMGUI_PROFILE_TICK() static_cast<void>(0)
+#define FMGUI_PROFILE_THREAD_NAME(NAME) static_cast<void>(0)
+#endif
+
+#endif /* !_FMGUI_PROFILER_HPP_ */
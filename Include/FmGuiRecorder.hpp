@@ -0,0 +1,217 @@
+/* =============================================================================
+** DCS-EFM-ImGui, file: FmGuiRecorder.hpp Created: 17-OCT-2026
+**
+** Copyright 2022 Brian Hoffpauir, USA
+** All rights reserved.
+**
+** Redistribution and use of this source file, with or without modification, is
+** permitted provided that the following conditions are met:
+**
+** 1. Redistributions of this source file must retain the above copyright
+**    notice, this list of conditions and the following disclaimer.
+**
+** 2. Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and/or other materials provided with the distribution.
+**
+** THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+** WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO
+** EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+** PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+** OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+** WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+** OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+** ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+** =============================================================================
+**/
+#ifndef _FMGUI_RECORDER_HPP_
+#define _FMGUI_RECORDER_HPP_ 0
+
+#include "FmGuiTelemetry.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/*
+ * Flight data recorder. The simulation thread records rows of channel values
+ * into chunks held in memory, and a background thread appends full chunks to
+ * the file with large sequential writes, so neither the simulation nor the
+ * Present thread ever waits on the disk.
+ *
+ * Recording files are little endian and columnar:
+ *
+ *     Header  "FMGUIREC", u32 version, u32 channel count, u32 chunk rows,
+ *             then per channel a u32 name length and the name.
+ *     Chunk   u32 'CHNK', u32 row count, f64 first time, f64 last time,
+ *             f64 times[row count], then per channel f32 values[row count].
+ *     Index   u32 'INDX', u32 entry count, u64 offset of the previous index,
+ *             then per chunk since the previous index: f64 first time,
+ *             f64 last time, u64 chunk offset.
+ *     Trailer u32 'FEND', u32 zero, u64 offset of the last index.
+ *
+ * An index is written and the file flushed every checkpointInterval chunks.
+ * The trailer is only written by Stop(). A file without one, e.g. after a
+ * crash, is recovered by scanning the records from the header, which loses at
+ * most the chunks that had not been written yet.
+ */
+
+struct FmGuiRecorderConfig
+{
+public:
+	FmGuiRecorderConfig(void);
+public:
+	/*
+	 * One name per recorded channel, in the order Record() takes the values.
+	 */
+	std::vector<std::string> channelNames;
+	/*
+	 * Rows per chunk.
+	 * Default value: 4096
+	 */
+	std::size_t chunkRows;
+	/*
+	 * Chunks in memory, between 2 and 64. Rows are dropped while every chunk
+	 * is waiting to be written.
+	 * Default value: 16
+	 */
+	std::size_t chunkPoolSize;
+	/*
+	 * Chunks written between two index checkpoints.
+	 * Default value: 16
+	 */
+	std::size_t checkpointInterval;
+};
+
+/*
+ * Location of a chunk in a recording.
+ */
+struct FmGuiRecordingChunkInfo
+{
+	double firstTime, lastTime;
+	std::uint64_t offset;
+};
+
+/*
+ * The columns of one chunk read back from a recording. values holds one
+ * column of times.size() values per channel, one after another.
+ */
+struct FmGuiRecordingChunk
+{
+	std::vector<double> times;
+	std::vector<float> values;
+
+	const float *GetColumn(std::size_t channel) const
+	{
+		return values.data() + channel * times.size();
+	}
+};
+
+namespace FmGui
+{
+class Recorder
+{
+public:
+	Recorder(void);
+	~Recorder(void);
+	Recorder(const Recorder &) = delete;
+	Recorder &operator=(const Recorder &) = delete;
+
+	/*
+	 * Create fileName and start recording. All memory is allocated here.
+	 * Returns false if already recording or the file cannot be created.
+	 */
+	bool Start(const char *fileName, const FmGuiRecorderConfig &config);
+	/*
+	 * Hand the rows recorded so far to the writer, which then completes the
+	 * file with the last index and the trailer. Call from the recording
+	 * thread, or once it no longer records, e.g. in ed_fm_release.
+	 */
+	void Stop(void);
+	bool IsRecording(void) const;
+	/*
+	 * Wait free, from the recording thread. pValues holds one value per
+	 * channel. time must not decrease. Returns false if the row was dropped.
+	 */
+	bool Record(double time, const float *pValues);
+	std::uint64_t GetDroppedRowCount(void) const;
+private:
+	static constexpr std::uint32_t noChunk = 0xFFFFFFFF;
+
+	void HandOffChunk(void);
+	void RunWriter(void);
+	bool WriteChunk(std::uint32_t chunk,
+					std::vector<FmGuiRecordingChunkInfo> &pendingIndex);
+	bool WriteIndex(std::vector<FmGuiRecordingChunkInfo> &pendingIndex);
+
+	FmGuiRecorderConfig config;
+	// Chunk pool, times and values are columns of chunkRows entries.
+	std::vector<double> chunkTimes;
+	std::vector<float> chunkValues;
+	std::vector<std::uint32_t> chunkRowCounts;
+	Channel<std::uint32_t, 64> fullChunks, freeChunks;
+	// Recording thread state.
+	std::uint32_t currentChunk;
+	std::atomic<bool> isRecording;
+	std::atomic<std::uint64_t> droppedRowCount;
+	// Writer thread state.
+	std::FILE *pFile;
+	std::vector<char> fileBuffer;
+	std::uint64_t fileOffset, lastIndexOffset;
+	std::atomic<bool> isEndRequested;
+	std::mutex writerMutex;
+	std::condition_variable writerCondition;
+	std::thread writer;
+};
+
+/*
+ * Reads a recording, including one without a trailer.
+ */
+class Recording
+{
+public:
+	Recording(void);
+	~Recording(void);
+	Recording(const Recording &) = delete;
+	Recording &operator=(const Recording &) = delete;
+
+	bool Open(const char *fileName);
+	void Close(void);
+
+	std::size_t GetChannelCount(void) const;
+	const std::string &GetChannelName(std::size_t channel) const;
+	// Returns the channel count if there is no channel with that name.
+	std::size_t FindChannel(const std::string &name) const;
+	const std::vector<FmGuiRecordingChunkInfo> &GetChunks(void) const;
+	double GetStartTime(void) const;
+	double GetEndTime(void) const;
+	// Whether the file had to be scanned because it has no trailer.
+	bool IsRecovered(void) const;
+	/*
+	 * Index of the chunk holding time, or of the nearest chunk if no chunk
+	 * does. Chunk lookups are a binary search of the index.
+	 */
+	std::size_t FindChunk(double time) const;
+	bool ReadChunk(std::size_t chunk, FmGuiRecordingChunk &columns) const;
+private:
+	bool ReadIndex(std::uint64_t indexOffset);
+	bool ScanChunks(std::uint64_t offset);
+
+	std::FILE *pFile;
+	std::vector<std::string> channelNames;
+	// Rows per chunk the file was recorded with, no chunk holds more.
+	std::size_t chunkRows;
+	std::vector<FmGuiRecordingChunkInfo> chunks;
+	bool isRecovered;
+};
+} // namespace FmGui
+
+#endif /* !_FMGUI_RECORDER_HPP_ */
@@ -0,0 +1,99 @@
+/* =============================================================================
+** DCS-EFM-ImGui, file: FmGuiReplay.hpp Created: 17-OCT-2026
+**
+** Copyright 2022 Brian Hoffpauir, USA
+** All rights reserved.
+**
+** Redistribution and use of this source file, with or without modification, is
+** permitted provided that the following conditions are met:
+**
+** 1. Redistributions of this source file must retain the above copyright
+**    notice, this list of conditions and the following disclaimer.
+**
+** 2. Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and/or other materials provided with the distribution.
+**
+** THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+** WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO
+** EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+** PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+** OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+** WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+** OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+** ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+** =============================================================================
+**/
+#ifndef _FMGUI_REPLAY_HPP_
+#define _FMGUI_REPLAY_HPP_ 0
+
+#include "FmGuiCore.hpp"
+#include "FmGuiRecorder.hpp"
+
+#include <type_traits>
+
+/*
+ * Interface between the FmGuiReplay tool in ./Tools/FmGuiReplay and the panels
+ * it draws. The tool plays a recording back by feeding its rows, in time
+ * order, to the panels' publish routine, which stands in for ed_fm_simulate:
+ * it pushes the values into the same FmGui::Channel, FmGui::Snapshot or
+ * FmGui::Capture objects the in-sim routine reads from. The widget routine is
+ * then the very routine passed to FmGui::SetRoutinePtr in game.
+ *
+ * The panel sources are compiled into the tool through the CMake cache
+ * variable FMGUI_REPLAY_PANEL_SOURCES and must define
+ * FmGui::Replay::SetupPanels.
+ */
+
+using FmGuiReplayPublishPtr =
+	std::add_pointer<void(double time, const float *pValues)>::type;
+using FmGuiReplayResetPtr = std::add_pointer<void(void)>::type;
+
+struct FmGuiReplayPanels
+{
+public:
+	FmGuiReplayPanels(void);
+public:
+	/*
+	 * The widget routine, called once per frame.
+	 * Default value: nullptr.
+	 */
+	FmGuiRoutinePtr pRoutine;
+	/*
+	 * Called with every recorded row, pValues holding one value per channel.
+	 * All rows due in a frame are published before the widget routine runs,
+	 * so channels need room for the rows of one frame at the replay speed.
+	 * Default value: nullptr.
+	 */
+	FmGuiReplayPublishPtr pPublish;
+	/*
+	 * Called before the replay jumps to another time, to clear histories
+	 * that would otherwise join samples across the jump. May be nullptr.
+	 * Default value: nullptr.
+	 */
+	FmGuiReplayResetPtr pReset;
+};
+
+inline FmGuiReplayPanels::FmGuiReplayPanels(void)
+	: pRoutine(nullptr),
+	  pPublish(nullptr),
+	  pReset(nullptr)
+{
+}
+
+namespace FmGui
+{
+namespace Replay
+{
+/*
+ * Defined by the panel sources. Called once after the recording was opened
+ * and before the first frame; look up channels with Recording::FindChannel
+ * and fill in panels. Return false to abort the replay.
+ */
+bool SetupPanels(const Recording &recording, FmGuiReplayPanels &panels);
+} // namespace Replay
+} // namespace FmGui
+
+#endif /* !_FMGUI_REPLAY_HPP_ */
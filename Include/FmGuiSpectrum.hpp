@@ -0,0 +1,163 @@
+/* =============================================================================
+** DCS-EFM-ImGui, file: FmGuiSpectrum.hpp Created: 17-OCT-2026
+**
+** Copyright 2022 Brian Hoffpauir, USA
+** All rights reserved.
+**
+** Redistribution and use of this source file, with or without modification, is
+** permitted provided that the following conditions are met:
+**
+** 1. Redistributions of this source file must retain the above copyright
+**    notice, this list of conditions and the following disclaimer.
+**
+** 2. Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and/or other materials provided with the distribution.
+**
+** THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+** WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO
+** EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+** PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+** OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+** WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+** OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+** ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+** =============================================================================
+**/
+#ifndef _FMGUI_SPECTRUM_HPP_
+#define _FMGUI_SPECTRUM_HPP_ 0
+
+#include "FmGuiTelemetry.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*
+ * Live frequency content of a channel, e.g. the pitch rate while tuning a
+ * damper. Samples are pushed from any one thread, a worker thread owned by
+ * the Spectrum computes a Hann windowed FFT every hopSize samples, and the
+ * widget routine calls Update() once per frame to copy only the newly
+ * finished rows into the spectrogram history. FmGuiPlot.hpp draws the
+ * history as a waterfall.
+ *
+ * Like the channels it is built on, declare a Spectrum as a global or static
+ * rather than allocating it.
+ */
+
+struct FmGuiSpectrumConfig
+{
+public:
+	FmGuiSpectrumConfig(void);
+public:
+	/*
+	 * Samples per FFT, a power of two up to 8192.
+	 * Default value: 1024
+	 */
+	std::size_t fftSize;
+	/*
+	 * New samples between two FFTs.
+	 * Default value: 256
+	 */
+	std::size_t hopSize;
+	/*
+	 * Sample rate of the channel in Hz, used for the frequency axis. Must be
+	 * positive.
+	 * Default value: 1000.0f
+	 */
+	float sampleRate;
+	/*
+	 * Rows of spectrogram history kept for the waterfall.
+	 * Default value: 256
+	 */
+	std::size_t historySize;
+};
+
+namespace FmGui
+{
+class Spectrum
+{
+public:
+	explicit Spectrum(
+		const FmGuiSpectrumConfig &config = FmGuiSpectrumConfig());
+	~Spectrum(void);
+	Spectrum(const Spectrum &) = delete;
+	Spectrum &operator=(const Spectrum &) = delete;
+
+	/*
+	 * Wait free, from a single thread, e.g. the simulation thread. Returns
+	 * false if the sample was dropped because the worker fell behind.
+	 */
+	bool Push(float sample);
+	/*
+	 * Render thread, once per frame. Copies the rows finished since the last
+	 * call into the history and returns their count.
+	 */
+	std::size_t Update(void);
+	/*
+	 * Stop the worker thread. Call this in ed_fm_release for a Spectrum with
+	 * static storage duration, since the destructor of such an object runs
+	 * while the DLL is unloaded, where joining a thread may deadlock.
+	 */
+	void Stop(void);
+
+	const FmGuiSpectrumConfig &GetConfig(void) const;
+	// fftSize / 2 + 1 bins, from 0 Hz to the Nyquist frequency.
+	std::size_t GetBinCount(void) const;
+	float GetBinWidth(void) const;
+	// Seconds between two rows.
+	float GetRowPeriod(void) const;
+	/*
+	 * History of rows, in dB relative to a full scale sine. Rows are stored
+	 * newest first starting at row GetHistoryHead(), wrapping around at
+	 * historySize. Only the first GetHistoryCount() rows from the head are
+	 * valid.
+	 */
+	const float *GetHistory(void) const;
+	std::size_t GetHistoryHead(void) const;
+	std::size_t GetHistoryCount(void) const;
+	// The newest row, or nullptr before the first one.
+	const float *GetNewestRow(void) const;
+	std::uint64_t GetDroppedRowCount(void) const;
+private:
+	static constexpr std::size_t fftSizeLimit = 8192;
+	static constexpr std::size_t rowPoolSize = 16;
+
+	void RunWorker(void);
+	void ComputeRow(void);
+	void TransformFft(void);
+
+	FmGuiSpectrumConfig config;
+	std::size_t binCount;
+	// Samples from Push() to the worker.
+	Channel<float, 2 * fftSizeLimit> samples;
+	// Finished row pool slots to the render thread, and back.
+	Channel<std::uint32_t, rowPoolSize> finishedRows;
+	Channel<std::uint32_t, rowPoolSize> freeRows;
+	std::vector<float> rowPool;
+	// Worker state.
+	std::vector<float> window, hannWindow, fftReal, fftImaginary;
+	std::vector<float> twiddleReal, twiddleImaginary;
+	std::vector<std::uint32_t> bitReversal;
+	std::size_t windowHead, hopCount;
+	std::uint64_t sampleCount;
+	float magnitudeScale;
+	std::atomic<std::uint64_t> droppedRowCount;
+	// Render thread state.
+	std::vector<float> history;
+	std::size_t historyHead, historyCount;
+
+	std::atomic<bool> isStopRequested;
+	std::mutex workerMutex;
+	std::condition_variable workerCondition;
+	std::thread worker;
+};
+} // namespace FmGui
+
+#endif /* !_FMGUI_SPECTRUM_HPP_ */
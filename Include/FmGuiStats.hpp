@@ -0,0 +1,172 @@
+/* =============================================================================
+** DCS-EFM-ImGui, file: FmGuiStats.hpp Created: 17-OCT-2026
+**
+** Copyright 2022 Brian Hoffpauir, USA
+** All rights reserved.
+**
+** Redistribution and use of this source file, with or without modification, is
+** permitted provided that the following conditions are met:
+**
+** 1. Redistributions of this source file must retain the above copyright
+**    notice, this list of conditions and the following disclaimer.
+**
+** 2. Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and/or other materials provided with the distribution.
+**
+** THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+** WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO
+** EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+** PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+** OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+** WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+** OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+** ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+** =============================================================================
+**/
+#ifndef _FMGUI_STATS_HPP_
+#define _FMGUI_STATS_HPP_ 0
+
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <cmath>
+
+/*
+ * Statistics over windows of channel samples, for debug panels showing e.g.
+ * the RMS of the pitch rate over the last second. The reductions use AVX2 or
+ * SSE2 when the CPU supports them, selected once at runtime, and fall back to
+ * scalar code elsewhere.
+ */
+
+struct FmGuiWindowStats
+{
+	std::size_t count;
+	float minimum, maximum;
+	// Population statistics, computed in double precision.
+	double mean, rms, standardDeviation;
+};
+
+enum struct FmGuiSimdLevel : std::uint8_t
+{
+	SCALAR,
+	SSE2,
+	AVX2
+};
+
+namespace FmGui
+{
+/*
+ * Statistics of count values. All zero when count is zero.
+ */
+FmGuiWindowStats ComputeWindowStats(const float *pValues, std::size_t count);
+/*
+ * Statistics of a window split in two spans, e.g. the two halves of a ring
+ * that wrapped around.
+ */
+FmGuiWindowStats ComputeWindowStats(const float *pFirst,
+									std::size_t firstCount,
+									const float *pSecond,
+									std::size_t secondCount);
+/*
+ * Only the minimum and maximum of a window split in two spans. Both are zero
+ * when the window is empty.
+ */
+void ComputeWindowRange(const float *pFirst, std::size_t firstCount,
+						const float *pSecond, std::size_t secondCount,
+						float &minimum, float &maximum);
+/*
+ * The SIMD level ComputeWindowStats uses. SetSimdLevel clamps the requested
+ * level to what the CPU supports and returns the level in use, which lets
+ * benchmarks compare against the scalar baseline.
+ */
+FmGuiSimdLevel GetSimdLevel(void);
+FmGuiSimdLevel SetSimdLevel(FmGuiSimdLevel simdLevel);
+
+/*
+ * Sliding window over the last Capacity samples of a channel. The mean, RMS
+ * and standard deviation are kept up to date as samples are pushed, the
+ * minimum and maximum are reduced with SIMD when GetStats() is called. The
+ * running sums are recomputed from the window once per Capacity pushes, so
+ * rounding errors do not accumulate.
+ *
+ *     static FmGui::StatsWindow<1024> pitchRateWindow;
+ *
+ *     pitchRateChannel.Drain([](const PitchRateSample &sample) {
+ *         pitchRateWindow.Push(sample.pitchRate);
+ *     });
+ *     const FmGuiWindowStats stats = pitchRateWindow.GetStats();
+ */
+template <std::size_t Capacity>
+class StatsWindow
+{
+	static_assert(Capacity != 0, "StatsWindow capacity must not be zero.");
+public:
+	StatsWindow(void)
+		: head(0),
+		  size(0),
+		  pushCount(0),
+		  sum(0.0),
+		  sumOfSquares(0.0)
+	{
+	}
+
+	void Push(float value)
+	{
+		if (size == Capacity) {
+			const double oldValue = values[head];
+			sum -= oldValue;
+			sumOfSquares -= oldValue * oldValue;
+		} else {
+			++size;
+		}
+		values[head] = value;
+		head = (head + 1 == Capacity) ? 0 : head + 1;
+		sum += value;
+		sumOfSquares += static_cast<double>(value) * value;
+		if (++pushCount == Capacity) {
+			pushCount = 0;
+			const FmGuiWindowStats stats = ComputeWindowStats(values, size);
+			sum = stats.mean * static_cast<double>(stats.count);
+			sumOfSquares = stats.rms * stats.rms
+				* static_cast<double>(stats.count);
+		}
+	}
+	void Clear(void)
+	{
+		head = 0;
+		size = 0;
+		pushCount = 0;
+		sum = 0.0;
+		sumOfSquares = 0.0;
+	}
+	std::size_t GetSize(void) const
+	{
+		return size;
+	}
+	FmGuiWindowStats GetStats(void) const
+	{
+		FmGuiWindowStats stats = { size, 0.0f, 0.0f, 0.0, 0.0, 0.0 };
+		if (size == 0)
+			return stats;
+		// Order does not matter for the range.
+		ComputeWindowRange(values, size, nullptr, 0, stats.minimum,
+						   stats.maximum);
+		const double count = static_cast<double>(size);
+		const double meanOfSquares = std::max(0.0, sumOfSquares / count);
+		stats.mean = sum / count;
+		stats.rms = std::sqrt(meanOfSquares);
+		stats.standardDeviation =
+			std::sqrt(std::max(0.0, meanOfSquares - stats.mean * stats.mean));
+		return stats;
+	}
+private:
+	float values[Capacity];
+	std::size_t head, size, pushCount;
+	double sum, sumOfSquares;
+};
+} // namespace FmGui
+
+#endif /* !_FMGUI_STATS_HPP_ */
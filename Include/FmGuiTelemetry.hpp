@@ -0,0 +1,263 @@
+/* =============================================================================
+** DCS-EFM-ImGui, file: FmGuiTelemetry.hpp Created: 17-OCT-2026
+**
+** Copyright 2022 Brian Hoffpauir, USA
+** All rights reserved.
+**
+** Redistribution and use of this source file, with or without modification, is
+** permitted provided that the following conditions are met:
+**
+** 1. Redistributions of this source file must retain the above copyright
+**    notice, this list of conditions and the following disclaimer.
+**
+** 2. Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and/or other materials provided with the distribution.
+**
+** THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+** WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO
+** EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+** PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+** OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+** WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+** OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+** ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+** =============================================================================
+**/
+#ifndef _FMGUI_TELEMETRY_HPP_
+#define _FMGUI_TELEMETRY_HPP_ 0
+
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <type_traits>
+
+/*
+ * Passing EFM state from the simulation thread to the render thread without
+ * locks. Reading simulation state directly from the widget routine races with
+ * ed_fm_simulate; publish it through a channel instead.
+ *
+ * The types are over aligned to keep the two threads off each other's cache
+ * lines. Before C++17 operator new ignores that alignment, so declare them as
+ * globals, statics or members of such objects rather than allocating them.
+ */
+
+namespace FmGui
+{
+constexpr std::size_t cacheLineSize = 64;
+
+/*
+ * Wait free single producer, single consumer ring of samples. The simulation
+ * thread publishes samples at the simulation rate and the widget routine
+ * drains them once per frame. All storage is inline, nothing is allocated.
+ *
+ *     static FmGui::Channel<FuelSample, 1024> fuelChannel;
+ *
+ *     // Simulation thread, in ed_fm_simulate.
+ *     fuelChannel.Publish(FuelSample { time, totalVolume });
+ *
+ *     // Render thread, in the widget routine.
+ *     fuelChannel.Drain([](const FuelSample &sample) { ... });
+ */
+template <typename T, std::size_t Capacity>
+class Channel
+{
+	static_assert(std::is_trivially_copyable<T>::value,
+				  "Channel samples must be trivially copyable.");
+	static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+				  "Channel capacity must be a power of two.");
+public:
+	Channel(void)
+		: head(0),
+		  cachedTail(0),
+		  tail(0),
+		  cachedHead(0),
+		  droppedCount(0)
+	{
+	}
+	Channel(const Channel &) = delete;
+	Channel &operator=(const Channel &) = delete;
+
+	/*
+	 * Producer only. Never waits: if the consumer has fallen a whole capacity
+	 * behind, the sample is dropped and counted. Returns false when dropped.
+	 */
+	bool Publish(const T &sample)
+	{
+		const std::uint64_t headIndex = head.load(std::memory_order_relaxed);
+		if (headIndex - cachedTail == Capacity) {
+			cachedTail = tail.load(std::memory_order_acquire);
+			if (headIndex - cachedTail == Capacity) {
+				droppedCount.fetch_add(1, std::memory_order_relaxed);
+				return false;
+			}
+		}
+		samples[headIndex & (Capacity - 1)] = sample;
+		head.store(headIndex + 1, std::memory_order_release);
+		return true;
+	}
+	/*
+	 * Consumer only. Calls function(const T &) for every sample published
+	 * since the last drain, oldest first, and returns their count. The slots
+	 * are released to the producer once all of them were visited.
+	 */
+	template <typename Function>
+	std::size_t Drain(Function function)
+	{
+		const std::uint64_t tailIndex = tail.load(std::memory_order_relaxed);
+		cachedHead = head.load(std::memory_order_acquire);
+		for (std::uint64_t index = tailIndex; index != cachedHead; ++index)
+			function(static_cast<const T &>(samples[index & (Capacity - 1)]));
+		tail.store(cachedHead, std::memory_order_release);
+		return static_cast<std::size_t>(cachedHead - tailIndex);
+	}
+	/*
+	 * Consumer only. Take the oldest sample. Returns false if there is none.
+	 */
+	bool Pop(T &sample)
+	{
+		const std::uint64_t tailIndex = tail.load(std::memory_order_relaxed);
+		if (tailIndex == cachedHead) {
+			cachedHead = head.load(std::memory_order_acquire);
+			if (tailIndex == cachedHead)
+				return false;
+		}
+		sample = samples[tailIndex & (Capacity - 1)];
+		tail.store(tailIndex + 1, std::memory_order_release);
+		return true;
+	}
+	/*
+	 * Consumer only. Return true if there is no sample to take.
+	 */
+	bool IsEmpty(void) const
+	{
+		return tail.load(std::memory_order_relaxed)
+			== head.load(std::memory_order_acquire);
+	}
+	/*
+	 * Number of samples dropped because the channel was full.
+	 */
+	std::uint64_t GetDroppedCount(void) const
+	{
+		return droppedCount.load(std::memory_order_relaxed);
+	}
+private:
+	// Written by the producer.
+	alignas(cacheLineSize) std::atomic<std::uint64_t> head;
+	std::uint64_t cachedTail;
+	// Written by the consumer.
+	alignas(cacheLineSize) std::atomic<std::uint64_t> tail;
+	std::uint64_t cachedHead;
+	alignas(cacheLineSize) std::atomic<std::uint64_t> droppedCount;
+	alignas(cacheLineSize) T samples[Capacity];
+};
+
+/*
+ * Wait free triple buffer holding the latest version of a whole state struct,
+ * e.g. the aero or engine state. The simulation thread publishes once per
+ * tick and the widget routine reads the latest complete version once per
+ * frame. Versions published between two frames are skipped, use a Channel
+ * when every sample matters.
+ *
+ *     static FmGui::Snapshot<AeroState> aeroSnapshot;
+ *
+ *     // Simulation thread, in ed_fm_simulate.
+ *     aeroSnapshot.Publish(aeroState);
+ *
+ *     // Render thread, in the widget routine.
+ *     aeroSnapshot.Update();
+ *     const AeroState &aeroState = aeroSnapshot.Read();
+ */
+template <typename T>
+class Snapshot
+{
+	static_assert(std::is_trivially_copyable<T>::value,
+				  "Snapshot state must be trivially copyable.");
+public:
+	Snapshot(void)
+		: middle(1),
+		  backIndex(0),
+		  frontIndex(2),
+		  version(0)
+	{
+	}
+	Snapshot(const Snapshot &) = delete;
+	Snapshot &operator=(const Snapshot &) = delete;
+
+	/*
+	 * Producer only. The buffer to fill in place before calling Publish(),
+	 * which saves copying large states twice. It does not hold the previously
+	 * published state.
+	 */
+	T &Write(void)
+	{
+		return slots[backIndex].state;
+	}
+	/*
+	 * Producer only. Publish the buffer returned by Write().
+	 */
+	void Publish(void)
+	{
+		const std::uint8_t previous = middle.exchange(
+			static_cast<std::uint8_t>(backIndex | newBit),
+			std::memory_order_acq_rel);
+		backIndex = previous & indexMask;
+	}
+	/*
+	 * Producer only. Copy and publish state.
+	 */
+	void Publish(const T &state)
+	{
+		Write() = state;
+		Publish();
+	}
+	/*
+	 * Consumer only. Take the latest published state, if there is a newer one
+	 * than the state Read() returns. Returns true when there was.
+	 */
+	bool Update(void)
+	{
+		if ((middle.load(std::memory_order_relaxed) & newBit) == 0)
+			return false;
+		const std::uint8_t previous =
+			middle.exchange(frontIndex, std::memory_order_acq_rel);
+		frontIndex = previous & indexMask;
+		++version;
+		return true;
+	}
+	/*
+	 * Consumer only. The state taken by the last Update(), value initialized
+	 * before the first publish.
+	 */
+	const T &Read(void) const
+	{
+		return slots[frontIndex].state;
+	}
+	/*
+	 * Consumer only. Number of states taken by Update().
+	 */
+	std::uint64_t GetVersion(void) const
+	{
+		return version;
+	}
+private:
+	struct alignas(cacheLineSize) Slot
+	{
+		T state;
+	};
+	static constexpr std::uint8_t indexMask = 0x3;
+	static constexpr std::uint8_t newBit = 0x4;
+
+	Slot slots[3] = {};
+	// Index of the slot between the threads, with newBit set when the
+	// producer published into it since the consumer last took it.
+	alignas(cacheLineSize) std::atomic<std::uint8_t> middle;
+	alignas(cacheLineSize) std::uint8_t backIndex;
+	alignas(cacheLineSize) std::uint8_t frontIndex;
+	std::uint64_t version;
+};
+} // namespace FmGui
+
+#endif /* !_FMGUI_TELEMETRY_HPP_ */
@@ -27,13 +27,19 @@
 ** =============================================================================
 **/
 #include "FmGui.hpp"
+#include "FmGuiInput.hpp"
 // #include "cppimmo/FmGui.hpp"
 
 #include <MinHook.h>
+#include <windowsx.h>
 
-#include <sstream>
-#include <stack>
+#include <cfloat>
+#include <cstdarg>
+#include <cstdio>
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <vector>
 
 /* DirectX headers here: */
 #include <d3d11.h>
@@ -43,26 +49,34 @@
 #include <imgui_impl_dx11.h>
 #include <imgui_impl_win32.h>
 
-#if defined FMGUI_ENABLE_IMPLOT
-#include <implot.h>
-#endif
-
 /* Simple linking solution. */
 #pragma comment(lib, "d3d11.lib")
 
-/* Function from imgui_impl_win32; defined elsewhere */
-extern IMGUI_IMPL_API LRESULT ImGui_ImplWin32_WndProcHandler(
-	HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam);
-
 using IDXGISwapChainPresentPtr =
 	std::add_pointer<HRESULT FMGUI_FASTCALL(IDXGISwapChain *pSwapChain,
 		UINT syncInterval, UINT flags)>::type;
 
 namespace FmGui
 {
+/*
+ * Window messages for the user's input routine, which is called on the render
+ * thread before each frame.
+ */
+struct InputMessage
+{
+	UINT uMsg;
+	WPARAM wParam;
+	LPARAM lParam;
+};
 // Functions
+static std::size_t AppendFormat(char *pBuffer, std::size_t bufferSize,
+								std::size_t length, const char *format, ...);
+static ID3D11InfoQueue *OpenInfoQueue(void);
+static bool FormatDebugLayerMessages(ID3D11InfoQueue *pInfoQueue,
+									 char *pBuffer, std::size_t bufferSize,
+									 std::size_t &length);
+static void CloseInfoQueue(ID3D11InfoQueue *pInfoQueue);
 static LPVOID LookupSwapChainVTable(void);
-static std::string MinHookStatusToStdString(MH_STATUS mhStatus);
 static HRESULT FMGUI_FASTCALL SwapChainPresentImpl(
 	IDXGISwapChain *pSwapChain,
 	UINT syncInterval,
@@ -79,6 +93,26 @@ static HRESULT GetDeviceContext(
 );
 static void OnResize(IDXGISwapChain *pSwapChain, UINT newWidth, UINT newHeight);
 static LRESULT WndProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam);
+static void PushInputEvents(HWND hWnd, UINT uMsg, WPARAM wParam,
+							LPARAM lParam);
+static bool PushMouseButtonEvent(HWND hWnd, UINT uMsg, WPARAM wParam,
+								 LPARAM lParam);
+static void PushKeyEvent(UINT uMsg, WPARAM wParam, LPARAM lParam);
+static ImGuiKey VirtualKeyToImGuiKey(WPARAM virtualKey);
+static void CallInputRoutine(const InputMessage &inputMessage);
+static bool RendererInitialize(void *pUserData);
+static bool RendererNewFrame(void *pUserData);
+static void PlatformNewFrame(void);
+static bool SetMouseCursor(void);
+static void RendererRenderDrawData(ImDrawData *pDrawData, void *pUserData);
+static void RendererPresent(void *pUserData);
+static void *RendererCreateTexture(unsigned int width, unsigned int height,
+								   void *pUserData);
+static bool RendererUpdateTexture(void *pTexture, unsigned int y,
+								  unsigned int height,
+								  const std::uint32_t *pPixels,
+								  void *pUserData);
+static void RendererDestroyTexture(void *pTexture, void *pUserData);
 // Variables
 static ID3D11Device *pDevice = nullptr;
 static ID3D11DeviceContext *pDeviceContext = nullptr;
@@ -91,129 +125,186 @@ static IDXGISwapChainPresentPtr pSwapChainPresentTrampoline = nullptr;
 static HWND hWnd = nullptr;
 // WndProc used by application, in this case DCS: World
 static WNDPROC pWndProcApp = nullptr;
-static bool isInitialized = false, areWidgetsEnabled = false;
-static FmGuiRoutinePtr pWidgetRoutine = nullptr;
+// Swap chain of the Present call being handled.
+static IDXGISwapChain *pCurrentSwapChain = nullptr;
+static UINT currentSyncInterval = 0, currentFlags = 0;
+static HRESULT presentResult = S_OK;
 static FmGuiInputRoutinePtr pInputRoutine = nullptr;
-// ImGui Configuration
-// static constexpr ImGuiConfigFlags imGuiConfigFlags =
-// 	ImGuiConfigFlags_NavNoCaptureKeyboard;
-// static constexpr const char *imGuiConfigFileName = "imgui.ini";
-static ImGuiContext *pImGuiContext = nullptr;
-#if defined FMGUI_ENABLE_IMPLOT
-static ImPlotContext *pImPlotContext = nullptr;
-#endif
+static Channel<InputMessage, 512> inputMessages;
+// Window thread state of the input translation.
+static bool isMouseTracked = false;
+static unsigned int pressedMouseButtons = 0;
+/*
+ * The cursor ImGui asked for in the last frame, published by the render
+ * thread for WM_SETCURSOR. ImGuiMouseCursor_COUNT leaves the cursor to DCS.
+ */
+static std::atomic<int> mouseCursor(ImGuiMouseCursor_COUNT);
+// Render thread state of the platform frame.
+static std::chrono::steady_clock::time_point lastFrameTime;
+static bool hasLastFrameTime = false;
 static bool isImGuiImplWin32Initialized = false;
 static bool isImGuiImplDX11Initialized = false;
-static FmGuiConfig fmGuiConfig;
-static FmGuiMessageCallback pMessageCallback = nullptr;
-static std::stack<FmGuiMessage> messageStack;
-static constexpr std::stack<FmGuiMessage>::size_type
-	messageStackMaxSize = 24;
+// Reused by DebugLayerMessageDump, grows to the largest message once.
+static std::vector<std::uint64_t> debugLayerMessageStorage;
 } // namespace FmGui
 
-// Todo turn this logic into a inline static function.
-#define PUSH_MSG(SEVERITY, CONTENT) \
-	if (messageStack.size() > messageStackMaxSize) { \
-		messageStack.pop(); \
-	} \
-	else { \
-		if (messageStack.top().content != CONTENT) { \
-			messageStack.emplace( \
-				FmGuiMessage( \
-					SEVERITY, \
-					CONTENT, \
-					__FILE__, \
-					__func__, \
-					__LINE__ \
-			)); \
-			if (pMessageCallback != nullptr) \
-				pMessageCallback(messageStack.top()); \
-		} \
-	}
-
-void
-FmGui::SetRoutinePtr(FmGuiRoutinePtr pRoutine)
-{
-	pWidgetRoutine = pRoutine;
-}
-
 void
 FmGui::SetInputRoutinePtr(FmGuiInputRoutinePtr pInputRoutine)
 {
 	FmGui::pInputRoutine = pInputRoutine;
 }
 
-void
-FmGui::SetMessageCallback(FmGuiMessageCallback pMessageCallback)
+/*
+ * Formats at pBuffer + length like std::snprintf and returns the new length
+ * of the whole text, which may exceed bufferSize.
+ */
+static std::size_t
+FmGui::AppendFormat(char *pBuffer, std::size_t bufferSize, std::size_t length,
+					const char *format, ...)
 {
-	FmGui::pMessageCallback = pMessageCallback;
+	char *pEnd = nullptr;
+	std::size_t remainingSize = 0;
+	if (length < bufferSize) {
+		pEnd = pBuffer + length;
+		remainingSize = bufferSize - length;
+	}
+	std::va_list args;
+	va_start(args, format);
+	const int count = std::vsnprintf(pEnd, remainingSize, format, args);
+	va_end(args);
+	return (count > 0) ? length + static_cast<std::size_t>(count) : length;
 }
 
 std::string
 FmGui::AddressDump(void)
 {
-	std::ostringstream oss; oss.precision(2);
-	oss << std::hex
-		<< "ID3D11Device Pointer Location: "
-		<< reinterpret_cast<void *>(&pDevice) << '\n'
-		<< "ID3D11DeviceContext Pointer Location: "
-		<< reinterpret_cast<void *>(&pDeviceContext) << '\n'
-		<< "ID3D11RenderTargetView Pointer Location: "
-		<< reinterpret_cast<void *>(&pRenderTargetView) << '\n';
-	// << "IDXGISwapChain Pointer Location: "
-	// << reinterpret_cast<void *>(&pSwapChain) << '\n';
-	return oss.str();
+	std::string dump(AddressDump(nullptr, 0), '\0');
+	AddressDump(&dump[0], dump.size() + 1);
+	return dump;
 }
 
-std::string
-FmGui::DebugLayerMessageDump(void)
+std::size_t
+FmGui::AddressDump(char *pBuffer, std::size_t bufferSize)
+{
+	std::size_t length = 0;
+	length = AppendFormat(pBuffer, bufferSize, length,
+						  "ID3D11Device Pointer Location: %p\n",
+						  static_cast<void *>(&pDevice));
+	length = AppendFormat(pBuffer, bufferSize, length,
+						  "ID3D11DeviceContext Pointer Location: %p\n",
+						  static_cast<void *>(&pDeviceContext));
+	length = AppendFormat(pBuffer, bufferSize, length,
+						  "ID3D11RenderTargetView Pointer Location: %p\n",
+						  static_cast<void *>(&pRenderTargetView));
+	return length;
+}
+
+static ID3D11InfoQueue *
+FmGui::OpenInfoQueue(void)
 {
 	ID3D11InfoQueue *pInfoQueue = nullptr;
 	if (!pDevice || FAILED(pDevice->QueryInterface(__uuidof(ID3D11InfoQueue),
 		reinterpret_cast<void **>(&pInfoQueue)))) {
-		PUSH_MSG(FmGuiMessageSeverity::HIGH, "QueryInterface failed!");
-		return std::string();
+		FMGUI_PUSH_MSG(FmGuiMessageSeverity::HIGH, "QueryInterface failed!");
+		return nullptr;
 	}
-
 	if (FAILED(pInfoQueue->PushEmptyStorageFilter())) {
-		PUSH_MSG(FmGuiMessageSeverity::HIGH,
-				 "ID3D11InfoQueue::PushEmptyStorageFilter failed!");
-		return std::string();
+		FMGUI_PUSH_MSG(FmGuiMessageSeverity::HIGH,
+					   "ID3D11InfoQueue::PushEmptyStorageFilter failed!");
+		ReleaseCOM(pInfoQueue);
+		return nullptr;
 	}
+	return pInfoQueue;
+}
 
-	std::ostringstream oss;
+/*
+ * Formats the stored messages without removing them, so the text can be
+ * measured first.
+ */
+static bool
+FmGui::FormatDebugLayerMessages(ID3D11InfoQueue *pInfoQueue, char *pBuffer,
+								std::size_t bufferSize, std::size_t &length)
+{
+	length = 0;
+	if (bufferSize > 0)
+		pBuffer[0] = '\0';
 	const UINT64 messageCount = pInfoQueue->GetNumStoredMessages();
-
 	for (UINT64 index = 0; index < messageCount; ++index) {
 		SIZE_T messageSize = 0;
 		// Get the size of the message.
 		if (FAILED(pInfoQueue->GetMessage(index, nullptr, &messageSize))) {
-			PUSH_MSG(FmGuiMessageSeverity::HIGH, "GetMessage failed!");
-			return std::string();
-		}
-		// Allocate memory.
-		D3D11_MESSAGE *message = (D3D11_MESSAGE *)std::malloc(messageSize);
-		if (!message) {
-			PUSH_MSG(FmGuiMessageSeverity::HIGH, "std::malloc failed!");
-			return std::string();
+			FMGUI_PUSH_MSG(FmGuiMessageSeverity::HIGH, "GetMessage failed!");
+			return false;
 		}
+		const std::size_t wordCount =
+			(messageSize + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t);
+		if (debugLayerMessageStorage.size() < wordCount)
+			debugLayerMessageStorage.resize(wordCount);
+		D3D11_MESSAGE *const pMessage =
+			reinterpret_cast<D3D11_MESSAGE *>(debugLayerMessageStorage.data());
 		// Get the message itself.
-		if (FAILED(pInfoQueue->GetMessage(index, message, &messageSize))) {
-			PUSH_MSG(FmGuiMessageSeverity::HIGH,
-					 "ID3D11InfoQueue::GetMessaged failed!");
-			return std::string();
+		if (FAILED(pInfoQueue->GetMessage(index, pMessage, &messageSize))) {
+			FMGUI_PUSH_MSG(FmGuiMessageSeverity::HIGH,
+						   "ID3D11InfoQueue::GetMessage failed!");
+			return false;
 		}
-		
-		oss << "D3D11 MESSAGE|ID:" << static_cast<int>(message->ID)
-			<< "|CATEGORY:" << static_cast<int>(message->Category)
-			<< "|SEVERITY:" << static_cast<int>(message->Severity)
-			<< "|DESC_LEN:" << message->DescriptionByteLength
-			<< "|DESC:" << message->pDescription;
-		std::free(message);
+		length = AppendFormat(pBuffer, bufferSize, length,
+							  "D3D11 MESSAGE|ID:%d|CATEGORY:%d|SEVERITY:%d"
+							  "|DESC_LEN:%u|DESC:%s\n",
+							  static_cast<int>(pMessage->ID),
+							  static_cast<int>(pMessage->Category),
+							  static_cast<int>(pMessage->Severity),
+							  static_cast<unsigned int>(
+								  pMessage->DescriptionByteLength),
+							  pMessage->pDescription);
 	}
+	return true;
+}
+
+static void
+FmGui::CloseInfoQueue(ID3D11InfoQueue *pInfoQueue)
+{
 	pInfoQueue->ClearStoredMessages();
+	pInfoQueue->PopStorageFilter();
 	ReleaseCOM(pInfoQueue);
-	return std::string();
+}
+
+std::string
+FmGui::DebugLayerMessageDump(void)
+{
+	ID3D11InfoQueue *pInfoQueue = OpenInfoQueue();
+	if (!pInfoQueue)
+		return std::string();
+	std::string dump;
+	std::size_t length = 0;
+	if (FormatDebugLayerMessages(pInfoQueue, nullptr, 0, length)
+		&& length > 0) {
+		dump.resize(length);
+		if (!FormatDebugLayerMessages(pInfoQueue, &dump[0], length + 1,
+									  length)) {
+			dump.clear();
+		}
+		// Messages stored in between are left out.
+		dump.resize(std::min(dump.size(), length));
+	}
+	CloseInfoQueue(pInfoQueue);
+	return dump;
+}
+
+std::size_t
+FmGui::DebugLayerMessageDump(char *pBuffer, std::size_t bufferSize)
+{
+	ID3D11InfoQueue *pInfoQueue = OpenInfoQueue();
+	std::size_t length = 0;
+	if (!pInfoQueue) {
+		if (bufferSize > 0)
+			pBuffer[0] = '\0';
+		return 0;
+	}
+	if (!FormatDebugLayerMessages(pInfoQueue, pBuffer, bufferSize, length))
+		length = 0;
+	CloseInfoQueue(pInfoQueue);
+	return length;
 }
 
 static LPVOID
@@ -239,7 +330,7 @@ FmGui::LookupSwapChainVTable(void)
 	wndClassEx.hIconSm = nullptr;
 
 	if (RegisterClassExA(&wndClassEx) == 0) {
-		PUSH_MSG(FmGuiMessageSeverity::HIGH, "RegisterClassEx failed!");
+		FMGUI_PUSH_MSG(FmGuiMessageSeverity::HIGH, "RegisterClassEx failed!");
 		return nullptr;
 	}
 
@@ -259,7 +350,7 @@ FmGui::LookupSwapChainVTable(void)
 		nullptr
 	);
 	if (!hLocalWnd) {
-		PUSH_MSG(FmGuiMessageSeverity::HIGH, "CreateWindowEx failed!");
+		FMGUI_PUSH_MSG(FmGuiMessageSeverity::HIGH, "CreateWindowEx failed!");
 		UnregisterClassA(wndClassEx.lpszClassName, wndClassEx.hInstance);
 		return nullptr;
 	} */
@@ -305,19 +396,16 @@ FmGui::LookupSwapChainVTable(void)
 	swapChainDesc.BufferCount = 1;
 	HWND hWndFg = GetForegroundWindow(); // GetActiveWindow()
 	if (!hWndFg) {
-		PUSH_MSG(FmGuiMessageSeverity::HIGH, "GetForegroundWindow failed!");
+		FMGUI_PUSH_MSG(FmGuiMessageSeverity::HIGH,
+					   "GetForegroundWindow failed!");
 		return nullptr;
 	}
 	else {
 		constexpr int titleBufferSize = 256;
 		CHAR title[titleBufferSize];
 		GetWindowTextA(hWndFg, title, titleBufferSize);
-
-		char buffer[124];
-		const std::size_t bufferLength = std::size(buffer);
-		std::snprintf(buffer, bufferLength, "FmGui has window \"%s\".", title);
-		PUSH_MSG(FmGuiMessageSeverity::NOTIFICATION,
-				 std::string(buffer, bufferLength));
+		FMGUI_PUSH_MSGF(FmGuiMessageSeverity::NOTIFICATION,
+						"FmGui has window \"%s\".", title);
 	}
 	swapChainDesc.OutputWindow = hWndFg;
 	swapChainDesc.Windowed = TRUE;
@@ -337,8 +425,8 @@ FmGui::LookupSwapChainVTable(void)
 		&featureLevel,
 		&pLocalDeviceContext
 	))) {
-		PUSH_MSG(FmGuiMessageSeverity::HIGH,
-				 "D3D11CreateDeviceAndSwapChain failed!");
+		FMGUI_PUSH_MSG(FmGuiMessageSeverity::HIGH,
+					   "D3D11CreateDeviceAndSwapChain failed!");
 		// DestroyWindow(hLocalWnd);
 		// UnregisterClassA(wndClassEx.lpszClassName, wndClassEx.hInstance);
 		return nullptr;
@@ -358,35 +446,27 @@ FmGui::LookupSwapChainVTable(void)
 	return resultant;
 }
 
-bool
-FmGui::SetWidgetVisibility(bool isEnabled)
-{
-	const bool previousValue = areWidgetsEnabled;
-	areWidgetsEnabled = isEnabled;
-	return previousValue;
-}
-
-inline static std::string
-FmGui::MinHookStatusToStdString(MH_STATUS mhStatus)
-{
-	char buffer[124];
-	const std::size_t bufferLength = std::size(buffer);
-	const int written = std::snprintf(buffer, bufferLength, "%s",
-									  MH_StatusToString(mhStatus));
-	return (written > 0) ? std::string(buffer, written) : "";
-}
-
 bool
 FmGui::StartupHook(const FmGuiConfig &config)
 {
-	fmGuiConfig = config;
-	PUSH_MSG(FmGuiMessageSeverity::NOTIFICATION,
-			 "Redirecting Direct3D routines...");
+	FmGuiRenderer renderer;
+	renderer.pInitialize = RendererInitialize;
+	renderer.pNewFrame = RendererNewFrame;
+	renderer.pRenderDrawData = RendererRenderDrawData;
+	renderer.pCreateTexture = RendererCreateTexture;
+	renderer.pUpdateTexture = RendererUpdateTexture;
+	renderer.pDestroyTexture = RendererDestroyTexture;
+	renderer.pPresent = RendererPresent;
+	Core::SetRenderer(renderer);
+	Core::Startup(config);
+	FMGUI_PUSH_MSG(FmGuiMessageSeverity::NOTIFICATION,
+				   "Redirecting Direct3D routines...");
 	// HMODULE hDxgi = GetModuleHandleA(dxgiModuleName);
 	// DWORD_PTR dwpDxgi = reinterpret_cast<DWORD_PTR>(hDxgi);
 	LPVOID pSwapChainPresentOriginal = LookupSwapChainVTable();
 	if (!pSwapChainPresentOriginal) {
-		PUSH_MSG(FmGuiMessageSeverity::HIGH, "FmGui::LookupSwapChainVTable!");
+		FMGUI_PUSH_MSG(FmGuiMessageSeverity::HIGH,
+					   "FmGui::LookupSwapChainVTable!");
 	}
 	// DWORD_PTR hDxgi = (DWORD_PTR)GetModuleHandle(L"dxgi.dll");
 	// 
@@ -395,27 +475,30 @@ FmGui::StartupHook(const FmGuiConfig &config)
 
 	MH_STATUS mhStatus = MH_Initialize();
 	if (mhStatus != MH_OK) {
-		PUSH_MSG(FmGuiMessageSeverity::HIGH, "MH_Initialize failed: "
-				 + MinHookStatusToStdString(mhStatus) + '!');
+		FMGUI_PUSH_MSGF(FmGuiMessageSeverity::HIGH,
+						"MH_Initialize failed: %s!",
+						MH_StatusToString(mhStatus));
 		return false;
 	}
 
 	mhStatus = MH_CreateHook(pSwapChainPresentOriginal, &SwapChainPresentImpl,
 		reinterpret_cast<LPVOID *>(&pSwapChainPresentTrampoline));
 	if (mhStatus != MH_OK) {
-		PUSH_MSG(FmGuiMessageSeverity::HIGH, "MH_CreateHook failed: "
-				 + MinHookStatusToStdString(mhStatus) + '!');
+		FMGUI_PUSH_MSGF(FmGuiMessageSeverity::HIGH,
+						"MH_CreateHook failed: %s!",
+						MH_StatusToString(mhStatus));
 		return false;
 	}
 	mhStatus = MH_EnableHook(pSwapChainPresentOriginal);
 	if (mhStatus != MH_OK) {
-		PUSH_MSG(FmGuiMessageSeverity::HIGH, "MH_EnableHook failed: "
-				 + MinHookStatusToStdString(mhStatus) + '!');
+		FMGUI_PUSH_MSGF(FmGuiMessageSeverity::HIGH,
+						"MH_EnableHook failed: %s!",
+						MH_StatusToString(mhStatus));
 		return false;
 	}
 
-	PUSH_MSG(FmGuiMessageSeverity::NOTIFICATION,
-			 "Direct3D Redirection complete.");
+	FMGUI_PUSH_MSG(FmGuiMessageSeverity::NOTIFICATION,
+				   "Direct3D Redirection complete.");
 	return true;
 }
 
@@ -423,146 +506,284 @@ static HRESULT FMGUI_FASTCALL
 FmGui::SwapChainPresentImpl(IDXGISwapChain *pSwapChain, UINT syncInterval,
 					 UINT flags)
 {
-	if (!isInitialized) {
-		bool boolResult;
-		HRESULT hResult;
+	// Suspended: forward straight to DCS: World.
+	if (Core::IsSuspended())
+		return pSwapChainPresentTrampoline(pSwapChain, syncInterval, flags);
+	// Until initialized, Frame makes the (rate limited) attempts.
+	pCurrentSwapChain = pSwapChain;
+	currentSyncInterval = syncInterval;
+	currentFlags = flags;
+	// A frame that ran has presented through RendererPresent.
+	if (Core::Frame())
+		return presentResult;
+	return pSwapChainPresentTrampoline(pSwapChain, syncInterval, flags);
+}
+
+/*
+ * Each step is skipped once it has succeeded, so a retry after a failure
+ * resumes where the previous attempt stopped.
+ */
+static bool
+FmGui::RendererInitialize(void *pUserData)
+{
+	IDXGISwapChain *const pSwapChain = pCurrentSwapChain;
+	HRESULT hResult;
+	if (!pSwapChain)
+		return false;
 
-		PUSH_MSG(FmGuiMessageSeverity::NOTIFICATION,
-				 "Setting up present hook...");
+	if (!pDevice) {
+		FMGUI_PUSH_MSG(FmGuiMessageSeverity::NOTIFICATION,
+					   "Setting up present hook...");
 		hResult = GetDevice(pSwapChain, &pDevice);
 		if (FAILED(hResult)) {
-			PUSH_MSG(FmGuiMessageSeverity::HIGH, "FmGui::GetDevice failed!");
-			return pSwapChainPresentTrampoline(pSwapChain, syncInterval, flags);
+			FMGUI_PUSH_MSG(FmGuiMessageSeverity::HIGH,
+						   "FmGui::GetDevice failed!");
+			return false;
 		}
-		hResult = GetDeviceContext(pSwapChain, &pDevice,
-								   &pDeviceContext);
+	}
+	if (!pDeviceContext) {
+		hResult = GetDeviceContext(pSwapChain, &pDevice, &pDeviceContext);
 		if (FAILED(hResult)) {
-			PUSH_MSG(FmGuiMessageSeverity::HIGH,
-					 "FmGui::GetDeviceContext failed!");
-			return pSwapChainPresentTrampoline(pSwapChain, syncInterval, flags);
-		}
-		pImGuiContext = ImGui::CreateContext();
-		if (!pImGuiContext) {
-			PUSH_MSG(FmGuiMessageSeverity::HIGH,
-					 "ImGui::CreateContext failed!");
-			return pSwapChainPresentTrampoline(pSwapChain, syncInterval, flags);
-		}
-#if defined FMGUI_ENABLE_IMPLOT
-		pImPlotContext = ImPlot::CreateContext();
-		if (!pImPlotContext) {
-			PUSH_MSG(FmGuiMessageSeverity::HIGH,
-					 "ImPlot::CreateContext failed!");
-			return pSwapChainPresentTrampoline(pSwapChain, syncInterval, flags);
-		}
-#endif
-		ImGui::SetCurrentContext(pImGuiContext);
-#if defined FMGUI_ENABLE_IMPLOT
-		ImPlot::SetCurrentContext(pImPlotContext);
-#endif
-		ImGuiIO &imGuiIO = ImGui::GetIO();
-		// Configuration of the current ImGui context.
-		imGuiIO.ConfigFlags |= fmGuiConfig.imGuiConfigFlags;
-#if defined FMGUI_ENABLE_IMPLOT
-		/*
-		 * For ImPlot enable meshes with over 64,000 vertices while using the
-		 * default backend 16 bit value for indexed drawing.
-		 * https://github.com/ocornut/imgui/issues/2591
-		 * (Extremely Important Note) Option 2:
-		 * https://github.com/epezent/implot/blob/master/README.md
-		 */
-		imGuiIO.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;
-#endif
-		if (fmGuiConfig.imGuiIniFileName.empty())
-			imGuiIO.IniFilename = nullptr;
-		else
-			imGuiIO.IniFilename = fmGuiConfig.imGuiIniFileName.c_str();
-		imGuiIO.IniSavingRate = fmGuiConfig.imGuiIniSavingRate;
-		switch (fmGuiConfig.imGuiStyle) {
-		case FmGuiStyle::CLASSIC:
-			ImGui::StyleColorsClassic();
-			break;
-		case FmGuiStyle::DARK:
-			ImGui::StyleColorsDark();
-			break;
-		case FmGuiStyle::LIGHT:
-			ImGui::StyleColorsLight();
-			break;
+			FMGUI_PUSH_MSG(FmGuiMessageSeverity::HIGH,
+						   "FmGui::GetDeviceContext failed!");
+			return false;
 		}
+	}
 
+	if (!pWndProcApp) {
 		// Get the IDXGISwapChain's description.
 		DXGI_SWAP_CHAIN_DESC swapChainDesc;
 		ZeroMemory(&swapChainDesc, sizeof(swapChainDesc));
 		if (FAILED(pSwapChain->GetDesc(&swapChainDesc))) {
-			PUSH_MSG(FmGuiMessageSeverity::HIGH,
-					 "IDXGISwapChain::GetDesc failed!");
-			return pSwapChainPresentTrampoline(pSwapChain, syncInterval, flags);
+			FMGUI_PUSH_MSG(FmGuiMessageSeverity::HIGH,
+						   "IDXGISwapChain::GetDesc failed!");
+			return false;
 		}
 		// Set global window handle to the OutputWindow of the IDXGISwapChain.
 		hWnd = swapChainDesc.OutputWindow;
 		pWndProcApp = reinterpret_cast<WNDPROC>(SetWindowLongPtr(hWnd,
 			GWLP_WNDPROC, reinterpret_cast<LONG_PTR>(WndProc)));
 		if (pWndProcApp == NULL) {
-			PUSH_MSG(FmGuiMessageSeverity::HIGH, "SetWindowLongPtr failed!");
-			return S_FALSE;
+			FMGUI_PUSH_MSG(FmGuiMessageSeverity::HIGH,
+						   "SetWindowLongPtr failed!");
+			return false;
 		}
+	}
 
-		// ImGui Win32 and DX11 implementation initialization.
-		bool result = ImGui_ImplWin32_Init(hWnd);
-		isImGuiImplWin32Initialized = result;
-		if (!result) {
-			PUSH_MSG(FmGuiMessageSeverity::HIGH,
-					 "ImGui_ImplWin32_Init failed!");
-			return S_FALSE;
+	// ImGui Win32 and DX11 implementation initialization.
+	if (!isImGuiImplWin32Initialized) {
+		isImGuiImplWin32Initialized = ImGui_ImplWin32_Init(hWnd);
+		if (!isImGuiImplWin32Initialized) {
+			FMGUI_PUSH_MSG(FmGuiMessageSeverity::HIGH,
+						   "ImGui_ImplWin32_Init failed!");
+			return false;
 		}
-
-		result = ImGui_ImplDX11_Init(pDevice, pDeviceContext);
-		isImGuiImplDX11Initialized = result;
-		if (!result) {
-			PUSH_MSG(FmGuiMessageSeverity::HIGH,
-					 "ImGui_ImplDX11_Init failed!");
-			return S_FALSE;
+		ImGui::GetIO().ImeWindowHandle = hWnd;
+	}
+	if (!isImGuiImplDX11Initialized) {
+		isImGuiImplDX11Initialized = ImGui_ImplDX11_Init(pDevice,
+														 pDeviceContext);
+		if (!isImGuiImplDX11Initialized) {
+			FMGUI_PUSH_MSG(FmGuiMessageSeverity::HIGH,
+						   "ImGui_ImplDX11_Init failed!");
+			return false;
 		}
-		imGuiIO.ImeWindowHandle = hWnd;
+	}
 
+	if (!pRenderTargetView) {
 		// Retrieve the back buffer from the IDXGISwapChain.
 		ID3D11Texture2D *pSwapChainBackBuffer = nullptr;
 		hResult = pSwapChain->GetBuffer(0, __uuidof(ID3D11Texture2D),
 			reinterpret_cast<LPVOID *>(&pSwapChainBackBuffer));
 		if (FAILED(hResult)) {
-			PUSH_MSG(FmGuiMessageSeverity::HIGH,
-					 "IDXGISwapChain::GetBuffer failed!");
-			return S_FALSE;
+			FMGUI_PUSH_MSG(FmGuiMessageSeverity::HIGH,
+						   "IDXGISwapChain::GetBuffer failed!");
+			return false;
 		}
 		hResult = pDevice->CreateRenderTargetView(pSwapChainBackBuffer,
 												  nullptr, &pRenderTargetView);
+		ReleaseCOM(pSwapChainBackBuffer);
 		if (FAILED(hResult)) {
-			PUSH_MSG(FmGuiMessageSeverity::HIGH,
-					 "ID3D11Device::CreateRenderTargetView failed!");
-			return S_FALSE;
+			FMGUI_PUSH_MSG(FmGuiMessageSeverity::HIGH,
+						   "ID3D11Device::CreateRenderTargetView failed!");
+			return false;
 		}
-		ReleaseCOM(pSwapChainBackBuffer);
-		isInitialized = true;
 	}
-	else {
-		ImGui::SetCurrentContext(pImGuiContext);
-		// Check for NULL context.
-		if (!ImGui::GetCurrentContext())
-			return pSwapChainPresentTrampoline(pSwapChain, syncInterval, flags);
-		ImGui_ImplWin32_NewFrame();
-		ImGui_ImplDX11_NewFrame();
-
-		ImGui::NewFrame();
-		if (areWidgetsEnabled) {
-			if (pWidgetRoutine != nullptr)
-				pWidgetRoutine();
-		}
-		ImGui::EndFrame();
-		ImGui::Render();
+	return true;
+}
 
-		pDeviceContext->OMSetRenderTargets(1, &pRenderTargetView, nullptr);
-		ImGui_ImplDX11_RenderDrawData(ImGui::GetDrawData());
+static bool
+FmGui::RendererNewFrame(void *pUserData)
+{
+	inputMessages.Drain(CallInputRoutine);
+	PlatformNewFrame();
+	ImGui_ImplDX11_NewFrame();
+	return true;
+}
+
+/*
+ * Stands in for ImGui_ImplWin32_NewFrame, whose mouse update would poll
+ * GetCursorPos and add a position of its own to every frame, since the
+ * backend's message handler that tracks the mouse is never called. The
+ * position comes from the input queue alone, and the cursor shape is set by
+ * WndProc on WM_SETCURSOR.
+ */
+static void
+FmGui::PlatformNewFrame(void)
+{
+	ImGuiIO &imGuiIO = ImGui::GetIO();
+	RECT clientRect = { 0, 0, 0, 0 };
+	GetClientRect(hWnd, &clientRect);
+	imGuiIO.DisplaySize = ImVec2(
+		static_cast<float>(clientRect.right - clientRect.left),
+		static_cast<float>(clientRect.bottom - clientRect.top));
+
+	const std::chrono::steady_clock::time_point now =
+		std::chrono::steady_clock::now();
+	imGuiIO.DeltaTime = hasLastFrameTime
+		? std::chrono::duration<float>(now - lastFrameTime).count()
+		: 1.0f / 60.0f;
+	// ImGui asserts a positive delta time.
+	imGuiIO.DeltaTime = std::max(imGuiIO.DeltaTime, 1.0e-6f);
+	lastFrameTime = now;
+	hasLastFrameTime = true;
+
+	if (imGuiIO.WantSetMousePos) {
+		POINT mousePos = { static_cast<LONG>(imGuiIO.MousePos.x),
+						   static_cast<LONG>(imGuiIO.MousePos.y) };
+		if (ClientToScreen(hWnd, &mousePos))
+			SetCursorPos(mousePos.x, mousePos.y);
 	}
-	return pSwapChainPresentTrampoline(pSwapChain, syncInterval, flags);
+
+	// The cursor of the last frame, like the backend.
+	int cursor = ImGuiMouseCursor_COUNT;
+	if ((imGuiIO.ConfigFlags & ImGuiConfigFlags_NoMouseCursorChange) == 0) {
+		cursor = imGuiIO.MouseDrawCursor ? ImGuiMouseCursor_None
+			: ImGui::GetMouseCursor();
+	}
+	mouseCursor.store(cursor, std::memory_order_relaxed);
+}
+
+/*
+ * Window thread. Returns false if the cursor is left to DCS: World.
+ */
+static bool
+FmGui::SetMouseCursor(void)
+{
+	LPTSTR cursorName = nullptr;
+	switch (mouseCursor.load(std::memory_order_relaxed)) {
+	case ImGuiMouseCursor_None:
+		SetCursor(nullptr);
+		return true;
+	case ImGuiMouseCursor_Arrow: cursorName = IDC_ARROW; break;
+	case ImGuiMouseCursor_TextInput: cursorName = IDC_IBEAM; break;
+	case ImGuiMouseCursor_ResizeAll: cursorName = IDC_SIZEALL; break;
+	case ImGuiMouseCursor_ResizeEW: cursorName = IDC_SIZEWE; break;
+	case ImGuiMouseCursor_ResizeNS: cursorName = IDC_SIZENS; break;
+	case ImGuiMouseCursor_ResizeNESW: cursorName = IDC_SIZENESW; break;
+	case ImGuiMouseCursor_ResizeNWSE: cursorName = IDC_SIZENWSE; break;
+	case ImGuiMouseCursor_Hand: cursorName = IDC_HAND; break;
+	case ImGuiMouseCursor_NotAllowed: cursorName = IDC_NO; break;
+	default: return false;
+	}
+	SetCursor(LoadCursor(nullptr, cursorName));
+	return true;
+}
+
+static void
+FmGui::RendererRenderDrawData(ImDrawData *pDrawData, void *pUserData)
+{
+	pDeviceContext->OMSetRenderTargets(1, &pRenderTargetView, nullptr);
+	ImGui_ImplDX11_RenderDrawData(pDrawData);
+}
+
+/*
+ * Forwards the Present call being handled to DCS: World, so that the present
+ * stage is part of the frame statistics.
+ */
+static void
+FmGui::RendererPresent(void *pUserData)
+{
+	presentResult = pSwapChainPresentTrampoline(pCurrentSwapChain,
+												currentSyncInterval,
+												currentFlags);
+}
+
+/*
+ * Textures are returned as their shader resource view, which is the
+ * ImTextureID of the DX11 backend. The view holds the only other reference to
+ * the texture, so releasing the view releases both.
+ */
+static void *
+FmGui::RendererCreateTexture(unsigned int width, unsigned int height,
+							 void *pUserData)
+{
+	if (!pDevice || width == 0 || height == 0)
+		return nullptr;
+	D3D11_TEXTURE2D_DESC textureDesc;
+	ZeroMemory(&textureDesc, sizeof(textureDesc));
+	textureDesc.Width = width;
+	textureDesc.Height = height;
+	textureDesc.MipLevels = 1;
+	textureDesc.ArraySize = 1;
+	textureDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+	textureDesc.SampleDesc.Count = 1;
+	textureDesc.Usage = D3D11_USAGE_DEFAULT;
+	textureDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+	ID3D11Texture2D *pTexture = nullptr;
+	if (FAILED(pDevice->CreateTexture2D(&textureDesc, nullptr, &pTexture))) {
+		FMGUI_PUSH_MSG(FmGuiMessageSeverity::MEDIUM,
+					   "ID3D11Device::CreateTexture2D failed!");
+		return nullptr;
+	}
+	D3D11_SHADER_RESOURCE_VIEW_DESC viewDesc;
+	ZeroMemory(&viewDesc, sizeof(viewDesc));
+	viewDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+	viewDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
+	viewDesc.Texture2D.MipLevels = 1;
+	ID3D11ShaderResourceView *pView = nullptr;
+	const HRESULT hResult = pDevice->CreateShaderResourceView(pTexture,
+															  &viewDesc,
+															  &pView);
+	ReleaseCOM(pTexture);
+	if (FAILED(hResult)) {
+		FMGUI_PUSH_MSG(FmGuiMessageSeverity::MEDIUM,
+					   "ID3D11Device::CreateShaderResourceView failed!");
+		return nullptr;
+	}
+	return pView;
+}
+
+static bool
+FmGui::RendererUpdateTexture(void *pTexture, unsigned int y,
+							 unsigned int height, const std::uint32_t *pPixels,
+							 void *pUserData)
+{
+	if (!pTexture || !pPixels || height == 0)
+		return false;
+	ID3D11ShaderResourceView *pView =
+		static_cast<ID3D11ShaderResourceView *>(pTexture);
+	ID3D11Resource *pResource = nullptr;
+	pView->GetResource(&pResource);
+	D3D11_TEXTURE2D_DESC textureDesc;
+	static_cast<ID3D11Texture2D *>(pResource)->GetDesc(&textureDesc);
+	bool isUpdated = false;
+	if (y < textureDesc.Height && height <= textureDesc.Height - y) {
+		const D3D11_BOX box = { 0, y, 0, textureDesc.Width, y + height, 1 };
+		pDeviceContext->UpdateSubresource(pResource, 0, &box, pPixels,
+			static_cast<UINT>(textureDesc.Width * sizeof(std::uint32_t)), 0);
+		isUpdated = true;
+	}
+	ReleaseCOM(pResource);
+	return isUpdated;
+}
+
+static void
+FmGui::RendererDestroyTexture(void *pTexture, void *pUserData)
+{
+	ID3D11ShaderResourceView *pView =
+		static_cast<ID3D11ShaderResourceView *>(pTexture);
+	ReleaseCOM(pView);
 }
 
 static HRESULT
@@ -578,7 +799,7 @@ FmGui::GetDeviceContext(IDXGISwapChain *const pSwapChain,
 	ID3D11Device **ppDevice, ID3D11DeviceContext **ppDeviceContext)
 {
 	(*ppDevice)->GetImmediateContext(ppDeviceContext);
-	return (ppDeviceContext != nullptr) ? S_OK : E_FAIL;
+	return (*ppDeviceContext != nullptr) ? S_OK : E_FAIL;
 }
 
 bool
@@ -587,14 +808,16 @@ FmGui::ShutdownHook(void)
 	// Reverse order of initialization.
 	MH_STATUS mhStatus = MH_DisableHook(MH_ALL_HOOKS);
 	if (mhStatus != MH_OK) {
-		PUSH_MSG(FmGuiMessageSeverity::HIGH, "MH_DisableHook failed: "
-				 + MinHookStatusToStdString(mhStatus) + '!');
+		FMGUI_PUSH_MSGF(FmGuiMessageSeverity::HIGH,
+						"MH_DisableHook failed: %s!",
+						MH_StatusToString(mhStatus));
 		return false;
 	}
 	mhStatus = MH_Uninitialize();
 	if (mhStatus != MH_OK) {
-		PUSH_MSG(FmGuiMessageSeverity::HIGH, "MH_Uninitialize failed: "
-				 + MinHookStatusToStdString(mhStatus) + '!');
+		FMGUI_PUSH_MSGF(FmGuiMessageSeverity::HIGH,
+						"MH_Uninitialize failed: %s!",
+						MH_StatusToString(mhStatus));
 		return false;
 	}
 
@@ -607,52 +830,30 @@ FmGui::ShutdownHook(void)
 		ImGui_ImplWin32_Shutdown();
 		isImGuiImplWin32Initialized = false;
 	}
+	mouseCursor.store(ImGuiMouseCursor_COUNT, std::memory_order_relaxed);
+	hasLastFrameTime = false;
 
-#if defined FMGUI_ENABLE_IMPLOT
-	if (pImPlotContext != nullptr) {
-		ImPlot::DestroyContext(pImPlotContext);
-	}
-#endif
-	
-	if (pImGuiContext != nullptr) {
-		ImGui::DestroyContext(pImGuiContext);
-		pImGuiContext = nullptr;
-	}
+	Core::Shutdown();
 
 	ReleaseCOM(pDevice);
 	ReleaseCOM(pDeviceContext);
 	ReleaseCOM(pRenderTargetView);
-	if (hWnd) {
+	if (hWnd && pWndProcApp) {
 		// Set hWnd's WndProc back to it's original proc.
 		if (SetWindowLongPtr(hWnd, GWLP_WNDPROC,
 			reinterpret_cast<LONG_PTR>(pWndProcApp)) == 0) {
-			PUSH_MSG(FmGuiMessageSeverity::HIGH, "SetWindowLongPtr failed!");
+			FMGUI_PUSH_MSG(FmGuiMessageSeverity::HIGH,
+						   "SetWindowLongPtr failed!");
 			return false;
 		}
 	}
-	// Set the Present initialization check to false.
-	isInitialized = false;
+	// Reset the initialization progress for the next StartupHook.
+	hWnd = nullptr;
+	pWndProcApp = nullptr;
+	pCurrentSwapChain = nullptr;
 	return true;
 }
 
-const FmGuiMessage &
-FmGui::GetLastError(void)
-{
-	return messageStack.top();
-}
-
-std::vector<FmGuiMessage>
-FmGui::GetEveryMessage(void)
-{
-	std::vector<FmGuiMessage> errorMessages;
-	while (!messageStack.empty()) {
-		errorMessages.push_back(messageStack.top());
-		messageStack.pop();
-	}
-	std::reverse(std::begin(errorMessages), std::end(errorMessages));
-	return errorMessages; // Hope for return value optimization.
-}
-
 static void
 FmGui::OnResize(IDXGISwapChain *pSwapChain, UINT newWidth, UINT newHeight)
 {
@@ -671,7 +872,8 @@ FmGui::OnResize(IDXGISwapChain *pSwapChain, UINT newWidth, UINT newHeight)
 	DXGI_SWAP_CHAIN_DESC swapChainDesc;
 	ZeroMemory(&swapChainDesc, sizeof(swapChainDesc));
 	if (FAILED(pSwapChain->GetDesc(&swapChainDesc))) {
-		PUSH_MSG(FmGuiMessageSeverity::HIGH, "IDXGISwapChain::GetDesc failed!");
+		FMGUI_PUSH_MSG(FmGuiMessageSeverity::HIGH,
+					   "IDXGISwapChain::GetDesc failed!");
 		return;
 	}
 	
@@ -679,16 +881,16 @@ FmGui::OnResize(IDXGISwapChain *pSwapChain, UINT newWidth, UINT newHeight)
 		swapChainDesc.BufferCount,
 		newWidth, newHeight,
 		swapChainDesc.BufferDesc.Format, 0u))) {
-		PUSH_MSG(FmGuiMessageSeverity::HIGH,
-				 "IDXGISwapChain::ResizeBuffers failed!");
+		FMGUI_PUSH_MSG(FmGuiMessageSeverity::HIGH,
+					   "IDXGISwapChain::ResizeBuffers failed!");
 		return;
 	}
 
 	ID3D11Texture2D *pSwapChainBackBuffer = nullptr;
 	if (FAILED(pSwapChain->GetBuffer(0u, __uuidof(ID3D11Texture2D),
 		reinterpret_cast<void **>(&pSwapChainBackBuffer)))) {
-		PUSH_MSG(FmGuiMessageSeverity::HIGH,
-				 "IDXGISwapChain::GetBuffer failed!");
+		FMGUI_PUSH_MSG(FmGuiMessageSeverity::HIGH,
+					   "IDXGISwapChain::GetBuffer failed!");
 		ReleaseCOM(pSwapChainBackBuffer);
 		return;
 	}
@@ -696,8 +898,8 @@ FmGui::OnResize(IDXGISwapChain *pSwapChain, UINT newWidth, UINT newHeight)
 	if (FAILED(pDevice->CreateRenderTargetView(
 		pSwapChainBackBuffer, nullptr,
 		&pRenderTargetView))) {
-		PUSH_MSG(FmGuiMessageSeverity::HIGH,
-				 "ID3D11Device::CreateRenderTargetView failed!");
+		FMGUI_PUSH_MSG(FmGuiMessageSeverity::HIGH,
+					   "ID3D11Device::CreateRenderTargetView failed!");
 		ReleaseCOM(pSwapChainBackBuffer);
 		return;
 	}
@@ -708,28 +910,26 @@ FmGui::OnResize(IDXGISwapChain *pSwapChain, UINT newWidth, UINT newHeight)
 	pDeviceContext->RSSetViewports(1, &viewport);
 }
 
+/*
+ * Runs on the window thread of DCS: World. ImGuiIO belongs to the render
+ * thread, so messages are only translated into queued input events here,
+ * which FmGui::Core::Frame applies before the next frame.
+ */
 static LRESULT
 FmGui::WndProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
 {
-	// Check if there is a valid context.
-	if (ImGui::GetCurrentContext()) {
-		ImGuiIO &imGuiIO = ImGui::GetIO();
-		POINT cursorPos; GetCursorPos(&cursorPos);
-		if (FmGui::hWnd)
-			ScreenToClient(FmGui::hWnd, &cursorPos);
-		imGuiIO.MousePos.x = cursorPos.x;
-		imGuiIO.MousePos.y = cursorPos.y;
-	}
 	// Only handle if widgets are enabled.
-	if (areWidgetsEnabled) {
-		// Check for a non-NULL context and handle ImGui events.
-		if (ImGui::GetCurrentContext()
-			&& ImGui_ImplWin32_WndProcHandler(hWnd, uMsg, wParam, lParam)) {
+	if (Core::AreWidgetsEnabled()) {
+		PushInputEvents(hWnd, uMsg, wParam, lParam);
+		// Handle user's non-NULL input routine on the render thread.
+		if (pInputRoutine != nullptr) {
+			const InputMessage inputMessage = { uMsg, wParam, lParam };
+			inputMessages.Publish(inputMessage);
+		}
+		if (uMsg == WM_SETCURSOR && LOWORD(lParam) == HTCLIENT
+			&& SetMouseCursor()) {
 			return TRUE;
 		}
-		// Handle user's non-NULL input routine.
-		if (pInputRoutine != nullptr)
-			pInputRoutine(uMsg, wParam, lParam);
 	}
 	// Other events.
 	switch (uMsg) {
@@ -744,15 +944,233 @@ FmGui::WndProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
 	return CallWindowProc(pWndProcApp, hWnd, uMsg, wParam, lParam);
 }
 
+static void
+FmGui::PushInputEvents(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
+{
+	FmGuiInputEvent event = FmGuiInputEvent();
+	switch (uMsg) {
+	case WM_MOUSEMOVE:
+		// Ask for WM_MOUSELEAVE once the mouse leaves the window.
+		if (!isMouseTracked) {
+			TRACKMOUSEEVENT trackMouseEvent = {
+				sizeof(trackMouseEvent), TME_LEAVE, hWnd, 0
+			};
+			isMouseTracked = TrackMouseEvent(&trackMouseEvent) != FALSE;
+		}
+		Input::PushMousePos(static_cast<float>(GET_X_LPARAM(lParam)),
+							static_cast<float>(GET_Y_LPARAM(lParam)));
+		break;
+	case WM_MOUSELEAVE:
+		isMouseTracked = false;
+		Input::PushMousePos(-FLT_MAX, -FLT_MAX);
+		break;
+	case WM_MOUSEWHEEL:
+	case WM_MOUSEHWHEEL: {
+		const float steps = static_cast<float>(GET_WHEEL_DELTA_WPARAM(wParam))
+			/ static_cast<float>(WHEEL_DELTA);
+		event.type = FmGuiInputEventType::MOUSE_WHEEL;
+		event.x = (uMsg == WM_MOUSEHWHEEL) ? steps : 0.0f;
+		event.y = (uMsg == WM_MOUSEWHEEL) ? steps : 0.0f;
+		Input::PushEvent(event);
+		break;
+	}
+	case WM_KEYDOWN:
+	case WM_KEYUP:
+	case WM_SYSKEYDOWN:
+	case WM_SYSKEYUP:
+		PushKeyEvent(uMsg, wParam, lParam);
+		break;
+	case WM_CHAR:
+		if (wParam == 0 || wParam >= 0x10000)
+			break;
+		event.type = FmGuiInputEventType::CHARACTER;
+		if (IsWindowUnicode(hWnd)) {
+			event.code = static_cast<std::uint16_t>(wParam);
+		} else {
+			const char character = static_cast<char>(wParam);
+			wchar_t wideCharacter = 0;
+			MultiByteToWideChar(CP_ACP, MB_PRECOMPOSED, &character, 1,
+								&wideCharacter, 1);
+			event.code = static_cast<std::uint16_t>(wideCharacter);
+		}
+		Input::PushEvent(event);
+		break;
+	case WM_SETFOCUS:
+	case WM_KILLFOCUS:
+		event.type = FmGuiInputEventType::FOCUS;
+		event.isDown = uMsg == WM_SETFOCUS;
+		Input::PushEvent(event);
+		break;
+	default:
+		PushMouseButtonEvent(hWnd, uMsg, wParam, lParam);
+		break;
+	}
+}
+
 /*
- * FmGuiConfig's members need be defined where imgui/imgui.h is included. 
+ * Returns false if uMsg is not a mouse button message. Like the ImGui Win32
+ * backend, the mouse is captured while a button is held.
  */
-FmGuiConfig::FmGuiConfig(void)
-	: imGuiStyle(FmGuiStyle::DARK),
-	  imGuiConfigFlags(
-		  static_cast<ImGuiConfigFlags>(ImGuiConfigFlags_NavNoCaptureKeyboard)
-	  ),
-	  imGuiIniFileName(),
-	  imGuiIniSavingRate(5.0f)
+static bool
+FmGui::PushMouseButtonEvent(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
 {
+	FmGuiInputEvent event = FmGuiInputEvent();
+	event.type = FmGuiInputEventType::MOUSE_BUTTON;
+	switch (uMsg) {
+	case WM_LBUTTONDOWN: case WM_LBUTTONDBLCLK:
+		event.isDown = true;
+		// Fall through.
+	case WM_LBUTTONUP:
+		event.code = 0;
+		break;
+	case WM_RBUTTONDOWN: case WM_RBUTTONDBLCLK:
+		event.isDown = true;
+		// Fall through.
+	case WM_RBUTTONUP:
+		event.code = 1;
+		break;
+	case WM_MBUTTONDOWN: case WM_MBUTTONDBLCLK:
+		event.isDown = true;
+		// Fall through.
+	case WM_MBUTTONUP:
+		event.code = 2;
+		break;
+	case WM_XBUTTONDOWN: case WM_XBUTTONDBLCLK:
+		event.isDown = true;
+		// Fall through.
+	case WM_XBUTTONUP:
+		event.code = (GET_XBUTTON_WPARAM(wParam) == XBUTTON1) ? 3 : 4;
+		break;
+	default:
+		return false;
+	}
+	if (event.isDown) {
+		if (pressedMouseButtons == 0 && GetCapture() == nullptr)
+			SetCapture(hWnd);
+		pressedMouseButtons |= 1u << event.code;
+	} else {
+		pressedMouseButtons &= ~(1u << event.code);
+		if (pressedMouseButtons == 0 && GetCapture() == hWnd)
+			ReleaseCapture();
+	}
+	// The click position, which the queue places ahead of the button.
+	Input::PushMousePos(static_cast<float>(GET_X_LPARAM(lParam)),
+						static_cast<float>(GET_Y_LPARAM(lParam)));
+	Input::PushEvent(event);
+	return true;
+}
+
+static void
+FmGui::PushKeyEvent(UINT uMsg, WPARAM wParam, LPARAM lParam)
+{
+	if (wParam >= 256)
+		return;
+	const bool isKeyDown = (uMsg == WM_KEYDOWN || uMsg == WM_SYSKEYDOWN);
+	const bool isExtended = (HIWORD(lParam) & KF_EXTENDED) != 0;
+	FmGuiInputEvent event = FmGuiInputEvent();
+	// The modifiers as of this message, read on the thread it belongs to.
+	ImGuiKeyModFlags keyMods = ImGuiKeyModFlags_None;
+	if (GetKeyState(VK_CONTROL) & 0x8000)
+		keyMods |= ImGuiKeyModFlags_Ctrl;
+	if (GetKeyState(VK_SHIFT) & 0x8000)
+		keyMods |= ImGuiKeyModFlags_Shift;
+	if (GetKeyState(VK_MENU) & 0x8000)
+		keyMods |= ImGuiKeyModFlags_Alt;
+	if ((GetKeyState(VK_LWIN) | GetKeyState(VK_RWIN)) & 0x8000)
+		keyMods |= ImGuiKeyModFlags_Super;
+	event.type = FmGuiInputEventType::KEY_MODS;
+	event.code = static_cast<std::uint16_t>(keyMods);
+	Input::PushEvent(event);
+
+	// Tell the left and right modifiers and the keypad enter key apart.
+	WPARAM virtualKey = wParam;
+	if (virtualKey == VK_SHIFT) {
+		virtualKey = MapVirtualKey((lParam >> 16) & 0xFF, MAPVK_VSC_TO_VK_EX);
+	} else if (virtualKey == VK_CONTROL) {
+		virtualKey = isExtended ? VK_RCONTROL : VK_LCONTROL;
+	} else if (virtualKey == VK_MENU) {
+		virtualKey = isExtended ? VK_RMENU : VK_LMENU;
+	}
+	ImGuiKey key = VirtualKeyToImGuiKey(virtualKey);
+	if (virtualKey == VK_RETURN && isExtended)
+		key = ImGuiKey_KeypadEnter;
+	if (key == ImGuiKey_None)
+		return;
+	event.type = FmGuiInputEventType::KEY;
+	event.isDown = isKeyDown;
+	event.code = static_cast<std::uint16_t>(key);
+	event.nativeCode = static_cast<std::uint16_t>(wParam);
+	Input::PushEvent(event);
+}
+
+static ImGuiKey
+FmGui::VirtualKeyToImGuiKey(WPARAM virtualKey)
+{
+	if (virtualKey >= '0' && virtualKey <= '9')
+		return static_cast<ImGuiKey>(ImGuiKey_0 + (virtualKey - '0'));
+	if (virtualKey >= 'A' && virtualKey <= 'Z')
+		return static_cast<ImGuiKey>(ImGuiKey_A + (virtualKey - 'A'));
+	if (virtualKey >= VK_F1 && virtualKey <= VK_F12)
+		return static_cast<ImGuiKey>(ImGuiKey_F1 + (virtualKey - VK_F1));
+	if (virtualKey >= VK_NUMPAD0 && virtualKey <= VK_NUMPAD9) {
+		return static_cast<ImGuiKey>(ImGuiKey_Keypad0
+			+ (virtualKey - VK_NUMPAD0));
+	}
+	switch (virtualKey) {
+	case VK_TAB: return ImGuiKey_Tab;
+	case VK_LEFT: return ImGuiKey_LeftArrow;
+	case VK_RIGHT: return ImGuiKey_RightArrow;
+	case VK_UP: return ImGuiKey_UpArrow;
+	case VK_DOWN: return ImGuiKey_DownArrow;
+	case VK_PRIOR: return ImGuiKey_PageUp;
+	case VK_NEXT: return ImGuiKey_PageDown;
+	case VK_HOME: return ImGuiKey_Home;
+	case VK_END: return ImGuiKey_End;
+	case VK_INSERT: return ImGuiKey_Insert;
+	case VK_DELETE: return ImGuiKey_Delete;
+	case VK_BACK: return ImGuiKey_Backspace;
+	case VK_SPACE: return ImGuiKey_Space;
+	case VK_RETURN: return ImGuiKey_Enter;
+	case VK_ESCAPE: return ImGuiKey_Escape;
+	case VK_OEM_7: return ImGuiKey_Apostrophe;
+	case VK_OEM_COMMA: return ImGuiKey_Comma;
+	case VK_OEM_MINUS: return ImGuiKey_Minus;
+	case VK_OEM_PERIOD: return ImGuiKey_Period;
+	case VK_OEM_2: return ImGuiKey_Slash;
+	case VK_OEM_1: return ImGuiKey_Semicolon;
+	case VK_OEM_PLUS: return ImGuiKey_Equal;
+	case VK_OEM_4: return ImGuiKey_LeftBracket;
+	case VK_OEM_5: return ImGuiKey_Backslash;
+	case VK_OEM_6: return ImGuiKey_RightBracket;
+	case VK_OEM_3: return ImGuiKey_GraveAccent;
+	case VK_CAPITAL: return ImGuiKey_CapsLock;
+	case VK_SCROLL: return ImGuiKey_ScrollLock;
+	case VK_NUMLOCK: return ImGuiKey_NumLock;
+	case VK_SNAPSHOT: return ImGuiKey_PrintScreen;
+	case VK_PAUSE: return ImGuiKey_Pause;
+	case VK_DECIMAL: return ImGuiKey_KeypadDecimal;
+	case VK_DIVIDE: return ImGuiKey_KeypadDivide;
+	case VK_MULTIPLY: return ImGuiKey_KeypadMultiply;
+	case VK_SUBTRACT: return ImGuiKey_KeypadSubtract;
+	case VK_ADD: return ImGuiKey_KeypadAdd;
+	case VK_LSHIFT: return ImGuiKey_LeftShift;
+	case VK_LCONTROL: return ImGuiKey_LeftCtrl;
+	case VK_LMENU: return ImGuiKey_LeftAlt;
+	case VK_LWIN: return ImGuiKey_LeftSuper;
+	case VK_RSHIFT: return ImGuiKey_RightShift;
+	case VK_RCONTROL: return ImGuiKey_RightCtrl;
+	case VK_RMENU: return ImGuiKey_RightAlt;
+	case VK_RWIN: return ImGuiKey_RightSuper;
+	case VK_APPS: return ImGuiKey_Menu;
+	default: return ImGuiKey_None;
+	}
+}
+
+static void
+FmGui::CallInputRoutine(const InputMessage &inputMessage)
+{
+	if (pInputRoutine != nullptr) {
+		pInputRoutine(inputMessage.uMsg, inputMessage.wParam,
+					  inputMessage.lParam);
+	}
 }
@@ -0,0 +1,442 @@
+/* =============================================================================
+** DCS-EFM-ImGui, file: FmGuiAllocator.cpp Created: 17-OCT-2026
+**
+** Copyright 2022 Brian Hoffpauir, USA
+** All rights reserved.
+**
+** Redistribution and use of this source file, with or without modification, is
+** permitted provided that the following conditions are met:
+**
+** 1. Redistributions of this source file must retain the above copyright
+**    notice, this list of conditions and the following disclaimer.
+**
+** 2. Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and/or other materials provided with the distribution.
+**
+** THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+** WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO
+** EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+** PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+** OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+** WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+** OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+** ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+** =============================================================================
+**/
+#include "FmGuiAllocator.hpp"
+#include "FmGuiCore.hpp"
+
+#include <cstring>
+#include <algorithm>
+#include <atomic>
+
+#if defined _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+#include <imgui.h>
+
+namespace FmGui
+{
+namespace Allocator
+{
+/*
+ * Each mapping starts with this header, linking the mappings for release. It
+ * is counted in the mapping's size, which stays a multiple of the 64 KiB
+ * VirtualAlloc granularity.
+ */
+struct Mapping
+{
+	Mapping *pNext;
+	std::size_t size;
+};
+struct FreeBlock
+{
+	FreeBlock *pNext;
+};
+// Functions
+static void *MapMemory(std::size_t size);
+static void UnmapMemory(void *pMemory, std::size_t size);
+static unsigned char *MapBlocks(std::size_t size);
+static unsigned char *AllocateBlock(std::size_t requiredSize,
+									std::size_t &classIndex);
+static void Lock(void);
+static void Unlock(void);
+static void ReleasePools(void);
+// Variables
+/*
+ * Every block starts with a 16 byte header holding a magic number, the class
+ * index and the requested size, which keeps the payload 16 byte aligned.
+ */
+static constexpr std::size_t headerSize = 16;
+static constexpr std::size_t mappingHeaderSize = 16;
+static_assert(sizeof(Mapping) <= mappingHeaderSize, "Mapping header too big.");
+static constexpr std::uint32_t liveMagic = 0xF6A110C8;
+static constexpr std::uint32_t freeMagic = 0xF6A1F4EE;
+static constexpr std::size_t slabSize = 256 * 1024;
+// Block sizes, including the header, about 25 % apart.
+static constexpr std::size_t smallClassSizes[] = {
+	32, 48, 64, 80, 96, 128, 160, 192, 256, 320, 384, 512, 640, 768, 1024,
+	1280, 1536, 2048, 2560, 3072, 4096, 5120, 6144, 8192, 10240, 12288, 16384,
+	20480, 24576, 32768
+};
+static constexpr std::size_t smallClassCount =
+	sizeof(smallClassSizes) / sizeof(smallClassSizes[0]);
+// Larger blocks are mappings of a power of two from 64 KiB, which hold the
+// mapping header and the block header.
+static constexpr std::size_t largeClassMinimum = 64 * 1024;
+static constexpr std::size_t largeClassCount = 24;
+static constexpr std::size_t classCount = smallClassCount + largeClassCount;
+// Class index of blocks from the previous allocator, when not using the pools.
+static constexpr std::size_t systemClass = classCount;
+static std::atomic_flag lockFlag = ATOMIC_FLAG_INIT;
+static FreeBlock *freeLists[classCount] = {};
+static unsigned char *slabCursors[smallClassCount] = {};
+static unsigned char *slabEnds[smallClassCount] = {};
+static Mapping *pMappings = nullptr;
+static bool isInstalled = false, arePoolsUsed = true;
+// Uninstall was called with live allocations, Free releases the pools once
+// the last one is freed.
+static bool isReleasePending = false;
+static ImGuiMemAllocFunc pPreviousAllocate = nullptr;
+static ImGuiMemFreeFunc pPreviousFree = nullptr;
+static void *pPreviousUserData = nullptr;
+// Statistics, guarded by the lock.
+static FmGuiAllocatorStats stats = {};
+static std::uint64_t frameStartAllocationCount = 0;
+// Every allocation counted, including the external ones.
+static std::atomic<std::uint64_t> allocationCount(0);
+// Frame arena, render thread only apart from the published statistics.
+static unsigned char *pFrameArena = nullptr;
+static std::size_t frameArenaSize = 0, frameArenaUsed = 0;
+static std::atomic<std::size_t> frameArenaLastBytes(0), frameArenaPeakBytes(0);
+static std::atomic<std::uint64_t> frameArenaOverflowCount(0);
+} // namespace Allocator
+} // namespace FmGui
+
+static void *
+FmGui::Allocator::MapMemory(std::size_t size)
+{
+#if defined _WIN32
+	return VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT,
+						PAGE_READWRITE);
+#else
+	void *pMemory = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+						 MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	return (pMemory != MAP_FAILED) ? pMemory : nullptr;
+#endif
+}
+
+static void
+FmGui::Allocator::UnmapMemory(void *pMemory, std::size_t size)
+{
+#if defined _WIN32
+	VirtualFree(pMemory, 0, MEM_RELEASE);
+#else
+	munmap(pMemory, size);
+#endif
+}
+
+/*
+ * Maps size bytes and returns the blocks behind the mapping header, size -
+ * mappingHeaderSize bytes of them. Called with the lock held.
+ */
+static unsigned char *
+FmGui::Allocator::MapBlocks(std::size_t size)
+{
+	Mapping *pMapping = static_cast<Mapping *>(MapMemory(size));
+	if (pMapping == nullptr)
+		return nullptr;
+	pMapping->pNext = pMappings;
+	pMapping->size = size;
+	pMappings = pMapping;
+	stats.reservedBytes += size;
+	++stats.systemAllocationCount;
+	return reinterpret_cast<unsigned char *>(pMapping) + mappingHeaderSize;
+}
+
+static void
+FmGui::Allocator::Lock(void)
+{
+	while (lockFlag.test_and_set(std::memory_order_acquire))
+		;
+}
+
+static void
+FmGui::Allocator::Unlock(void)
+{
+	lockFlag.clear(std::memory_order_release);
+}
+
+/*
+ * Takes a block of at least requiredSize bytes from its pool. Called with the
+ * lock held.
+ */
+static unsigned char *
+FmGui::Allocator::AllocateBlock(std::size_t requiredSize,
+								std::size_t &classIndex)
+{
+	std::size_t blockSize;
+	if (requiredSize <= smallClassSizes[smallClassCount - 1]) {
+		classIndex = static_cast<std::size_t>(
+			std::lower_bound(smallClassSizes,
+							 smallClassSizes + smallClassCount, requiredSize)
+			- smallClassSizes);
+		blockSize = smallClassSizes[classIndex];
+	} else {
+		// Large blocks are whole mappings, so the class is the mapping size.
+		requiredSize += mappingHeaderSize;
+		classIndex = smallClassCount;
+		blockSize = largeClassMinimum;
+		while (blockSize < requiredSize && classIndex + 1 < classCount) {
+			blockSize *= 2;
+			++classIndex;
+		}
+		if (blockSize < requiredSize)
+			return nullptr;
+	}
+
+	unsigned char *pBlock = nullptr;
+	if (freeLists[classIndex] != nullptr) {
+		pBlock = reinterpret_cast<unsigned char *>(freeLists[classIndex]);
+		freeLists[classIndex] = freeLists[classIndex]->pNext;
+	} else if (classIndex < smallClassCount) {
+		if (slabCursors[classIndex] == nullptr
+			|| slabEnds[classIndex] - slabCursors[classIndex]
+			   < static_cast<std::ptrdiff_t>(blockSize)) {
+			// The rest of the previous slab is left unused.
+			unsigned char *pSlab = MapBlocks(slabSize);
+			if (pSlab != nullptr) {
+				slabCursors[classIndex] = pSlab;
+				slabEnds[classIndex] = pSlab + slabSize - mappingHeaderSize;
+			}
+		}
+		if (slabEnds[classIndex] - slabCursors[classIndex]
+			>= static_cast<std::ptrdiff_t>(blockSize)) {
+			pBlock = slabCursors[classIndex];
+			slabCursors[classIndex] += blockSize;
+		}
+	} else {
+		pBlock = MapBlocks(blockSize);
+	}
+	return pBlock;
+}
+
+void *
+FmGui::Allocator::Allocate(std::size_t size, void *pUserData)
+{
+	std::size_t classIndex = systemClass;
+	unsigned char *pBlock = nullptr;
+	if (!arePoolsUsed) {
+		pBlock = static_cast<unsigned char *>(
+			pPreviousAllocate(size + headerSize, pPreviousUserData));
+	}
+	Lock();
+	if (arePoolsUsed)
+		pBlock = AllocateBlock(size + headerSize, classIndex);
+	if (pBlock == nullptr) {
+		Unlock();
+		return nullptr;
+	}
+	const std::uint32_t header[2] = {
+		liveMagic, static_cast<std::uint32_t>(classIndex)
+	};
+	std::memcpy(pBlock, header, sizeof(header));
+	std::memcpy(pBlock + sizeof(header), &size, sizeof(size));
+	stats.liveBytes += size;
+	stats.peakLiveBytes = std::max(stats.peakLiveBytes, stats.liveBytes);
+	++stats.liveAllocationCount;
+	++stats.totalAllocationCount;
+	Unlock();
+	allocationCount.fetch_add(1, std::memory_order_relaxed);
+	return pBlock + headerSize;
+}
+
+void
+FmGui::Allocator::Free(void *pBlock, void *pUserData)
+{
+	if (pBlock == nullptr)
+		return;
+	unsigned char *pHeader = static_cast<unsigned char *>(pBlock) - headerSize;
+	std::uint32_t header[2];
+	std::size_t size;
+	std::memcpy(header, pHeader, sizeof(header));
+	std::memcpy(&size, pHeader + sizeof(header), sizeof(size));
+	if (header[0] != liveMagic || header[1] > systemClass) {
+		FMGUI_PUSH_MSG(FmGuiMessageSeverity::HIGH,
+					   "Freed a block that is not a live FmGui allocation!");
+		return;
+	}
+	header[0] = freeMagic;
+	std::memcpy(pHeader, header, sizeof(header[0]));
+
+	Lock();
+	stats.liveBytes -= size;
+	--stats.liveAllocationCount;
+	if (header[1] != systemClass) {
+		FreeBlock *pFreeBlock = reinterpret_cast<FreeBlock *>(pHeader);
+		pFreeBlock->pNext = freeLists[header[1]];
+		freeLists[header[1]] = pFreeBlock;
+	}
+	const ImGuiMemFreeFunc pSystemFree = pPreviousFree;
+	void *const pSystemUserData = pPreviousUserData;
+	if (isReleasePending && stats.liveAllocationCount == 0)
+		ReleasePools();
+	Unlock();
+	if (header[1] == systemClass)
+		pSystemFree(pHeader, pSystemUserData);
+}
+
+void
+FmGui::Allocator::CountExternalAllocation(void)
+{
+	allocationCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+std::uint64_t
+FmGui::Allocator::GetAllocationCount(void)
+{
+	return allocationCount.load(std::memory_order_relaxed);
+}
+
+void *
+FmGui::Allocator::AllocateFrame(std::size_t size)
+{
+	const std::size_t alignedSize = (size + 15) & ~static_cast<std::size_t>(15);
+	if (pFrameArena == nullptr
+		|| alignedSize > frameArenaSize - frameArenaUsed) {
+		frameArenaOverflowCount.fetch_add(1, std::memory_order_relaxed);
+		return nullptr;
+	}
+	void *pMemory = pFrameArena + frameArenaUsed;
+	frameArenaUsed += alignedSize;
+	return pMemory;
+}
+
+FmGuiAllocatorStats
+FmGui::Allocator::GetStats(void)
+{
+	Lock();
+	FmGuiAllocatorStats result = stats;
+	Unlock();
+	result.frameArenaBytes =
+		frameArenaLastBytes.load(std::memory_order_relaxed);
+	result.frameArenaPeakBytes =
+		frameArenaPeakBytes.load(std::memory_order_relaxed);
+	result.frameArenaOverflowCount =
+		frameArenaOverflowCount.load(std::memory_order_relaxed);
+	return result;
+}
+
+bool
+FmGui::Allocator::Initialize(std::size_t frameArenaSize)
+{
+	if (pFrameArena != nullptr && Allocator::frameArenaSize == frameArenaSize)
+		return true;
+	Shutdown();
+	if (frameArenaSize == 0)
+		return true;
+	pFrameArena = static_cast<unsigned char *>(MapMemory(frameArenaSize));
+	if (pFrameArena == nullptr) {
+		FMGUI_PUSH_MSGF(FmGuiMessageSeverity::HIGH,
+						"Failed to map a frame arena of %u bytes!",
+						static_cast<unsigned int>(frameArenaSize));
+		return false;
+	}
+	Allocator::frameArenaSize = frameArenaSize;
+	frameArenaUsed = 0;
+	return true;
+}
+
+void
+FmGui::Allocator::Install(bool usePools)
+{
+	Lock();
+	// A pending release is called off, the live blocks keep their pools.
+	isReleasePending = false;
+	const bool wasInstalled = isInstalled;
+	isInstalled = true;
+	Unlock();
+	if (wasInstalled)
+		return;
+	ImGui::GetAllocatorFunctions(&pPreviousAllocate, &pPreviousFree,
+								 &pPreviousUserData);
+	ImGui::SetAllocatorFunctions(Allocate, Free, nullptr);
+	arePoolsUsed = usePools;
+}
+
+void
+FmGui::Allocator::Uninstall(void)
+{
+	Lock();
+	if (!isInstalled || isReleasePending) {
+		Unlock();
+		return;
+	}
+	if (stats.liveAllocationCount != 0) {
+		// Something still points into the pools, so Free stays installed
+		// and releases them once the last allocation is freed.
+		isReleasePending = true;
+		const unsigned int liveAllocationCount =
+			static_cast<unsigned int>(stats.liveAllocationCount);
+		Unlock();
+		FMGUI_PUSH_MSGF(FmGuiMessageSeverity::MEDIUM,
+						"%u allocations outlived the ImGui context.",
+						liveAllocationCount);
+		return;
+	}
+	ReleasePools();
+	Unlock();
+}
+
+/*
+ * Restores the previous ImGui allocator and gives the pools' memory back to
+ * the system. Called with the lock held and no live allocations.
+ */
+static void
+FmGui::Allocator::ReleasePools(void)
+{
+	ImGui::SetAllocatorFunctions(pPreviousAllocate, pPreviousFree,
+								 pPreviousUserData);
+	isInstalled = false;
+	isReleasePending = false;
+	arePoolsUsed = true;
+	while (pMappings != nullptr) {
+		Mapping *pNext = pMappings->pNext;
+		UnmapMemory(pMappings, pMappings->size);
+		pMappings = pNext;
+	}
+	std::fill(freeLists, freeLists + classCount, nullptr);
+	std::fill(slabCursors, slabCursors + smallClassCount, nullptr);
+	std::fill(slabEnds, slabEnds + smallClassCount, nullptr);
+	stats.reservedBytes = 0;
+}
+
+void
+FmGui::Allocator::BeginFrame(void)
+{
+	const std::uint64_t count = allocationCount.load(std::memory_order_relaxed);
+	Lock();
+	stats.frameAllocationCount = count - frameStartAllocationCount;
+	Unlock();
+	frameStartAllocationCount = count;
+	frameArenaLastBytes.store(frameArenaUsed, std::memory_order_relaxed);
+	if (frameArenaUsed > frameArenaPeakBytes.load(std::memory_order_relaxed))
+		frameArenaPeakBytes.store(frameArenaUsed, std::memory_order_relaxed);
+	frameArenaUsed = 0;
+}
+
+void
+FmGui::Allocator::Shutdown(void)
+{
+	if (pFrameArena != nullptr)
+		UnmapMemory(pFrameArena, frameArenaSize);
+	pFrameArena = nullptr;
+	frameArenaSize = frameArenaUsed = 0;
+}
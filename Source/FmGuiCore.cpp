@@ -0,0 +1,959 @@
+/* =============================================================================
+** DCS-EFM-ImGui, file: FmGuiCore.cpp Created: 17-OCT-2026
+**
+** Copyright 2022 Brian Hoffpauir, USA
+** All rights reserved.
+**
+** Redistribution and use of this source file, with or without modification, is
+** permitted provided that the following conditions are met:
+**
+** 1. Redistributions of this source file must retain the above copyright
+**    notice, this list of conditions and the following disclaimer.
+**
+** 2. Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and/or other materials provided with the distribution.
+**
+** THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+** WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO
+** EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+** PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+** OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+** WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+** OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+** ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+** =============================================================================
+**/
+#include "FmGuiCore.hpp"
+#include "FmGuiProfiler.hpp"
+#include "FmGuiInput.hpp"
+#include "FmGuiAllocator.hpp"
+#include "FmGuiPanels.hpp"
+
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+
+/* ImGui Headers here: */
+#include <imgui.h>
+
+#if defined FMGUI_ENABLE_IMPLOT
+#include <implot.h>
+#endif
+
+namespace FmGui
+{
+struct MessageSlot
+{
+	/*
+	 * Zero while never written, 2 * index + 1 while the message with that
+	 * ring index is being written and 2 * index + 2 once it is complete.
+	 */
+	std::atomic<std::uint64_t> sequence;
+	FmGuiMessage message;
+};
+// Functions
+static bool ClaimMessageSlot(MessageSlot &slot, std::uint64_t index);
+static bool ReadMessageSlot(std::uint64_t index, FmGuiMessage &message);
+// Variables
+static constexpr std::size_t messageRingSize = 64; // Must be a power of two.
+static MessageSlot messageRing[messageRingSize];
+// Index of the next message to be pushed.
+static std::atomic<std::uint64_t> messageRingHead(0);
+static std::atomic<std::uint64_t> droppedMessageCount(0);
+static std::atomic<FmGuiMessageCallback> pMessageCallback(nullptr);
+
+namespace Core
+{
+/*
+ * Adds the time spent in its scope to the given stage of the current frame.
+ */
+class ScopedStageTimer
+{
+public:
+	explicit ScopedStageTimer(FmGuiFrameStage stage);
+	~ScopedStageTimer(void);
+	ScopedStageTimer(const ScopedStageTimer &) = delete;
+	ScopedStageTimer &operator=(const ScopedStageTimer &) = delete;
+private:
+	FmGuiFrameStage stage;
+	std::chrono::steady_clock::time_point start;
+	std::uint64_t startAllocationCount;
+};
+// Functions
+static float MicrosecondsSince(std::chrono::steady_clock::time_point start);
+static void CommitFrameStats(float totalTime,
+							 std::uint32_t totalAllocationCount,
+							 bool isRebuilt);
+static FmGuiStageStats ComputeStageStats(std::size_t column,
+									   bool isRebuiltOnly);
+static void ShowFrameStats(void);
+static bool NullRendererNewFrame(void *pUserData);
+static void NullRendererRenderDrawData(ImDrawData *pDrawData, void *pUserData);
+static void *NullRendererCreateTexture(unsigned int width, unsigned int height,
+									   void *pUserData);
+static bool NullRendererUpdateTexture(void *pTexture, unsigned int y,
+									  unsigned int height,
+									  const std::uint32_t *pPixels,
+									  void *pUserData);
+static void NullRendererDestroyTexture(void *pTexture, void *pUserData);
+static void ApplyConfig(void);
+static bool Initialize(void);
+static bool AdvanceInitialization(void);
+static bool ConsumeInitFault(FmGuiInitState state);
+static void ResumeFrame(void);
+static bool IsRebuildDue(std::chrono::steady_clock::time_point now);
+static ImDrawData *RebuildDrawData(void);
+// Variables
+static bool isStarted = false, isSuspended = false;
+static FmGuiInitState initState = FmGuiInitState::CONTEXT;
+static unsigned int initAttempts = 0, initRetryCountdown = 0;
+static constexpr unsigned int initRetryDelayMax = 600;
+static FmGuiInitState initFaultState = FmGuiInitState::READY;
+static unsigned int initFaultCount = 0;
+/*
+ * Written by whichever thread toggles the widgets, usually the window thread
+ * through the user's input routine, and read by the Present thread.
+ */
+static std::atomic<bool> areWidgetsEnabled(false);
+/*
+ * The first frame after a suspension has the whole suspension as its delta
+ * time. It is clamped to this value so animations and timers do not jump.
+ */
+static constexpr float resumeDeltaTimeMax = 1.0f / 30.0f;
+static FmGuiRoutinePtr pWidgetRoutine = nullptr;
+static FmGuiRenderer renderer;
+/*
+ * Frame statistics. The extra columns of the history are the frame total and
+ * the frame without PRESENT.
+ */
+static constexpr std::size_t frameStageCount =
+	static_cast<std::size_t>(FmGuiFrameStage::COUNT);
+static constexpr std::size_t totalColumn = frameStageCount;
+static constexpr std::size_t overheadColumn = frameStageCount + 1;
+static constexpr std::size_t frameStatsColumnCount = frameStageCount + 2;
+static constexpr std::size_t frameStatsHistorySize = 256;
+static constexpr const char *frameStageNames[frameStageCount] = {
+	"NewFrame", "Routine", "Render", "RenderDrawData", "Present"
+};
+static float frameStageTimes[frameStageCount];
+static float frameStatsHistory[frameStatsHistorySize][frameStatsColumnCount];
+static std::uint32_t frameStageAllocations[frameStageCount];
+static std::uint32_t
+frameAllocationHistory[frameStatsHistorySize][frameStatsColumnCount];
+static bool frameRebuildHistory[frameStatsHistorySize];
+static std::size_t frameStatsCount = 0, frameStatsNext = 0;
+static std::atomic<bool> isFrameStatsVisible(false);
+static FmGuiConfig fmGuiConfig;
+/*
+ * Draw data of the last rebuild, submitted again while no rebuild is due. It
+ * stays valid until the next ImGui::NewFrame. replayedFrameCount counts the
+ * frames it was submitted again in since.
+ */
+static ImDrawData *pLastDrawData = nullptr;
+static std::chrono::steady_clock::time_point nextRebuildTime;
+static unsigned int replayedFrameCount = 0;
+static std::atomic<bool> isRebuildRequested(false);
+static ImGuiContext *pImGuiContext = nullptr;
+#if defined FMGUI_ENABLE_IMPLOT
+static ImPlotContext *pImPlotContext = nullptr;
+#endif
+} // namespace Core
+} // namespace FmGui
+
+void
+FmGui::SetRoutinePtr(FmGuiRoutinePtr pRoutine)
+{
+	Core::pWidgetRoutine = pRoutine;
+}
+
+FmGui::Core::ScopedStageTimer::ScopedStageTimer(FmGuiFrameStage stage)
+	: stage(stage),
+	  start(std::chrono::steady_clock::now()),
+	  startAllocationCount(Allocator::GetAllocationCount())
+{
+	Profiler::BeginScope(frameStageNames[static_cast<std::size_t>(stage)]);
+}
+
+FmGui::Core::ScopedStageTimer::~ScopedStageTimer(void)
+{
+	const std::size_t index = static_cast<std::size_t>(stage);
+	frameStageTimes[index] += MicrosecondsSince(start);
+	frameStageAllocations[index] += static_cast<std::uint32_t>(
+		Allocator::GetAllocationCount() - startAllocationCount);
+	Profiler::EndScope();
+}
+
+static float
+FmGui::Core::MicrosecondsSince(std::chrono::steady_clock::time_point start)
+{
+	return std::chrono::duration<float, std::micro>(
+		std::chrono::steady_clock::now() - start).count();
+}
+
+static void
+FmGui::Core::CommitFrameStats(float totalTime,
+							   std::uint32_t totalAllocationCount,
+							   bool isRebuilt)
+{
+	float *const pRow = frameStatsHistory[frameStatsNext];
+	std::copy(frameStageTimes, frameStageTimes + frameStageCount, pRow);
+	const std::size_t present =
+		static_cast<std::size_t>(FmGuiFrameStage::PRESENT);
+	pRow[totalColumn] = totalTime;
+	pRow[overheadColumn] = totalTime - frameStageTimes[present];
+	std::uint32_t *const pAllocationRow =
+		frameAllocationHistory[frameStatsNext];
+	std::copy(frameStageAllocations, frameStageAllocations + frameStageCount,
+			  pAllocationRow);
+	pAllocationRow[totalColumn] = totalAllocationCount;
+	pAllocationRow[overheadColumn] =
+		totalAllocationCount - frameStageAllocations[present];
+	frameRebuildHistory[frameStatsNext] = isRebuilt;
+	frameStatsNext = (frameStatsNext + 1) % frameStatsHistorySize;
+	if (frameStatsCount < frameStatsHistorySize)
+		++frameStatsCount;
+}
+
+/*
+ * Statistics of a history column over every frame, or with isRebuiltOnly over
+ * the frames that rebuilt the widgets, for the stages the other frames skip.
+ */
+static FmGuiStageStats
+FmGui::Core::ComputeStageStats(std::size_t column, bool isRebuiltOnly)
+{
+	FmGuiStageStats stats = { 0.0f, 0.0f, 0.0f, 0.0f, 0, 0 };
+	float samples[frameStatsHistorySize];
+	std::size_t sampleCount = 0;
+	float sum = 0.0f;
+	// Oldest to newest, so the last sample taken is the last frame counted.
+	const std::size_t oldestIndex = (frameStatsCount < frameStatsHistorySize)
+		? 0 : frameStatsNext;
+	for (std::size_t age = 0; age < frameStatsCount; ++age) {
+		const std::size_t index = (oldestIndex + age) % frameStatsHistorySize;
+		if (isRebuiltOnly && !frameRebuildHistory[index])
+			continue;
+		samples[sampleCount++] = frameStatsHistory[index][column];
+		sum += frameStatsHistory[index][column];
+		stats.last = frameStatsHistory[index][column];
+		stats.lastAllocationCount = frameAllocationHistory[index][column];
+		stats.maxAllocationCount = std::max(stats.maxAllocationCount,
+			static_cast<unsigned int>(frameAllocationHistory[index][column]));
+	}
+	if (sampleCount == 0)
+		return stats;
+	stats.minimum = *std::min_element(samples, samples + sampleCount);
+	stats.average = sum / static_cast<float>(sampleCount);
+	// Nearest rank percentile.
+	const std::size_t rank = (sampleCount * 99 + 99) / 100 - 1;
+	std::nth_element(samples, samples + rank, samples + sampleCount);
+	stats.p99 = samples[rank];
+	return stats;
+}
+
+FmGuiFrameStats
+FmGui::GetFrameStats(void)
+{
+	FmGuiFrameStats stats;
+	stats.frameCount = Core::frameStatsCount;
+	stats.rebuiltFrameCount = static_cast<std::size_t>(
+		std::count(Core::frameRebuildHistory,
+				   Core::frameRebuildHistory + Core::frameStatsCount, true));
+	// Frames that only submitted the last draw data skip these stages.
+	const std::size_t renderDrawData =
+		static_cast<std::size_t>(FmGuiFrameStage::RENDER_DRAW_DATA);
+	for (std::size_t stage = 0; stage < Core::frameStageCount; ++stage) {
+		stats.stages[stage] =
+			Core::ComputeStageStats(stage, stage < renderDrawData);
+	}
+	stats.total = Core::ComputeStageStats(Core::totalColumn, false);
+	stats.overhead = Core::ComputeStageStats(Core::overheadColumn, false);
+	return stats;
+}
+
+bool
+FmGui::SetFrameStatsVisibility(bool isVisible)
+{
+	Core::RequestRebuild();
+	return Core::isFrameStatsVisible.exchange(isVisible,
+											  std::memory_order_relaxed);
+}
+
+static void
+FmGui::Core::ShowFrameStats(void)
+{
+	bool isVisible = true;
+	ImGui::SetNextWindowBgAlpha(0.75f);
+	if (ImGui::Begin("FmGui Frame Stats", &isVisible,
+					 ImGuiWindowFlags_AlwaysAutoResize
+					 | ImGuiWindowFlags_NoFocusOnAppearing)) {
+		const FmGuiFrameStats stats = GetFrameStats();
+		ImGui::Text("Last %u frames, microseconds. %u rebuilt the widgets.",
+					static_cast<unsigned int>(stats.frameCount),
+					static_cast<unsigned int>(stats.rebuiltFrameCount));
+		const ImGuiTableFlags tableFlags =
+			ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg;
+		if (ImGui::BeginTable("FrameStats", 7, tableFlags)) {
+			ImGui::TableSetupColumn("Stage");
+			ImGui::TableSetupColumn("Last");
+			ImGui::TableSetupColumn("Min");
+			ImGui::TableSetupColumn("Avg");
+			ImGui::TableSetupColumn("p99");
+			ImGui::TableSetupColumn("Allocs");
+			ImGui::TableSetupColumn("Max allocs");
+			ImGui::TableHeadersRow();
+			for (std::size_t column = 0; column < frameStatsColumnCount;
+				 ++column) {
+				const FmGuiStageStats &stageStats =
+					(column == totalColumn) ? stats.total
+					: (column == overheadColumn) ? stats.overhead
+					: stats.stages[column];
+				ImGui::TableNextRow();
+				ImGui::TableNextColumn();
+				ImGui::TextUnformatted((column == totalColumn) ? "Total"
+					: (column == overheadColumn) ? "FmGui"
+					: frameStageNames[column]);
+				ImGui::TableNextColumn();
+				ImGui::Text("%.1f", stageStats.last);
+				ImGui::TableNextColumn();
+				ImGui::Text("%.1f", stageStats.minimum);
+				ImGui::TableNextColumn();
+				ImGui::Text("%.1f", stageStats.average);
+				ImGui::TableNextColumn();
+				ImGui::Text("%.1f", stageStats.p99);
+				ImGui::TableNextColumn();
+				ImGui::Text("%u", stageStats.lastAllocationCount);
+				ImGui::TableNextColumn();
+				ImGui::Text("%u", stageStats.maxAllocationCount);
+			}
+			ImGui::EndTable();
+		}
+		// Routine allocations elsewhere are unseen, see FmGuiAllocator.hpp.
+		ImGui::TextDisabled("Allocs count ImGui, ImPlot, FmGui and "
+							"FmGui::Allocator::Vector.");
+		const FmGuiAllocatorStats allocatorStats = Allocator::GetStats();
+		ImGui::Text("ImGui memory: %.1f KiB (peak %.1f), %u system "
+					"allocations.", allocatorStats.liveBytes / 1024.0,
+					allocatorStats.peakLiveBytes / 1024.0,
+					static_cast<unsigned int>(
+						allocatorStats.systemAllocationCount));
+		ImGui::Text("Frame arena: %.1f KiB (peak %.1f).",
+					allocatorStats.frameArenaBytes / 1024.0,
+					allocatorStats.frameArenaPeakBytes / 1024.0);
+	}
+	ImGui::End();
+	if (!isVisible)
+		isFrameStatsVisible.store(false, std::memory_order_relaxed);
+}
+
+bool
+FmGui::SetWidgetVisibility(bool isEnabled)
+{
+	return Core::areWidgetsEnabled.exchange(isEnabled,
+											 std::memory_order_relaxed);
+}
+
+void
+FmGui::SetMessageCallback(FmGuiMessageCallback pMessageCallback)
+{
+	FmGui::pMessageCallback.store(pMessageCallback, std::memory_order_release);
+}
+
+void
+FmGui::PushMessage(FmGuiMessageSeverity severity, const char *file,
+				   const char *function, std::uint32_t line,
+				   const char *format, ...)
+{
+	FmGuiMessage message;
+	message.file = file ? file : "";
+	message.function = function ? function : "";
+	message.line = line;
+	message.severity = severity;
+	message.timestamp = static_cast<std::uint64_t>(
+		std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count());
+	std::va_list args;
+	va_start(args, format);
+	const int written = std::vsnprintf(message.content,
+									   sizeof(message.content), format, args);
+	va_end(args);
+	if (written < 0)
+		message.content[0] = '\0';
+
+	// Drop consecutive duplicates, e.g. a failure repeating every frame.
+	const std::uint64_t head = messageRingHead.load(std::memory_order_acquire);
+	FmGuiMessage previous;
+	if (head > 0 && ReadMessageSlot(head - 1, previous)
+		&& previous.severity == message.severity
+		&& std::strcmp(previous.content, message.content) == 0) {
+		return;
+	}
+
+	/*
+	 * Claim a slot, then write it like a seqlock: an odd sequence marks the
+	 * slot as being written, the final even sequence publishes it. Readers
+	 * that race with the writer see a mismatched sequence and skip the slot.
+	 */
+	const std::uint64_t index =
+		messageRingHead.fetch_add(1, std::memory_order_acq_rel);
+	MessageSlot &slot = messageRing[index & (messageRingSize - 1)];
+	if (ClaimMessageSlot(slot, index)) {
+		std::atomic_thread_fence(std::memory_order_release);
+		slot.message = message;
+		slot.sequence.store(2 * index + 2, std::memory_order_release);
+	} else {
+		droppedMessageCount.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	const FmGuiMessageCallback pCallback =
+		pMessageCallback.load(std::memory_order_acquire);
+	if (pCallback != nullptr)
+		pCallback(message);
+}
+
+/*
+ * Mark the slot as being written by the message with the given ring index.
+ * Fails while the writer of a previous lap is still writing the slot, or once
+ * a writer of a later lap claimed it, as writing it then would race with that
+ * writer.
+ */
+static bool
+FmGui::ClaimMessageSlot(MessageSlot &slot, std::uint64_t index)
+{
+	const std::uint64_t writingSequence = 2 * index + 1;
+	std::uint64_t sequence = slot.sequence.load(std::memory_order_relaxed);
+	do {
+		if ((sequence & 1) != 0 || sequence >= writingSequence)
+			return false;
+	} while (!slot.sequence.compare_exchange_weak(sequence, writingSequence,
+												  std::memory_order_acquire,
+												  std::memory_order_relaxed));
+	return true;
+}
+
+std::uint64_t
+FmGui::GetDroppedMessageCount(void)
+{
+	return droppedMessageCount.load(std::memory_order_relaxed);
+}
+
+static bool
+FmGui::ReadMessageSlot(std::uint64_t index, FmGuiMessage &message)
+{
+	const MessageSlot &slot = messageRing[index & (messageRingSize - 1)];
+	const std::uint64_t sequence = 2 * index + 2;
+	if (slot.sequence.load(std::memory_order_acquire) != sequence)
+		return false;
+	message = slot.message;
+	std::atomic_thread_fence(std::memory_order_acquire);
+	// Overwritten while copying, the copy may be torn.
+	return slot.sequence.load(std::memory_order_relaxed) == sequence;
+}
+
+FmGuiMessage
+FmGui::GetLastError(void)
+{
+	const std::uint64_t head = messageRingHead.load(std::memory_order_acquire);
+	const std::uint64_t first =
+		(head > messageRingSize) ? head - messageRingSize : 0;
+	FmGuiMessage message;
+	for (std::uint64_t index = head; index > first; --index) {
+		if (ReadMessageSlot(index - 1, message))
+			return message;
+	}
+	return FmGuiMessage();
+}
+
+std::vector<FmGuiMessage>
+FmGui::GetEveryMessage(void)
+{
+	const std::uint64_t head = messageRingHead.load(std::memory_order_acquire);
+	const std::uint64_t first =
+		(head > messageRingSize) ? head - messageRingSize : 0;
+	std::vector<FmGuiMessage> messages;
+	messages.reserve(static_cast<std::size_t>(head - first));
+	FmGuiMessage message;
+	for (std::uint64_t index = first; index < head; ++index) {
+		// Slots still being written or already overwritten are skipped.
+		if (ReadMessageSlot(index, message))
+			messages.push_back(message);
+	}
+	return messages; // Hope for return value optimization.
+}
+
+bool
+FmGui::Core::Startup(const FmGuiConfig &config)
+{
+	if (isStarted)
+		return true;
+	fmGuiConfig = config;
+	Allocator::Initialize(fmGuiConfig.frameArenaSize);
+	initState = FmGuiInitState::CONTEXT;
+	initAttempts = 0;
+	initRetryCountdown = 0;
+	isStarted = true;
+	return true;
+}
+
+/*
+ * One initialization attempt, resuming from the state the previous attempt
+ * stopped at. Returns true once READY.
+ */
+static bool
+FmGui::Core::Initialize(void)
+{
+	if (initState == FmGuiInitState::CONTEXT) {
+		if (ConsumeInitFault(FmGuiInitState::CONTEXT))
+			return false;
+		if (!pImGuiContext) {
+			/*
+			 * Every allocation of the context must come from the same
+			 * allocator. It is counted for the frame statistics either way.
+			 */
+			Allocator::Install(fmGuiConfig.useDedicatedAllocator);
+			pImGuiContext = ImGui::CreateContext();
+			if (!pImGuiContext) {
+				FMGUI_PUSH_MSG(FmGuiMessageSeverity::HIGH,
+							   "ImGui::CreateContext failed!");
+				return false;
+			}
+			ImGui::SetCurrentContext(pImGuiContext);
+			ApplyConfig();
+		}
+#if defined FMGUI_ENABLE_IMPLOT
+		if (!pImPlotContext) {
+			pImPlotContext = ImPlot::CreateContext();
+			if (!pImPlotContext) {
+				FMGUI_PUSH_MSG(FmGuiMessageSeverity::HIGH,
+							   "ImPlot::CreateContext failed!");
+				return false;
+			}
+		}
+#endif
+		initState = FmGuiInitState::RENDERER;
+	}
+
+	ImGui::SetCurrentContext(pImGuiContext);
+#if defined FMGUI_ENABLE_IMPLOT
+	ImPlot::SetCurrentContext(pImPlotContext);
+#endif
+	if (initState == FmGuiInitState::RENDERER) {
+		if (ConsumeInitFault(FmGuiInitState::RENDERER))
+			return false;
+		if (renderer.pInitialize != nullptr
+			&& !renderer.pInitialize(renderer.pUserData)) {
+			return false;
+		}
+		initState = FmGuiInitState::READY;
+		FMGUI_PUSH_MSG(FmGuiMessageSeverity::NOTIFICATION,
+					   "FmGui initialized.");
+	}
+	return true;
+}
+
+/*
+ * Called by Frame until READY. Attempts are spaced out with an exponential
+ * backoff, so a persistent failure costs next to nothing per frame.
+ */
+static bool
+FmGui::Core::AdvanceInitialization(void)
+{
+	if (initState == FmGuiInitState::GAVE_UP)
+		return false;
+	if (initRetryCountdown > 0) {
+		--initRetryCountdown;
+		return false;
+	}
+	if (Initialize())
+		return true;
+
+	++initAttempts;
+	if (initAttempts >= fmGuiConfig.initAttemptLimit) {
+		initState = FmGuiInitState::GAVE_UP;
+		FMGUI_PUSH_MSGF(FmGuiMessageSeverity::HIGH,
+						"FmGui gave up initializing after %u attempts!",
+						initAttempts);
+		return false;
+	}
+	// Compared before shifting, as the shift may overflow.
+	const unsigned int shift = (initAttempts < 16) ? initAttempts - 1 : 15;
+	initRetryCountdown =
+		(fmGuiConfig.initRetryDelay > (initRetryDelayMax >> shift))
+		? initRetryDelayMax : fmGuiConfig.initRetryDelay << shift;
+	FMGUI_PUSH_MSGF(FmGuiMessageSeverity::MEDIUM,
+					"FmGui initialization attempt %u failed, retrying in %u "
+					"frames.", initAttempts, initRetryCountdown);
+	return false;
+}
+
+static bool
+FmGui::Core::ConsumeInitFault(FmGuiInitState state)
+{
+	if (initFaultCount == 0 || initFaultState != state)
+		return false;
+	--initFaultCount;
+	FMGUI_PUSH_MSG(FmGuiMessageSeverity::LOW, "Injected initialization fault.");
+	return true;
+}
+
+FmGuiInitState
+FmGui::Core::GetInitState(void)
+{
+	return initState;
+}
+
+void
+FmGui::Core::InjectInitFault(FmGuiInitState state, unsigned int count)
+{
+	initFaultState = state;
+	initFaultCount = count;
+}
+
+static void
+FmGui::Core::ApplyConfig(void)
+{
+	ImGuiIO &imGuiIO = ImGui::GetIO();
+	// Configuration of the current ImGui context.
+	imGuiIO.ConfigFlags |= fmGuiConfig.imGuiConfigFlags;
+#if defined FMGUI_ENABLE_IMPLOT
+	/*
+	 * For ImPlot enable meshes with over 64,000 vertices while using the
+	 * default backend 16 bit value for indexed drawing.
+	 * https://github.com/ocornut/imgui/issues/2591
+	 * (Extremely Important Note) Option 2:
+	 * https://github.com/epezent/implot/blob/master/README.md
+	 */
+	imGuiIO.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;
+#endif
+	if (fmGuiConfig.imGuiIniFileName.empty())
+		imGuiIO.IniFilename = nullptr;
+	else
+		imGuiIO.IniFilename = fmGuiConfig.imGuiIniFileName.c_str();
+	imGuiIO.IniSavingRate = fmGuiConfig.imGuiIniSavingRate;
+	switch (fmGuiConfig.imGuiStyle) {
+	case FmGuiStyle::CLASSIC:
+		ImGui::StyleColorsClassic();
+		break;
+	case FmGuiStyle::DARK:
+		ImGui::StyleColorsDark();
+		break;
+	case FmGuiStyle::LIGHT:
+		ImGui::StyleColorsLight();
+		break;
+	}
+}
+
+void
+FmGui::Core::SetRenderer(const FmGuiRenderer &renderer)
+{
+	Core::renderer = renderer;
+}
+
+FmGuiRenderer
+FmGui::Core::MakeNullRenderer(FmGuiNullRendererData *pData)
+{
+	FmGuiRenderer nullRenderer;
+	nullRenderer.pNewFrame = NullRendererNewFrame;
+	nullRenderer.pRenderDrawData = NullRendererRenderDrawData;
+	nullRenderer.pCreateTexture = NullRendererCreateTexture;
+	nullRenderer.pUpdateTexture = NullRendererUpdateTexture;
+	nullRenderer.pDestroyTexture = NullRendererDestroyTexture;
+	nullRenderer.pUserData = pData;
+	return nullRenderer;
+}
+
+static bool
+FmGui::Core::NullRendererNewFrame(void *pUserData)
+{
+	const FmGuiNullRendererData *pData =
+		static_cast<const FmGuiNullRendererData *>(pUserData);
+	if (!pData)
+		return false;
+	ImGuiIO &imGuiIO = ImGui::GetIO();
+	// Build the font atlas once. There is no texture to upload it to.
+	if (!imGuiIO.Fonts->IsBuilt()) {
+		unsigned char *pPixels = nullptr;
+		int width = 0, height = 0;
+		imGuiIO.Fonts->GetTexDataAsAlpha8(&pPixels, &width, &height);
+		imGuiIO.Fonts->SetTexID(
+			reinterpret_cast<ImTextureID>(static_cast<std::intptr_t>(1)));
+	}
+	imGuiIO.DisplaySize = ImVec2(pData->displayWidth, pData->displayHeight);
+	// The frames that only submitted the last draw data still passed.
+	imGuiIO.DeltaTime = pData->deltaTime
+		* static_cast<float>(replayedFrameCount + 1);
+	return true;
+}
+
+static void
+FmGui::Core::NullRendererRenderDrawData(ImDrawData *pDrawData, void *pUserData)
+{
+	// Nothing is drawn.
+}
+
+static void *
+FmGui::Core::NullRendererCreateTexture(unsigned int width, unsigned int height,
+									   void *pUserData)
+{
+	// Like the font atlas, any non-null ID will do.
+	if (width == 0 || height == 0)
+		return nullptr;
+	return reinterpret_cast<void *>(static_cast<std::intptr_t>(2));
+}
+
+static bool
+FmGui::Core::NullRendererUpdateTexture(void *pTexture, unsigned int y,
+									   unsigned int height,
+									   const std::uint32_t *pPixels,
+									   void *pUserData)
+{
+	return pTexture != nullptr && pPixels != nullptr;
+}
+
+static void
+FmGui::Core::NullRendererDestroyTexture(void *pTexture, void *pUserData)
+{
+}
+
+void *
+FmGui::Core::CreateTexture(unsigned int width, unsigned int height)
+{
+	if (initState != FmGuiInitState::READY
+		|| renderer.pCreateTexture == nullptr)
+		return nullptr;
+	return renderer.pCreateTexture(width, height, renderer.pUserData);
+}
+
+bool
+FmGui::Core::UpdateTexture(void *pTexture, unsigned int y, unsigned int height,
+						   const std::uint32_t *pPixels)
+{
+	if (pTexture == nullptr || renderer.pUpdateTexture == nullptr)
+		return false;
+	return renderer.pUpdateTexture(pTexture, y, height, pPixels,
+								   renderer.pUserData);
+}
+
+void
+FmGui::Core::DestroyTexture(void *pTexture)
+{
+	if (pTexture != nullptr && renderer.pDestroyTexture != nullptr)
+		renderer.pDestroyTexture(pTexture, renderer.pUserData);
+}
+
+bool
+FmGui::Core::IsStarted(void)
+{
+	return isStarted;
+}
+
+bool
+FmGui::Core::AreWidgetsEnabled(void)
+{
+	return areWidgetsEnabled.load(std::memory_order_relaxed);
+}
+
+bool
+FmGui::Core::IsSuspended(void)
+{
+	return initState == FmGuiInitState::READY
+		&& !areWidgetsEnabled.load(std::memory_order_relaxed);
+}
+
+bool
+FmGui::Core::Frame(void)
+{
+	if (!isStarted)
+		return false;
+	if (initState != FmGuiInitState::READY && !AdvanceInitialization())
+		return false;
+	// Hidden widgets skip the whole ImGui pipeline.
+	if (!areWidgetsEnabled.load(std::memory_order_relaxed)) {
+		Input::DiscardEvents();
+		isSuspended = true;
+		pLastDrawData = nullptr;
+		return false;
+	}
+	ImGui::SetCurrentContext(pImGuiContext);
+#if defined FMGUI_ENABLE_IMPLOT
+	ImPlot::SetCurrentContext(pImPlotContext);
+#endif
+	Allocator::BeginFrame();
+
+	const std::chrono::steady_clock::time_point frameStart =
+		std::chrono::steady_clock::now();
+	const std::uint64_t frameStartAllocationCount =
+		Allocator::GetAllocationCount();
+	std::fill(frameStageTimes, frameStageTimes + frameStageCount, 0.0f);
+	std::fill(frameStageAllocations, frameStageAllocations + frameStageCount,
+			  0);
+	// Each frame is a tick of the render thread in the profiler.
+	Profiler::SetThreadName("Render");
+	Profiler::MarkTick();
+	const bool isRebuilt = IsRebuildDue(frameStart);
+	if (isRebuilt) {
+		pLastDrawData = RebuildDrawData();
+		if (pLastDrawData == nullptr)
+			return false;
+		replayedFrameCount = 0;
+	} else {
+		++replayedFrameCount;
+	}
+	{
+		ScopedStageTimer stageTimer(FmGuiFrameStage::RENDER_DRAW_DATA);
+		if (renderer.pRenderDrawData != nullptr)
+			renderer.pRenderDrawData(pLastDrawData, renderer.pUserData);
+	}
+	{
+		ScopedStageTimer stageTimer(FmGuiFrameStage::PRESENT);
+		if (renderer.pPresent != nullptr)
+			renderer.pPresent(renderer.pUserData);
+	}
+	CommitFrameStats(MicrosecondsSince(frameStart),
+					 static_cast<std::uint32_t>(Allocator::GetAllocationCount()
+												- frameStartAllocationCount),
+					 isRebuilt);
+	return true;
+}
+
+void
+FmGui::Core::RequestRebuild(void)
+{
+	isRebuildRequested.store(true, std::memory_order_relaxed);
+}
+
+static bool
+FmGui::Core::IsRebuildDue(std::chrono::steady_clock::time_point now)
+{
+	const bool isRequested =
+		isRebuildRequested.exchange(false, std::memory_order_relaxed);
+	const float refreshRate = fmGuiConfig.refreshRate;
+	if (refreshRate <= 0.0f || pLastDrawData == nullptr || isSuspended
+		|| isRequested || Input::HasPendingEvents()) {
+		return true;
+	}
+	return now >= nextRebuildTime;
+}
+
+/*
+ * Runs the ImGui frame proper and returns the draw data to submit, or nullptr
+ * if the renderer failed to start a frame.
+ */
+static ImDrawData *
+FmGui::Core::RebuildDrawData(void)
+{
+	const std::chrono::steady_clock::time_point rebuildStart =
+		std::chrono::steady_clock::now();
+	{
+		ScopedStageTimer stageTimer(FmGuiFrameStage::NEW_FRAME);
+		if (renderer.pNewFrame != nullptr
+			&& !renderer.pNewFrame(renderer.pUserData)) {
+			return nullptr;
+		}
+		if (isSuspended) {
+			ResumeFrame();
+			isSuspended = false;
+		}
+		Input::ApplyEvents();
+		ImGui::NewFrame();
+	}
+	{
+		ScopedStageTimer stageTimer(FmGuiFrameStage::ROUTINE);
+		Profiler::Collect();
+		if (pWidgetRoutine != nullptr)
+			pWidgetRoutine();
+		Panels::Run(fmGuiConfig.panelBudget);
+		if (isFrameStatsVisible.load(std::memory_order_relaxed))
+			ShowFrameStats();
+		Panels::ShowList();
+		Profiler::ShowPanel();
+	}
+	ImDrawData *pDrawData = nullptr;
+	{
+		ScopedStageTimer stageTimer(FmGuiFrameStage::RENDER);
+		ImGui::EndFrame();
+		ImGui::Render();
+		pDrawData = Panels::PrepareDrawData(ImGui::GetDrawData());
+	}
+	const float refreshRate = fmGuiConfig.refreshRate;
+	if (refreshRate > 0.0f && rebuildStart >= nextRebuildTime) {
+		// Keep the rate steady, unless a whole period was missed. Rebuilds
+		// forced early leave the schedule alone.
+		const std::chrono::steady_clock::duration interval =
+			std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+				std::chrono::duration<float>(1.0f / refreshRate));
+		nextRebuildTime = (rebuildStart - nextRebuildTime < interval)
+			? nextRebuildTime + interval : rebuildStart + interval;
+	}
+	return pDrawData;
+}
+
+static void
+FmGui::Core::ResumeFrame(void)
+{
+	ImGuiIO &imGuiIO = ImGui::GetIO();
+	if (imGuiIO.DeltaTime > resumeDeltaTimeMax)
+		imGuiIO.DeltaTime = resumeDeltaTimeMax;
+	/*
+	 * Input is not forwarded to ImGui while suspended, so releases that
+	 * happened in the meantime were never seen. Release everything.
+	 */
+	imGuiIO.ClearInputKeys();
+	imGuiIO.ClearInputCharacters();
+	for (int button = 0; button < ImGuiMouseButton_COUNT; ++button)
+		imGuiIO.AddMouseButtonEvent(button, false);
+}
+
+void
+FmGui::Core::Shutdown(void)
+{
+	Panels::Shutdown();
+	pLastDrawData = nullptr;
+	replayedFrameCount = 0;
+#if defined FMGUI_ENABLE_IMPLOT
+	if (pImPlotContext != nullptr) {
+		ImPlot::DestroyContext(pImPlotContext);
+		pImPlotContext = nullptr;
+	}
+#endif
+
+	if (pImGuiContext != nullptr) {
+		ImGui::DestroyContext(pImGuiContext);
+		pImGuiContext = nullptr;
+	}
+	Allocator::Uninstall();
+	Allocator::Shutdown();
+	Profiler::Shutdown();
+	Input::DiscardEvents();
+	Input::StopRecording();
+	renderer = FmGuiRenderer();
+	isStarted = false;
+	isSuspended = false;
+	initState = FmGuiInitState::CONTEXT;
+	initFaultCount = 0;
+}
+
+/*
+ * FmGuiConfig's members need be defined where imgui/imgui.h is included.
+ */
+FmGuiConfig::FmGuiConfig(void)
+	: imGuiStyle(FmGuiStyle::DARK),
+	  imGuiConfigFlags(
+		  static_cast<ImGuiConfigFlags>(ImGuiConfigFlags_NavNoCaptureKeyboard)
+	  ),
+	  imGuiIniFileName(),
+	  imGuiIniSavingRate(5.0f),
+	  initAttemptLimit(10),
+	  initRetryDelay(1),
+	  useDedicatedAllocator(false),
+	  frameArenaSize(262144),
+	  panelBudget(0.0f),
+	  refreshRate(0.0f)
+{
+}
@@ -0,0 +1,355 @@
+/* =============================================================================
+** DCS-EFM-ImGui, file: FmGuiHistory.cpp Created: 17-OCT-2026
+**
+** Copyright 2022 Brian Hoffpauir, USA
+** All rights reserved.
+**
+** Redistribution and use of this source file, with or without modification, is
+** permitted provided that the following conditions are met:
+**
+** 1. Redistributions of this source file must retain the above copyright
+**    notice, this list of conditions and the following disclaimer.
+**
+** 2. Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and/or other materials provided with the distribution.
+**
+** THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+** WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO
+** EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+** PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+** OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+** WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+** OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+** ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+** =============================================================================
+**/
+#include "FmGuiHistory.hpp"
+#include "FmGuiCore.hpp"
+
+#include <cstring>
+#include <algorithm>
+
+namespace FmGui
+{
+// Functions
+static std::size_t WriteVarint(std::uint8_t *pOut, std::size_t value);
+static std::size_t ReadVarint(const std::uint8_t *pIn, std::size_t &value);
+// Variables
+// Largest encoding of a std::size_t, seven bits per byte.
+static constexpr std::size_t varintSizeLimit = 10;
+} // namespace FmGui
+
+static std::size_t
+FmGui::WriteVarint(std::uint8_t *pOut, std::size_t value)
+{
+	std::size_t length = 0;
+	while (value >= 0x80) {
+		pOut[length++] = static_cast<std::uint8_t>(value | 0x80);
+		value >>= 7;
+	}
+	pOut[length++] = static_cast<std::uint8_t>(value);
+	return length;
+}
+
+static std::size_t
+FmGui::ReadVarint(const std::uint8_t *pIn, std::size_t &value)
+{
+	std::size_t length = 0;
+	unsigned int shift = 0;
+	value = 0;
+	do {
+		value |= static_cast<std::size_t>(pIn[length] & 0x7F) << shift;
+		shift += 7;
+	} while ((pIn[length++] & 0x80) != 0);
+	return length;
+}
+
+FmGui::StateHistoryBuffer::StateHistoryBuffer(
+	std::size_t stateSize, const FmGuiStateHistoryConfig &config)
+	: config(config),
+	  stateSize(std::max<std::size_t>(stateSize, 1)),
+	  writeOffset(0),
+	  usedBytes(0),
+	  entryHead(0),
+	  entryCount(0),
+	  keyframeCount(0),
+	  statesSinceKeyframe(0),
+	  firstSequence(0),
+	  cacheSequence(0),
+	  isCacheValid(false)
+{
+	// States are XORed as 8 byte words, the last one padded with zeros.
+	wordCount = (this->stateSize + 7) / 8;
+	const std::size_t keyframeSize = wordCount * 8;
+	if (this->config.byteCapacity < 2 * keyframeSize) {
+		FMGUI_PUSH_MSGF(FmGuiMessageSeverity::MEDIUM,
+						"State history capacity of %u bytes does not fit two "
+						"keyframes, using %u.",
+						static_cast<unsigned int>(this->config.byteCapacity),
+						static_cast<unsigned int>(2 * keyframeSize));
+		this->config.byteCapacity = 2 * keyframeSize;
+	}
+	// Offsets into the ring are 32 bit.
+	this->config.byteCapacity =
+		std::min<std::size_t>(this->config.byteCapacity, 0xFFFFFFFF);
+	this->config.stateCapacity =
+		std::max<std::size_t>(this->config.stateCapacity, 1);
+	this->config.keyframeInterval =
+		std::max<std::size_t>(this->config.keyframeInterval, 1);
+	bytes.resize(this->config.byteCapacity);
+	entries.resize(this->config.stateCapacity);
+	previousWords.assign(wordCount, 0);
+	currentWords.assign(wordCount, 0);
+	cacheWords.assign(wordCount, 0);
+	encoded.resize(keyframeSize + 2 * varintSizeLimit);
+}
+
+void
+FmGui::StateHistoryBuffer::Record(double time, const void *pState)
+{
+	currentWords.back() = 0;
+	std::memcpy(currentWords.data(), pState, stateSize);
+
+	if (entryCount == config.stateCapacity)
+		EvictOldest();
+	bool isKeyframe = entryCount == 0
+		|| statesSinceKeyframe >= config.keyframeInterval;
+	std::size_t size = 0, offset = 0;
+	if (!isKeyframe) {
+		// A delta that is no smaller than the state is stored as a keyframe.
+		size = Encode();
+		isKeyframe = size == 0;
+		if (!isKeyframe) {
+			offset = Allocate(size);
+			// Making room dropped the previous state the delta is based on.
+			isKeyframe = entryCount == 0;
+		}
+	}
+	const std::uint8_t *pData = encoded.data();
+	if (isKeyframe) {
+		size = wordCount * 8;
+		offset = Allocate(size);
+		pData = reinterpret_cast<const std::uint8_t *>(currentWords.data());
+	}
+	std::memcpy(bytes.data() + offset, pData, size);
+
+	Entry &entry = entries[(entryHead + entryCount) % entries.size()];
+	entry.time = time;
+	entry.offset = static_cast<std::uint32_t>(offset);
+	entry.size = static_cast<std::uint32_t>(size);
+	entry.isKeyframe = isKeyframe;
+	++entryCount;
+	writeOffset = offset + size;
+	usedBytes += size;
+	if (isKeyframe) {
+		++keyframeCount;
+		statesSinceKeyframe = 1;
+	} else {
+		++statesSinceKeyframe;
+	}
+	previousWords.swap(currentWords);
+}
+
+void
+FmGui::StateHistoryBuffer::Clear(void)
+{
+	writeOffset = usedBytes = 0;
+	entryHead = entryCount = keyframeCount = 0;
+	statesSinceKeyframe = 0;
+	firstSequence = 0;
+	isCacheValid = false;
+}
+
+std::size_t
+FmGui::StateHistoryBuffer::GetSize(void) const
+{
+	return entryCount;
+}
+
+double
+FmGui::StateHistoryBuffer::GetTime(std::size_t index) const
+{
+	return GetEntry(index).time;
+}
+
+std::size_t
+FmGui::StateHistoryBuffer::FindIndex(double time) const
+{
+	// Binary search for the first state after time.
+	std::size_t first = 0, count = entryCount;
+	while (count > 0) {
+		const std::size_t step = count / 2;
+		if (GetEntry(first + step).time <= time) {
+			first += step + 1;
+			count -= step + 1;
+		} else {
+			count = step;
+		}
+	}
+	return first > 0 ? first - 1 : 0;
+}
+
+bool
+FmGui::StateHistoryBuffer::Reconstruct(std::size_t index, void *pState)
+{
+	if (index >= entryCount)
+		return false;
+	// The oldest state is always a keyframe.
+	std::size_t keyframeIndex = index;
+	while (!GetEntry(keyframeIndex).isKeyframe)
+		--keyframeIndex;
+	// Continue from the last reconstruction if it lies on the way.
+	const std::uint64_t sequence = firstSequence + index;
+	std::size_t nextIndex = keyframeIndex;
+	if (isCacheValid && cacheSequence <= sequence
+		&& cacheSequence >= firstSequence + keyframeIndex) {
+		nextIndex = static_cast<std::size_t>(cacheSequence - firstSequence)
+			+ 1;
+	}
+	for (; nextIndex <= index; ++nextIndex)
+		Decode(GetEntry(nextIndex), cacheWords.data());
+	cacheSequence = sequence;
+	isCacheValid = true;
+	std::memcpy(pState, cacheWords.data(), stateSize);
+	return true;
+}
+
+std::size_t
+FmGui::StateHistoryBuffer::GetMemoryUsage(void) const
+{
+	return usedBytes;
+}
+
+std::size_t
+FmGui::StateHistoryBuffer::GetKeyframeCount(void) const
+{
+	return keyframeCount;
+}
+
+const FmGuiStateHistoryConfig &
+FmGui::StateHistoryBuffer::GetConfig(void) const
+{
+	return config;
+}
+
+/*
+ * Encodes the XOR of the current and previous state as pairs of varints, the
+ * number of unchanged words and the number of changed words, each followed by
+ * the XOR of the changed words. Returns 0 if the delta would not be smaller
+ * than a keyframe.
+ */
+std::size_t
+FmGui::StateHistoryBuffer::Encode(void)
+{
+	const std::size_t sizeLimit = wordCount * 8;
+	std::uint8_t *pOut = encoded.data();
+	std::size_t length = 0, word = 0;
+	while (word < wordCount) {
+		const std::size_t zeroStart = word;
+		while (word < wordCount && previousWords[word] == currentWords[word])
+			++word;
+		const std::size_t literalStart = word;
+		while (word < wordCount && previousWords[word] != currentWords[word])
+			++word;
+		const std::size_t literalCount = word - literalStart;
+		if (length + 2 * varintSizeLimit + literalCount * 8 >= sizeLimit)
+			return 0;
+		length += WriteVarint(pOut + length, literalStart - zeroStart);
+		length += WriteVarint(pOut + length, literalCount);
+		for (std::size_t index = literalStart; index < word; ++index) {
+			const std::uint64_t delta =
+				previousWords[index] ^ currentWords[index];
+			std::memcpy(pOut + length, &delta, sizeof(delta));
+			length += sizeof(delta);
+		}
+	}
+	return length;
+}
+
+/*
+ * Offset of size free bytes in the ring, dropping the oldest states until
+ * there is room. The states lie between the oldest entry and writeOffset,
+ * wrapping around at most once, and a state never straddles the end.
+ */
+std::size_t
+FmGui::StateHistoryBuffer::Allocate(std::size_t size)
+{
+	for (;;) {
+		if (entryCount == 0)
+			return 0;
+		const std::size_t oldestOffset = GetEntry(0).offset;
+		if (writeOffset > oldestOffset) {
+			if (writeOffset + size <= bytes.size())
+				return writeOffset;
+			// Wrap around, leaving the end of the ring unused.
+			if (size <= oldestOffset)
+				return 0;
+		} else if (writeOffset + size <= oldestOffset) {
+			return writeOffset;
+		}
+		EvictOldest();
+	}
+}
+
+/*
+ * Drops the oldest state, along with the deltas that followed it up to the
+ * next keyframe, since they can no longer be reconstructed.
+ */
+void
+FmGui::StateHistoryBuffer::EvictOldest(void)
+{
+	do {
+		const Entry &entry = entries[entryHead];
+		usedBytes -= entry.size;
+		if (entry.isKeyframe)
+			--keyframeCount;
+		entryHead = (entryHead + 1) % entries.size();
+		--entryCount;
+		++firstSequence;
+	} while (entryCount > 0 && !entries[entryHead].isKeyframe);
+	if (isCacheValid && cacheSequence < firstSequence)
+		isCacheValid = false;
+	if (entryCount == 0)
+		writeOffset = 0;
+}
+
+const FmGui::StateHistoryBuffer::Entry &
+FmGui::StateHistoryBuffer::GetEntry(std::size_t index) const
+{
+	return entries[(entryHead + index) % entries.size()];
+}
+
+void
+FmGui::StateHistoryBuffer::Decode(const Entry &entry,
+								  std::uint64_t *pWords) const
+{
+	const std::uint8_t *pIn = bytes.data() + entry.offset;
+	if (entry.isKeyframe) {
+		std::memcpy(pWords, pIn, entry.size);
+		return;
+	}
+	const std::uint8_t *pEnd = pIn + entry.size;
+	std::size_t word = 0;
+	while (pIn < pEnd) {
+		std::size_t zeroCount = 0, literalCount = 0;
+		pIn += ReadVarint(pIn, zeroCount);
+		pIn += ReadVarint(pIn, literalCount);
+		word += zeroCount;
+		for (std::size_t index = 0; index < literalCount; ++index) {
+			std::uint64_t delta;
+			std::memcpy(&delta, pIn, sizeof(delta));
+			pWords[word++] ^= delta;
+			pIn += sizeof(delta);
+		}
+	}
+}
+
+FmGuiStateHistoryConfig::FmGuiStateHistoryConfig(void)
+	: byteCapacity(32 * 1024 * 1024),
+	  stateCapacity(60000),
+	  keyframeInterval(64)
+{
+}
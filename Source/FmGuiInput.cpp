@@ -0,0 +1,394 @@
+/* =============================================================================
+** DCS-EFM-ImGui, file: FmGuiInput.cpp Created: 17-OCT-2026
+**
+** Copyright 2022 Brian Hoffpauir, USA
+** All rights reserved.
+**
+** Redistribution and use of this source file, with or without modification, is
+** permitted provided that the following conditions are met:
+**
+** 1. Redistributions of this source file must retain the above copyright
+**    notice, this list of conditions and the following disclaimer.
+**
+** 2. Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and/or other materials provided with the distribution.
+**
+** THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+** WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO
+** EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+** PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+** OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+** WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+** OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+** ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+** =============================================================================
+**/
+#include "FmGuiInput.hpp"
+#include "FmGuiAllocator.hpp"
+#include "FmGuiCore.hpp"
+#include "FmGuiTelemetry.hpp"
+
+#include <cfloat>
+#include <cstdio>
+#include <cstring>
+#include <atomic>
+#include <chrono>
+#include <vector>
+
+#include <imgui.h>
+
+namespace FmGui
+{
+namespace Input
+{
+// Functions
+static std::uint64_t PackMousePos(float x, float y);
+static void ApplyEvent(const FmGuiInputEvent &event);
+static void ApplyReplayFrame(void);
+static void WriteFrame(void);
+static void StoreU32(std::uint8_t *pOut, std::uint32_t value);
+static std::uint32_t LoadU32(const std::uint8_t *pIn);
+// Variables
+static constexpr char recordingMagic[8] = {
+	'F', 'M', 'G', 'U', 'I', 'I', 'N', 'P'
+};
+static constexpr std::uint32_t recordingVersion = 1;
+static constexpr std::uint32_t frameTag = 0x4D415246; // "FRAM"
+static constexpr std::size_t headerSize = 24;
+static constexpr std::size_t frameHeaderSize = 24;
+static constexpr std::size_t eventSize = 16;
+static Channel<FmGuiInputEvent, eventCapacity> events;
+// The latest mouse position, both floats packed into one atomic word.
+static std::atomic<std::uint64_t> latestMousePos(
+	PackMousePos(-FLT_MAX, -FLT_MAX));
+// Input thread: the position last queued ahead of a button or wheel event.
+static std::uint64_t queuedMousePos = PackMousePos(-FLT_MAX, -FLT_MAX);
+// Render thread: the position last passed to ImGui.
+static std::uint64_t appliedMousePos = PackMousePos(-FLT_MAX, -FLT_MAX);
+// Render thread: input recording. The header is written with the first frame.
+static std::FILE *pRecordingFile = nullptr;
+static Allocator::Vector<char> recordingBuffer;
+static Allocator::Vector<FmGuiInputEvent> frameEvents;
+static Allocator::Vector<std::uint8_t> frameBytes;
+static std::chrono::steady_clock::time_point recordingStart;
+static bool isHeaderPending = false;
+// Render thread: input replay, the frames index into replayEvents.
+struct ReplayFrame
+{
+	std::size_t firstEvent, eventCount;
+};
+static std::vector<FmGuiInputEvent> replayEvents;
+static std::vector<ReplayFrame> replayFrames;
+static std::size_t replayFrameIndex = 0;
+static float replayDisplayWidth = 0.0f, replayDisplayHeight = 0.0f;
+static bool isReplaying = false;
+} // namespace Input
+} // namespace FmGui
+
+static std::uint64_t
+FmGui::Input::PackMousePos(float x, float y)
+{
+	std::uint32_t xBits, yBits;
+	std::memcpy(&xBits, &x, sizeof(xBits));
+	std::memcpy(&yBits, &y, sizeof(yBits));
+	return (static_cast<std::uint64_t>(yBits) << 32) | xBits;
+}
+
+bool
+FmGui::Input::PushEvent(const FmGuiInputEvent &event)
+{
+	if (event.type == FmGuiInputEventType::MOUSE_BUTTON
+		|| event.type == FmGuiInputEventType::MOUSE_WHEEL) {
+		const std::uint64_t mousePos =
+			latestMousePos.load(std::memory_order_relaxed);
+		if (mousePos != queuedMousePos) {
+			FmGuiInputEvent posEvent = FmGuiInputEvent();
+			posEvent.type = FmGuiInputEventType::MOUSE_POS;
+			const std::uint32_t xBits = static_cast<std::uint32_t>(mousePos);
+			const std::uint32_t yBits =
+				static_cast<std::uint32_t>(mousePos >> 32);
+			std::memcpy(&posEvent.x, &xBits, sizeof(xBits));
+			std::memcpy(&posEvent.y, &yBits, sizeof(yBits));
+			if (!events.Publish(posEvent))
+				return false;
+			queuedMousePos = mousePos;
+		}
+	}
+	return events.Publish(event);
+}
+
+void
+FmGui::Input::PushMousePos(float x, float y)
+{
+	latestMousePos.store(PackMousePos(x, y), std::memory_order_relaxed);
+}
+
+void
+FmGui::Input::ApplyEvents(void)
+{
+	frameEvents.clear();
+	if (isReplaying) {
+		// Live input would disturb the recorded interaction.
+		DiscardEvents();
+		ApplyReplayFrame();
+	} else {
+		events.Drain(ApplyEvent);
+		// Moves since the last queued event only exist as the latest position.
+		const std::uint64_t mousePos =
+			latestMousePos.load(std::memory_order_relaxed);
+		if (mousePos != appliedMousePos) {
+			FmGuiInputEvent posEvent = FmGuiInputEvent();
+			posEvent.type = FmGuiInputEventType::MOUSE_POS;
+			const std::uint32_t xBits = static_cast<std::uint32_t>(mousePos);
+			const std::uint32_t yBits =
+				static_cast<std::uint32_t>(mousePos >> 32);
+			std::memcpy(&posEvent.x, &xBits, sizeof(xBits));
+			std::memcpy(&posEvent.y, &yBits, sizeof(yBits));
+			ApplyEvent(posEvent);
+		}
+	}
+	if (pRecordingFile != nullptr)
+		WriteFrame();
+}
+
+void
+FmGui::Input::DiscardEvents(void)
+{
+	events.Drain([](const FmGuiInputEvent &) {});
+}
+
+bool
+FmGui::Input::HasPendingEvents(void)
+{
+	return isReplaying || !events.IsEmpty()
+		|| latestMousePos.load(std::memory_order_relaxed) != appliedMousePos;
+}
+
+std::uint64_t
+FmGui::Input::GetDroppedEventCount(void)
+{
+	return events.GetDroppedCount();
+}
+
+bool
+FmGui::Input::StartRecording(const char *fileName)
+{
+	StopRecording();
+	pRecordingFile = std::fopen(fileName, "wb");
+	if (pRecordingFile == nullptr) {
+		FMGUI_PUSH_MSGF(FmGuiMessageSeverity::HIGH,
+						"Failed to create input recording \"%s\".", fileName);
+		return false;
+	}
+	recordingBuffer.resize(1 << 20);
+	std::setvbuf(pRecordingFile, recordingBuffer.data(), _IOFBF,
+				 recordingBuffer.size());
+	frameEvents.reserve(eventCapacity * 2);
+	recordingStart = std::chrono::steady_clock::now();
+	isHeaderPending = true;
+	FMGUI_PUSH_MSGF(FmGuiMessageSeverity::NOTIFICATION,
+					"Recording input to \"%s\".", fileName);
+	return true;
+}
+
+void
+FmGui::Input::StopRecording(void)
+{
+	if (pRecordingFile == nullptr)
+		return;
+	if (std::fclose(pRecordingFile) != 0) {
+		FMGUI_PUSH_MSG(FmGuiMessageSeverity::HIGH,
+					   "Failed to write the end of the input recording.");
+	}
+	pRecordingFile = nullptr;
+	recordingBuffer.clear();
+	recordingBuffer.shrink_to_fit();
+}
+
+bool
+FmGui::Input::IsRecording(void)
+{
+	return pRecordingFile != nullptr;
+}
+
+bool
+FmGui::Input::StartReplay(const char *fileName)
+{
+	StopReplay();
+	std::FILE *pFile = std::fopen(fileName, "rb");
+	if (pFile == nullptr) {
+		FMGUI_PUSH_MSGF(FmGuiMessageSeverity::HIGH,
+						"Failed to open input recording \"%s\".", fileName);
+		return false;
+	}
+	std::uint8_t header[headerSize];
+	if (std::fread(header, sizeof(header), 1, pFile) != 1
+		|| std::memcmp(header, recordingMagic, sizeof(recordingMagic)) != 0
+		|| LoadU32(header + 8) != recordingVersion) {
+		FMGUI_PUSH_MSGF(FmGuiMessageSeverity::HIGH,
+						"\"%s\" is not an input recording.", fileName);
+		std::fclose(pFile);
+		return false;
+	}
+	std::memcpy(&replayDisplayWidth, header + 16, sizeof(float));
+	std::memcpy(&replayDisplayHeight, header + 20, sizeof(float));
+	// A frame cut short, e.g. by a crash, ends the replay.
+	std::uint8_t frameHeader[frameHeaderSize], eventBytes[eventSize];
+	while (std::fread(frameHeader, sizeof(frameHeader), 1, pFile) == 1
+		   && LoadU32(frameHeader) == frameTag) {
+		ReplayFrame frame;
+		frame.firstEvent = replayEvents.size();
+		frame.eventCount = LoadU32(frameHeader + 4);
+		std::size_t index = 0;
+		for (; index < frame.eventCount; ++index) {
+			if (std::fread(eventBytes, sizeof(eventBytes), 1, pFile) != 1)
+				break;
+			FmGuiInputEvent event;
+			event.type = static_cast<FmGuiInputEventType>(eventBytes[0]);
+			event.isDown = eventBytes[1] != 0;
+			std::memcpy(&event.code, eventBytes + 2, sizeof(event.code));
+			std::memcpy(&event.nativeCode, eventBytes + 4,
+						sizeof(event.nativeCode));
+			std::memcpy(&event.x, eventBytes + 8, sizeof(event.x));
+			std::memcpy(&event.y, eventBytes + 12, sizeof(event.y));
+			if (event.type > FmGuiInputEventType::FOCUS)
+				break;
+			replayEvents.push_back(event);
+		}
+		if (index != frame.eventCount) {
+			replayEvents.resize(frame.firstEvent);
+			break;
+		}
+		replayFrames.push_back(frame);
+	}
+	std::fclose(pFile);
+	replayFrameIndex = 0;
+	isReplaying = true;
+	FMGUI_PUSH_MSGF(FmGuiMessageSeverity::NOTIFICATION,
+					"Replaying %u frames of input from \"%s\".",
+					static_cast<unsigned int>(replayFrames.size()), fileName);
+	return true;
+}
+
+void
+FmGui::Input::StopReplay(void)
+{
+	replayEvents.clear();
+	replayFrames.clear();
+	replayFrameIndex = 0;
+	isReplaying = false;
+}
+
+bool
+FmGui::Input::IsReplaying(void)
+{
+	return isReplaying;
+}
+
+static void
+FmGui::Input::ApplyEvent(const FmGuiInputEvent &event)
+{
+	if (pRecordingFile != nullptr)
+		frameEvents.push_back(event);
+	ImGuiIO &imGuiIO = ImGui::GetIO();
+	switch (event.type) {
+	case FmGuiInputEventType::MOUSE_POS:
+		imGuiIO.AddMousePosEvent(event.x, event.y);
+		appliedMousePos = PackMousePos(event.x, event.y);
+		break;
+	case FmGuiInputEventType::MOUSE_BUTTON:
+		imGuiIO.AddMouseButtonEvent(event.code, event.isDown);
+		break;
+	case FmGuiInputEventType::MOUSE_WHEEL:
+		imGuiIO.AddMouseWheelEvent(event.x, event.y);
+		break;
+	case FmGuiInputEventType::KEY:
+		imGuiIO.AddKeyEvent(static_cast<ImGuiKey>(event.code), event.isDown);
+		imGuiIO.SetKeyEventNativeData(static_cast<ImGuiKey>(event.code),
+									  event.nativeCode, -1);
+		break;
+	case FmGuiInputEventType::KEY_MODS:
+		imGuiIO.AddKeyModsEvent(static_cast<ImGuiKeyModFlags>(event.code));
+		break;
+	case FmGuiInputEventType::CHARACTER:
+		imGuiIO.AddInputCharacterUTF16(static_cast<ImWchar16>(event.code));
+		break;
+	case FmGuiInputEventType::FOCUS:
+		imGuiIO.AddFocusEvent(event.isDown);
+		break;
+	}
+}
+
+static void
+FmGui::Input::ApplyReplayFrame(void)
+{
+	if (replayFrameIndex >= replayFrames.size()) {
+		StopReplay();
+		return;
+	}
+	ImGui::GetIO().DisplaySize = ImVec2(replayDisplayWidth,
+										replayDisplayHeight);
+	const ReplayFrame &frame = replayFrames[replayFrameIndex++];
+	for (std::size_t index = 0; index < frame.eventCount; ++index)
+		ApplyEvent(replayEvents[frame.firstEvent + index]);
+}
+
+static void
+FmGui::Input::WriteFrame(void)
+{
+	const ImGuiIO &imGuiIO = ImGui::GetIO();
+	frameBytes.clear();
+	if (isHeaderPending) {
+		frameBytes.resize(headerSize, 0);
+		std::memcpy(frameBytes.data(), recordingMagic, sizeof(recordingMagic));
+		StoreU32(frameBytes.data() + 8, recordingVersion);
+		std::memcpy(frameBytes.data() + 16, &imGuiIO.DisplaySize.x,
+					sizeof(float));
+		std::memcpy(frameBytes.data() + 20, &imGuiIO.DisplaySize.y,
+					sizeof(float));
+		isHeaderPending = false;
+	}
+	const double time = std::chrono::duration<double>(
+		std::chrono::steady_clock::now() - recordingStart).count();
+	const std::size_t offset = frameBytes.size();
+	frameBytes.resize(offset + frameHeaderSize + frameEvents.size() * eventSize,
+					  0);
+	std::uint8_t *pOut = frameBytes.data() + offset;
+	StoreU32(pOut, frameTag);
+	StoreU32(pOut + 4, static_cast<std::uint32_t>(frameEvents.size()));
+	std::memcpy(pOut + 8, &time, sizeof(time));
+	std::memcpy(pOut + 16, &imGuiIO.DeltaTime, sizeof(float));
+	pOut += frameHeaderSize;
+	for (const FmGuiInputEvent &event : frameEvents) {
+		pOut[0] = static_cast<std::uint8_t>(event.type);
+		pOut[1] = event.isDown ? 1 : 0;
+		std::memcpy(pOut + 2, &event.code, sizeof(event.code));
+		std::memcpy(pOut + 4, &event.nativeCode, sizeof(event.nativeCode));
+		std::memcpy(pOut + 8, &event.x, sizeof(event.x));
+		std::memcpy(pOut + 12, &event.y, sizeof(event.y));
+		pOut += eventSize;
+	}
+	if (std::fwrite(frameBytes.data(), frameBytes.size(), 1,
+					pRecordingFile) != 1) {
+		FMGUI_PUSH_MSG(FmGuiMessageSeverity::HIGH,
+					   "Failed to write the input recording, stopping.");
+		StopRecording();
+	}
+}
+
+static void
+FmGui::Input::StoreU32(std::uint8_t *pOut, std::uint32_t value)
+{
+	std::memcpy(pOut, &value, sizeof(value));
+}
+
+static std::uint32_t
+FmGui::Input::LoadU32(const std::uint8_t *pIn)
+{
+	std::uint32_t value;
+	std::memcpy(&value, pIn, sizeof(value));
+	return value;
+}
@@ -0,0 +1,628 @@
+/* =============================================================================
+** DCS-EFM-ImGui, file: FmGuiPanels.cpp Created: 17-OCT-2026
+**
+** Copyright 2022 Brian Hoffpauir, USA
+** All rights reserved.
+**
+** Redistribution and use of this source file, with or without modification, is
+** permitted provided that the following conditions are met:
+**
+** 1. Redistributions of this source file must retain the above copyright
+**    notice, this list of conditions and the following disclaimer.
+**
+** 2. Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and/or other materials provided with the distribution.
+**
+** THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+** WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO
+** EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+** PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+** OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+** WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+** OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+** ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+** =============================================================================
+**/
+#include "FmGuiPanels.hpp"
+#include "FmGuiAllocator.hpp"
+#include "FmGuiProfiler.hpp"
+
+#include <cstring>
+#include <atomic>
+#include <chrono>
+
+#include <imgui.h>
+#include <imgui_internal.h>
+
+namespace FmGui
+{
+namespace Panels
+{
+// A root window of a panel and the draw lists of its last run.
+struct PanelWindow
+{
+	ImGuiWindow *pWindow;
+	// Owned and reused from run to run, only the first drawListCount are set.
+	Allocator::Vector<ImDrawList *> drawLists;
+	std::size_t drawListCount;
+	// Began during the last run.
+	bool isCurrent;
+};
+struct Panel
+{
+	const char *name;
+	IFmGuiable *pPanel;
+	FmGuiRoutinePtr pRoutine;
+	std::atomic<bool> isVisible;
+	std::atomic<float> refreshRate;
+	bool isRegistered;
+	// The windows hold the output of a run since the panel was last shown.
+	bool isOutputValid;
+	// Scheduling of the current frame.
+	bool isDue, isUrgent, hasRun;
+	bool isOverBudgetReported;
+	double nextRunTime;
+	float lastCost, averageCost;
+	std::uint64_t runCount, cachedFrameCount;
+	std::uint64_t deferredFrameCount, overBudgetRunCount;
+	Allocator::Vector<PanelWindow> windows;
+};
+// A draw list of the current frame and the panel window it belongs to.
+struct PanelDrawList
+{
+	ImDrawList *pDrawList;
+	Panel *pPanel;
+	std::size_t windowIndex;
+};
+// Functions
+static Panel *FindPanel(const char *name);
+static bool RegisterPanel(const char *name, IFmGuiable *pPanel,
+						  FmGuiRoutinePtr pRoutine,
+						  const FmGuiPanelConfig &config);
+static void FreeWindows(Panel &panel);
+static bool IsInteracting(const Panel &panel, const ImGuiContext &context);
+static bool OwnsWindow(const Panel &panel, const ImGuiWindow *pWindow);
+static void RunPanel(Panel &panel, const ImGuiContext &context, double time,
+					 float budget);
+static void CollectWindows(Panel &panel, const ImGuiContext &context,
+						   int firstBeginOrder);
+static void RedrawPanel(Panel &panel);
+static void CopyDrawList(const ImDrawList &source, ImDrawList &destination);
+static float MicrosecondsSince(std::chrono::steady_clock::time_point start);
+// Variables
+static Panel panels[panelCapacity];
+static std::atomic<bool> isListVisible(false);
+// Lists of the panels that ran this frame, to copy after ImGui::Render.
+static Allocator::Vector<PanelDrawList> capturedDrawLists;
+// Lists of windows kept open this frame, to replace with the last run's.
+static Allocator::Vector<PanelDrawList> replacedDrawLists;
+static ImVector<ImDrawList *> composedDrawLists;
+static ImDrawData composedDrawData;
+// Weight of the newest cost in the moving average.
+static constexpr float costSmoothing = 0.1f;
+// Next slot in turn for the budget, and what the panels cost last frame.
+static std::size_t nextSlot = 0;
+static float frameCost = 0.0f, frameBudget = 0.0f;
+} // namespace Panels
+} // namespace FmGui
+
+static FmGui::Panels::Panel *
+FmGui::Panels::FindPanel(const char *name)
+{
+	for (Panel &panel : panels) {
+		if (panel.isRegistered && std::strcmp(panel.name, name) == 0)
+			return &panel;
+	}
+	return nullptr;
+}
+
+static bool
+FmGui::Panels::RegisterPanel(const char *name, IFmGuiable *pPanel,
+							 FmGuiRoutinePtr pRoutine,
+							 const FmGuiPanelConfig &config)
+{
+	if (name == nullptr || (pPanel == nullptr && pRoutine == nullptr)) {
+		FMGUI_PUSH_MSG(FmGuiMessageSeverity::MEDIUM,
+					   "A panel needs a name and a routine.");
+		return false;
+	}
+	if (FindPanel(name) != nullptr) {
+		FMGUI_PUSH_MSGF(FmGuiMessageSeverity::MEDIUM,
+						"A panel named \"%s\" is already registered.", name);
+		return false;
+	}
+	for (Panel &panel : panels) {
+		if (panel.isRegistered)
+			continue;
+		panel.name = name;
+		panel.pPanel = pPanel;
+		panel.pRoutine = pRoutine;
+		panel.isVisible.store(config.isVisible, std::memory_order_relaxed);
+		panel.refreshRate.store(config.refreshRate,
+								std::memory_order_relaxed);
+		panel.isRegistered = true;
+		panel.isOutputValid = false;
+		panel.isOverBudgetReported = false;
+		panel.nextRunTime = -1.0;
+		panel.lastCost = panel.averageCost = 0.0f;
+		panel.runCount = panel.cachedFrameCount = 0;
+		panel.deferredFrameCount = panel.overBudgetRunCount = 0;
+		return true;
+	}
+	FMGUI_PUSH_MSGF(FmGuiMessageSeverity::MEDIUM,
+					"Panel \"%s\" not registered, all %u slots are taken.",
+					name, static_cast<unsigned int>(panelCapacity));
+	return false;
+}
+
+bool
+FmGui::Panels::Register(const char *name, IFmGuiable *pPanel,
+						const FmGuiPanelConfig &config)
+{
+	return RegisterPanel(name, pPanel, nullptr, config);
+}
+
+bool
+FmGui::Panels::Register(const char *name, FmGuiRoutinePtr pRoutine,
+						const FmGuiPanelConfig &config)
+{
+	return RegisterPanel(name, nullptr, pRoutine, config);
+}
+
+bool
+FmGui::Panels::Unregister(const char *name)
+{
+	Panel *pPanel = FindPanel(name);
+	if (pPanel == nullptr)
+		return false;
+	FreeWindows(*pPanel);
+	pPanel->isRegistered = false;
+	return true;
+}
+
+bool
+FmGui::Panels::SetVisibility(const char *name, bool isVisible)
+{
+	Panel *pPanel = FindPanel(name);
+	if (pPanel == nullptr)
+		return false;
+	pPanel->isVisible.store(isVisible, std::memory_order_relaxed);
+	return true;
+}
+
+bool
+FmGui::Panels::SetRefreshRate(const char *name, float refreshRate)
+{
+	Panel *pPanel = FindPanel(name);
+	if (pPanel == nullptr)
+		return false;
+	pPanel->refreshRate.store(refreshRate, std::memory_order_relaxed);
+	return true;
+}
+
+std::size_t
+FmGui::Panels::GetStats(FmGuiPanelStats *pStats, std::size_t capacity)
+{
+	std::size_t count = 0;
+	for (const Panel &panel : panels) {
+		if (!panel.isRegistered)
+			continue;
+		if (count < capacity) {
+			FmGuiPanelStats &stats = pStats[count];
+			stats.name = panel.name;
+			stats.isVisible = panel.isVisible.load(std::memory_order_relaxed);
+			stats.refreshRate =
+				panel.refreshRate.load(std::memory_order_relaxed);
+			stats.lastCost = panel.lastCost;
+			stats.averageCost = panel.averageCost;
+			stats.runCount = panel.runCount;
+			stats.cachedFrameCount = panel.cachedFrameCount;
+			stats.deferredFrameCount = panel.deferredFrameCount;
+			stats.overBudgetRunCount = panel.overBudgetRunCount;
+		}
+		++count;
+	}
+	return count;
+}
+
+bool
+FmGui::Panels::SetListVisibility(bool isVisible)
+{
+	return isListVisible.exchange(isVisible, std::memory_order_relaxed);
+}
+
+static void
+FmGui::Panels::FreeWindows(Panel &panel)
+{
+	for (PanelWindow &window : panel.windows) {
+		for (ImDrawList *pDrawList : window.drawLists)
+			IM_DELETE(pDrawList);
+	}
+	panel.windows.clear();
+	panel.isOutputValid = false;
+	panel.nextRunTime = -1.0;
+}
+
+/*
+ * Whether the user is working with one of the panel's windows, based on the
+ * state ImGui::NewFrame computed from the previous frame.
+ */
+static bool
+FmGui::Panels::IsInteracting(const Panel &panel, const ImGuiContext &context)
+{
+	return OwnsWindow(panel, context.HoveredWindow)
+		|| OwnsWindow(panel, context.NavWindow)
+		|| OwnsWindow(panel, context.MovingWindow)
+		|| OwnsWindow(panel, context.ActiveIdWindow);
+}
+
+static bool
+FmGui::Panels::OwnsWindow(const Panel &panel, const ImGuiWindow *pWindow)
+{
+	if (pWindow == nullptr)
+		return false;
+	for (const PanelWindow &window : panel.windows) {
+		if (window.isCurrent && window.pWindow == pWindow->RootWindow)
+			return true;
+	}
+	return false;
+}
+
+/*
+ * Panels being interacted with and panels without output run first, whatever
+ * the budget. The other due panels take turns for the rest of it, starting
+ * after the last one that ran, and at least one of them runs every frame so
+ * none starves. Deferred panels stay due and show their last output.
+ */
+void
+FmGui::Panels::Run(float budget)
+{
+	const ImGuiContext &context = *GImGui;
+	capturedDrawLists.clear();
+	replacedDrawLists.clear();
+	frameBudget = budget;
+	frameCost = 0.0f;
+	const double time = ImGui::GetTime();
+	const bool isPopupOpen = ImGui::IsPopupOpen("", ImGuiPopupFlags_AnyPopup);
+	for (Panel &panel : panels) {
+		panel.isDue = panel.isUrgent = panel.hasRun = false;
+		if (!panel.isRegistered)
+			continue;
+		if (!panel.isVisible.load(std::memory_order_relaxed)) {
+			// Shown again, it runs right away.
+			panel.isOutputValid = false;
+			continue;
+		}
+		const float refreshRate =
+			panel.refreshRate.load(std::memory_order_relaxed);
+		panel.isUrgent = !panel.isOutputValid || isPopupOpen
+			|| IsInteracting(panel, context);
+		panel.isDue = panel.isUrgent || refreshRate <= 0.0f
+			|| time >= panel.nextRunTime;
+	}
+
+	for (Panel &panel : panels) {
+		if (panel.isUrgent)
+			RunPanel(panel, context, time, budget);
+	}
+	bool hasTakenTurn = false;
+	for (std::size_t count = 0; count < panelCapacity; ++count) {
+		const std::size_t slot = (nextSlot + count) % panelCapacity;
+		Panel &panel = panels[slot];
+		if (!panel.isRegistered || !panel.isDue || panel.hasRun)
+			continue;
+		if (budget > 0.0f && hasTakenTurn
+			&& frameCost + panel.averageCost > budget) {
+			++panel.deferredFrameCount;
+			continue;
+		}
+		RunPanel(panel, context, time, budget);
+		hasTakenTurn = true;
+		nextSlot = (slot + 1) % panelCapacity;
+	}
+	for (Panel &panel : panels) {
+		if (panel.isRegistered && panel.isOutputValid && !panel.hasRun
+			&& panel.isVisible.load(std::memory_order_relaxed)) {
+			RedrawPanel(panel);
+		}
+	}
+}
+
+static void
+FmGui::Panels::RunPanel(Panel &panel, const ImGuiContext &context,
+						double time, float budget)
+{
+	const int firstBeginOrder = context.WindowsActiveCount;
+	const std::chrono::steady_clock::time_point start =
+		std::chrono::steady_clock::now();
+	Profiler::BeginScope(panel.name);
+	if (panel.pPanel != nullptr)
+		panel.pPanel->VFmGui();
+	else
+		panel.pRoutine();
+	Profiler::EndScope();
+	const float cost = MicrosecondsSince(start);
+	frameCost += cost;
+	// The panel may have unregistered itself.
+	if (!panel.isRegistered)
+		return;
+
+	panel.hasRun = true;
+	panel.isOutputValid = true;
+	panel.lastCost = cost;
+	panel.averageCost = (panel.runCount == 0) ? cost
+		: panel.averageCost + (cost - panel.averageCost) * costSmoothing;
+	++panel.runCount;
+	const float refreshRate =
+		panel.refreshRate.load(std::memory_order_relaxed);
+	if (refreshRate > 0.0f && time >= panel.nextRunTime) {
+		// Keep the rate steady, unless the panel fell a whole period behind.
+		// Runs forced early leave the schedule alone.
+		const double interval = 1.0 / refreshRate;
+		panel.nextRunTime = (time - panel.nextRunTime < interval)
+			? panel.nextRunTime + interval : time + interval;
+	}
+	if (budget > 0.0f) {
+		if (cost > budget)
+			++panel.overBudgetRunCount;
+		if (panel.averageCost > budget && !panel.isOverBudgetReported) {
+			FMGUI_PUSH_MSGF(FmGuiMessageSeverity::MEDIUM,
+							"Panel \"%s\" takes %.0f us on average, over the "
+							"frame budget of %.0f us.", panel.name,
+							panel.averageCost, budget);
+		}
+		panel.isOverBudgetReported = panel.averageCost > budget;
+	}
+	CollectWindows(panel, context, firstBeginOrder);
+}
+
+/*
+ * Finds the windows the panel began during its run, by the order ImGui
+ * assigns to every window at its first Begin of a frame.
+ */
+static void
+FmGui::Panels::CollectWindows(Panel &panel, const ImGuiContext &context,
+							  int firstBeginOrder)
+{
+	const int endBeginOrder = context.WindowsActiveCount;
+	for (PanelWindow &window : panel.windows) {
+		window.drawListCount = 0;
+		window.isCurrent = false;
+	}
+	for (int index = 0; index < context.Windows.Size; ++index) {
+		ImGuiWindow *const pWindow = context.Windows[index];
+		ImGuiWindow *const pRootWindow = pWindow->RootWindow;
+		if (pWindow->LastFrameActive != context.FrameCount
+			|| pWindow->BeginOrderWithinContext < firstBeginOrder
+			|| pWindow->BeginOrderWithinContext >= endBeginOrder
+			|| pRootWindow->BeginOrderWithinContext < firstBeginOrder
+			|| (pRootWindow->Flags
+				& (ImGuiWindowFlags_Popup | ImGuiWindowFlags_Tooltip))) {
+			continue;
+		}
+		std::size_t windowIndex = 0;
+		while (windowIndex < panel.windows.size()
+			   && panel.windows[windowIndex].pWindow != pRootWindow) {
+			++windowIndex;
+		}
+		if (windowIndex == panel.windows.size()) {
+			PanelWindow window;
+			window.pWindow = pRootWindow;
+			window.drawListCount = 0;
+			window.isCurrent = false;
+			panel.windows.push_back(window);
+		}
+		panel.windows[windowIndex].isCurrent = true;
+		const PanelDrawList drawList = {
+			pWindow->DrawList, &panel, windowIndex
+		};
+		capturedDrawLists.push_back(drawList);
+	}
+}
+
+/*
+ * Keeps the windows of the last run open without their contents, so ImGui
+ * still lays them out and routes the mouse to them, and marks their draw
+ * lists to be replaced by the last run's.
+ */
+static void
+FmGui::Panels::RedrawPanel(Panel &panel)
+{
+	++panel.cachedFrameCount;
+	for (std::size_t index = 0; index < panel.windows.size(); ++index) {
+		const PanelWindow &window = panel.windows[index];
+		if (!window.isCurrent || window.drawListCount == 0)
+			continue;
+		ImGuiWindow *const pWindow = window.pWindow;
+		// Without contents, the size and scrolling would collapse.
+		ImGui::SetNextWindowSize(pWindow->SizeFull);
+		ImGui::SetNextWindowContentSize(pWindow->ContentSize);
+		ImGui::Begin(pWindow->Name, nullptr,
+					 pWindow->Flags & ~ImGuiWindowFlags_AlwaysAutoResize);
+		const PanelDrawList drawList = { pWindow->DrawList, &panel, index };
+		replacedDrawLists.push_back(drawList);
+		ImGui::End();
+	}
+}
+
+ImDrawData *
+FmGui::Panels::PrepareDrawData(ImDrawData *pDrawData)
+{
+	if (pDrawData == nullptr)
+		return pDrawData;
+	for (int index = 0; index < pDrawData->CmdListsCount; ++index) {
+		const ImDrawList *const pSource = pDrawData->CmdLists[index];
+		for (const PanelDrawList &captured : capturedDrawLists) {
+			if (captured.pDrawList != pSource)
+				continue;
+			PanelWindow &window =
+				captured.pPanel->windows[captured.windowIndex];
+			if (window.drawListCount == window.drawLists.size()) {
+				window.drawLists.push_back(
+					IM_NEW(ImDrawList)(ImGui::GetDrawListSharedData()));
+			}
+			CopyDrawList(*pSource,
+						 *window.drawLists[window.drawListCount++]);
+			break;
+		}
+	}
+	if (replacedDrawLists.empty())
+		return pDrawData;
+
+	composedDrawLists.resize(0);
+	for (int index = 0; index < pDrawData->CmdListsCount; ++index) {
+		ImDrawList *const pDrawList = pDrawData->CmdLists[index];
+		const PanelWindow *pWindow = nullptr;
+		for (const PanelDrawList &replaced : replacedDrawLists) {
+			if (replaced.pDrawList == pDrawList && replaced.pPanel->isRegistered
+				&& replaced.windowIndex < replaced.pPanel->windows.size()) {
+				pWindow = &replaced.pPanel->windows[replaced.windowIndex];
+				break;
+			}
+		}
+		if (pWindow == nullptr) {
+			composedDrawLists.push_back(pDrawList);
+			continue;
+		}
+		for (std::size_t list = 0; list < pWindow->drawListCount; ++list)
+			composedDrawLists.push_back(pWindow->drawLists[list]);
+	}
+	composedDrawData = *pDrawData;
+	composedDrawData.CmdLists = composedDrawLists.Data;
+	composedDrawData.CmdListsCount = composedDrawLists.Size;
+	composedDrawData.TotalVtxCount = composedDrawData.TotalIdxCount = 0;
+	for (int index = 0; index < composedDrawLists.Size; ++index) {
+		composedDrawData.TotalVtxCount +=
+			composedDrawLists[index]->VtxBuffer.Size;
+		composedDrawData.TotalIdxCount +=
+			composedDrawLists[index]->IdxBuffer.Size;
+	}
+	return &composedDrawData;
+}
+
+/*
+ * Copies the buffers a renderer reads. Unlike ImVector's assignment, which
+ * frees and allocates every time, resize keeps the capacity.
+ */
+static void
+FmGui::Panels::CopyDrawList(const ImDrawList &source, ImDrawList &destination)
+{
+	destination.CmdBuffer.resize(source.CmdBuffer.Size);
+	destination.IdxBuffer.resize(source.IdxBuffer.Size);
+	destination.VtxBuffer.resize(source.VtxBuffer.Size);
+	if (source.CmdBuffer.Size > 0) {
+		std::memcpy(destination.CmdBuffer.Data, source.CmdBuffer.Data,
+					source.CmdBuffer.size_in_bytes());
+	}
+	if (source.IdxBuffer.Size > 0) {
+		std::memcpy(destination.IdxBuffer.Data, source.IdxBuffer.Data,
+					source.IdxBuffer.size_in_bytes());
+	}
+	if (source.VtxBuffer.Size > 0) {
+		std::memcpy(destination.VtxBuffer.Data, source.VtxBuffer.Data,
+					source.VtxBuffer.size_in_bytes());
+	}
+	destination.Flags = source.Flags;
+}
+
+static float
+FmGui::Panels::MicrosecondsSince(std::chrono::steady_clock::time_point start)
+{
+	return std::chrono::duration<float, std::micro>(
+		std::chrono::steady_clock::now() - start).count();
+}
+
+void
+FmGui::Panels::ShowList(void)
+{
+	if (!isListVisible.load(std::memory_order_relaxed))
+		return;
+	bool isVisible = true;
+	if (ImGui::Begin("FmGui Panels", &isVisible,
+					 ImGuiWindowFlags_AlwaysAutoResize)) {
+		const ImGuiTableFlags tableFlags =
+			ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg;
+		if (frameBudget > 0.0f) {
+			ImGui::Text("Panels took %.1f of %.0f us last frame.", frameCost,
+						frameBudget);
+		} else {
+			ImGui::Text("Panels took %.1f us last frame.", frameCost);
+		}
+		if (ImGui::BeginTable("Panels", 8, tableFlags)) {
+			ImGui::TableSetupColumn("Panel");
+			ImGui::TableSetupColumn("Visible");
+			ImGui::TableSetupColumn("Hz");
+			ImGui::TableSetupColumn("Last us");
+			ImGui::TableSetupColumn("Avg us");
+			ImGui::TableSetupColumn("Runs / cached");
+			ImGui::TableSetupColumn("Deferred");
+			ImGui::TableSetupColumn("Over budget");
+			ImGui::TableHeadersRow();
+			for (std::size_t index = 0; index < panelCapacity; ++index) {
+				Panel &panel = panels[index];
+				if (!panel.isRegistered)
+					continue;
+				ImGui::PushID(static_cast<int>(index));
+				ImGui::TableNextRow();
+				ImGui::TableNextColumn();
+				ImGui::TextUnformatted(panel.name);
+				ImGui::TableNextColumn();
+				bool isPanelVisible =
+					panel.isVisible.load(std::memory_order_relaxed);
+				if (ImGui::Checkbox("##Visible", &isPanelVisible)) {
+					panel.isVisible.store(isPanelVisible,
+										  std::memory_order_relaxed);
+				}
+				ImGui::TableNextColumn();
+				const float refreshRate =
+					panel.refreshRate.load(std::memory_order_relaxed);
+				if (refreshRate > 0.0f)
+					ImGui::Text("%.1f", refreshRate);
+				else
+					ImGui::TextUnformatted("Every frame");
+				ImGui::TableNextColumn();
+				ImGui::Text("%.1f", panel.lastCost);
+				ImGui::TableNextColumn();
+				ImGui::Text("%.1f", panel.averageCost);
+				ImGui::TableNextColumn();
+				ImGui::Text("%llu / %llu",
+							static_cast<unsigned long long>(panel.runCount),
+							static_cast<unsigned long long>(
+								panel.cachedFrameCount));
+				ImGui::TableNextColumn();
+				ImGui::Text("%llu", static_cast<unsigned long long>(
+					panel.deferredFrameCount));
+				ImGui::TableNextColumn();
+				ImGui::Text("%llu", static_cast<unsigned long long>(
+					panel.overBudgetRunCount));
+				ImGui::PopID();
+			}
+			ImGui::EndTable();
+		}
+	}
+	ImGui::End();
+	if (!isVisible)
+		isListVisible.store(false, std::memory_order_relaxed);
+}
+
+void
+FmGui::Panels::Shutdown(void)
+{
+	for (Panel &panel : panels)
+		FreeWindows(panel);
+	capturedDrawLists.clear();
+	replacedDrawLists.clear();
+	composedDrawLists.clear();
+}
+
+/*
+ * FmGuiPanelConfig's members, defined next to the registry that uses them.
+ */
+FmGuiPanelConfig::FmGuiPanelConfig(void)
+	: isVisible(true),
+	  refreshRate(0.0f)
+{
+}
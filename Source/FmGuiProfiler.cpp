@@ -0,0 +1,798 @@
+/* =============================================================================
+** DCS-EFM-ImGui, file: FmGuiProfiler.cpp Created: 17-OCT-2026
+**
+** Copyright 2022 Brian Hoffpauir, USA
+** All rights reserved.
+**
+** Redistribution and use of this source file, with or without modification, is
+** permitted provided that the following conditions are met:
+**
+** 1. Redistributions of this source file must retain the above copyright
+**    notice, this list of conditions and the following disclaimer.
+**
+** 2. Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and/or other materials provided with the distribution.
+**
+** THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+** WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO
+** EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+** PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+** OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+** WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+** OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+** ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+** =============================================================================
+**/
+#include "FmGuiProfiler.hpp"
+#include "FmGuiCore.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/* ImGui Headers here: */
+#include <imgui.h>
+
+namespace FmGui
+{
+namespace Profiler
+{
+/*
+ * Single producer, single consumer event ring of one thread. head is only
+ * written by the owning thread and tail only by the render thread, each on
+ * its own cache line.
+ */
+struct alignas(64) ThreadBuffer
+{
+	std::atomic<bool> isClaimed;
+	// Incremented on every claim, so the collector can tell threads apart.
+	std::atomic<std::uint32_t> generation;
+	std::atomic<const char *> name;
+	std::atomic<std::uint64_t> droppedCount;
+	alignas(64) std::atomic<std::uint64_t> head;
+	// Recorded and dropped scopes still open, only used by the owner.
+	std::uint32_t openCount, skippedCount;
+	alignas(64) std::atomic<std::uint64_t> tail;
+	FmGuiProfileEvent events[threadBufferSize];
+};
+
+/*
+ * Releases the buffer of a thread when the thread exits.
+ */
+struct ThreadBufferOwner
+{
+	ThreadBuffer *pBuffer = nullptr;
+	bool hasClaimFailed = false;
+	~ThreadBufferOwner(void);
+};
+
+/*
+ * Scopes collected from one thread buffer, only used by the render thread.
+ */
+struct ThreadHistory
+{
+	static constexpr std::size_t scopeCapacity = 4096;
+	static constexpr std::size_t tickCapacity = 64;
+	static constexpr std::size_t depthLimit = 32;
+	std::uint32_t generation;
+	const char *openNames[depthLimit];
+	std::uint64_t openStarts[depthLimit];
+	// May exceed depthLimit, scopes deeper than the limit are not kept.
+	std::uint32_t openDepth;
+	FmGuiProfileScope scopes[scopeCapacity];
+	std::uint64_t scopeCount;
+	std::uint64_t ticks[tickCapacity];
+	std::uint64_t tickCount;
+	// Trace the thread joined, scopes written to it and still open, and
+	// scopes left out of it along with everything nested in them.
+	std::uint32_t traceSerial;
+	std::uint32_t traceDepth, traceSkippedCount;
+};
+
+enum struct TraceState
+{
+	IDLE,
+	RECORDING,
+	STOPPING
+};
+
+struct TraceRecord
+{
+	FmGuiProfileEvent event;
+	// Chrome trace tid, unique per thread buffer claim.
+	std::uint32_t threadId;
+};
+
+struct TraceChunk
+{
+	static constexpr std::size_t recordCapacity = 4096;
+	std::size_t recordCount;
+	TraceRecord records[recordCapacity];
+};
+
+/*
+ * Single producer, single consumer queue of trace chunk indices. One queue
+ * hands full chunks to the writer, the other hands them back.
+ */
+struct TraceChunkQueue
+{
+	static constexpr std::size_t capacity = 8; // Also the trace chunk count.
+	std::atomic<std::uint64_t> head, tail;
+	std::size_t chunkIndices[capacity];
+
+	bool Push(std::size_t chunkIndex);
+	bool Pop(std::size_t &chunkIndex);
+};
+// Functions
+static std::uint64_t Now(void);
+static ThreadBuffer *GetThreadBuffer(void);
+static bool PushEvent(ThreadBuffer *pBuffer, FmGuiProfileEventType type,
+					  const char *name, std::size_t reserve);
+static void CollectEvent(ThreadHistory &history,
+						 const FmGuiProfileEvent &event);
+static ImU32 GetScopeColor(const char *name);
+static void ShowFlameGraph(const ThreadHistory &history, int tickCount);
+static bool TraceEvent(const FmGuiProfileEvent &event, std::uint32_t threadId);
+static void BeginThreadTrace(ThreadHistory &history, std::uint32_t threadId);
+static void TraceCollectedEvent(ThreadHistory &history,
+								const FmGuiProfileEvent &event,
+								std::uint32_t threadId);
+static void EndThreadTrace(ThreadHistory &history, std::uint32_t threadId);
+static void FlushTraceChunk(void);
+static void FinishTrace(void);
+static void WriteTrace(void);
+static void WriteJsonString(const char *string);
+// Variables
+static ThreadBuffer threadBuffers[threadLimit];
+static ThreadHistory threadHistories[threadLimit];
+static thread_local ThreadBufferOwner threadBufferOwner;
+static std::atomic<bool> isPanelVisible(false);
+// Panel settings, only used by the render thread.
+static int panelThreadIndex = 0;
+static int panelTickCount = 4;
+// Trace state. The current chunk is only used by the render thread and the
+// file only by the writer thread.
+static std::atomic<TraceState> traceState(TraceState::IDLE);
+static TraceChunk traceChunks[TraceChunkQueue::capacity];
+static TraceChunkQueue traceFullChunks, traceFreeChunks;
+static constexpr std::size_t traceNoChunk = TraceChunkQueue::capacity;
+static std::size_t traceCurrentChunk = traceNoChunk;
+static std::atomic<std::uint64_t> traceDroppedCount(0);
+static std::atomic<bool> isTraceEndRequested(false);
+static std::uint64_t traceStartTime = 0;
+// Incremented by every trace, only used by the render thread.
+static std::uint32_t traceSerial = 0;
+static std::FILE *pTraceFile = nullptr;
+static std::thread traceWriter;
+static std::mutex traceMutex;
+static std::condition_variable traceCondition;
+} // namespace Profiler
+} // namespace FmGui
+
+FmGui::Profiler::ThreadBufferOwner::~ThreadBufferOwner(void)
+{
+	if (pBuffer != nullptr)
+		pBuffer->isClaimed.store(false, std::memory_order_release);
+}
+
+static std::uint64_t
+FmGui::Profiler::Now(void)
+{
+	return static_cast<std::uint64_t>(
+		std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+static FmGui::Profiler::ThreadBuffer *
+FmGui::Profiler::GetThreadBuffer(void)
+{
+	ThreadBufferOwner &owner = threadBufferOwner;
+	if (owner.pBuffer != nullptr || owner.hasClaimFailed)
+		return owner.pBuffer;
+	for (ThreadBuffer &buffer : threadBuffers) {
+		bool isClaimed = false;
+		if (buffer.isClaimed.compare_exchange_strong(isClaimed, true,
+			std::memory_order_acquire)) {
+			buffer.name.store(nullptr, std::memory_order_relaxed);
+			buffer.openCount = 0;
+			buffer.skippedCount = 0;
+			buffer.generation.fetch_add(1, std::memory_order_release);
+			owner.pBuffer = &buffer;
+			return owner.pBuffer;
+		}
+	}
+	owner.hasClaimFailed = true;
+	return nullptr;
+}
+
+/*
+ * Push an event if at least reserve slots are free after it. Keeping a slot
+ * free for the END of every open scope means an END always fits.
+ */
+static bool
+FmGui::Profiler::PushEvent(ThreadBuffer *pBuffer, FmGuiProfileEventType type,
+						   const char *name, std::size_t reserve)
+{
+	const std::uint64_t head = pBuffer->head.load(std::memory_order_relaxed);
+	const std::uint64_t tail = pBuffer->tail.load(std::memory_order_acquire);
+	if (threadBufferSize - (head - tail) < reserve + 1) {
+		pBuffer->droppedCount.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+	FmGuiProfileEvent &event = pBuffer->events[head % threadBufferSize];
+	event.name = name;
+	event.timestamp = Now();
+	event.type = type;
+	pBuffer->head.store(head + 1, std::memory_order_release);
+	return true;
+}
+
+void
+FmGui::Profiler::BeginScope(const char *name)
+{
+	ThreadBuffer *const pBuffer = GetThreadBuffer();
+	if (pBuffer == nullptr)
+		return;
+	// Once a scope is dropped, everything nested in it is dropped as well.
+	if (pBuffer->skippedCount == 0
+		&& PushEvent(pBuffer, FmGuiProfileEventType::BEGIN, name,
+					 pBuffer->openCount + 1)) {
+		++pBuffer->openCount;
+	} else {
+		++pBuffer->skippedCount;
+	}
+}
+
+void
+FmGui::Profiler::EndScope(void)
+{
+	ThreadBuffer *const pBuffer = GetThreadBuffer();
+	if (pBuffer == nullptr)
+		return;
+	if (pBuffer->skippedCount != 0) {
+		--pBuffer->skippedCount;
+	} else if (pBuffer->openCount != 0) {
+		PushEvent(pBuffer, FmGuiProfileEventType::END, nullptr, 0);
+		--pBuffer->openCount;
+	}
+}
+
+void
+FmGui::Profiler::MarkTick(void)
+{
+	ThreadBuffer *const pBuffer = GetThreadBuffer();
+	if (pBuffer != nullptr) {
+		PushEvent(pBuffer, FmGuiProfileEventType::TICK, nullptr,
+				  pBuffer->openCount);
+	}
+}
+
+void
+FmGui::Profiler::SetThreadName(const char *name)
+{
+	ThreadBuffer *const pBuffer = GetThreadBuffer();
+	if (pBuffer != nullptr)
+		pBuffer->name.store(name, std::memory_order_relaxed);
+}
+
+std::uint64_t
+FmGui::Profiler::GetDroppedEventCount(void)
+{
+	std::uint64_t droppedCount = 0;
+	for (const ThreadBuffer &buffer : threadBuffers)
+		droppedCount += buffer.droppedCount.load(std::memory_order_relaxed);
+	return droppedCount;
+}
+
+bool
+FmGui::Profiler::SetPanelVisibility(bool isVisible)
+{
+	return isPanelVisible.exchange(isVisible, std::memory_order_relaxed);
+}
+
+static void
+FmGui::Profiler::CollectEvent(ThreadHistory &history,
+							  const FmGuiProfileEvent &event)
+{
+	switch (event.type) {
+	case FmGuiProfileEventType::BEGIN:
+		if (history.openDepth < ThreadHistory::depthLimit) {
+			history.openNames[history.openDepth] = event.name;
+			history.openStarts[history.openDepth] = event.timestamp;
+		}
+		++history.openDepth;
+		break;
+	case FmGuiProfileEventType::END:
+		if (history.openDepth == 0)
+			break;
+		--history.openDepth;
+		if (history.openDepth < ThreadHistory::depthLimit) {
+			FmGuiProfileScope &scope = history.scopes[
+				history.scopeCount % ThreadHistory::scopeCapacity];
+			scope.name = history.openNames[history.openDepth];
+			scope.start = history.openStarts[history.openDepth];
+			scope.end = event.timestamp;
+			scope.depth = history.openDepth;
+			++history.scopeCount;
+		}
+		break;
+	case FmGuiProfileEventType::TICK:
+		history.ticks[history.tickCount % ThreadHistory::tickCapacity] =
+			event.timestamp;
+		++history.tickCount;
+		break;
+	}
+}
+
+bool
+FmGui::Profiler::TraceChunkQueue::Push(std::size_t chunkIndex)
+{
+	const std::uint64_t headIndex = head.load(std::memory_order_relaxed);
+	if (headIndex - tail.load(std::memory_order_acquire) == capacity)
+		return false;
+	chunkIndices[headIndex % capacity] = chunkIndex;
+	head.store(headIndex + 1, std::memory_order_release);
+	return true;
+}
+
+bool
+FmGui::Profiler::TraceChunkQueue::Pop(std::size_t &chunkIndex)
+{
+	const std::uint64_t tailIndex = tail.load(std::memory_order_relaxed);
+	if (tailIndex == head.load(std::memory_order_acquire))
+		return false;
+	chunkIndex = chunkIndices[tailIndex % capacity];
+	tail.store(tailIndex + 1, std::memory_order_release);
+	return true;
+}
+
+static bool
+FmGui::Profiler::TraceEvent(const FmGuiProfileEvent &event,
+							std::uint32_t threadId)
+{
+	if (traceCurrentChunk == traceNoChunk) {
+		if (!traceFreeChunks.Pop(traceCurrentChunk)) {
+			traceCurrentChunk = traceNoChunk;
+			traceDroppedCount.fetch_add(1, std::memory_order_relaxed);
+			return false;
+		}
+		traceChunks[traceCurrentChunk].recordCount = 0;
+	}
+	TraceChunk &chunk = traceChunks[traceCurrentChunk];
+	TraceRecord &record = chunk.records[chunk.recordCount++];
+	record.event = event;
+	record.threadId = threadId;
+	if (chunk.recordCount == TraceChunk::recordCapacity)
+		FlushTraceChunk();
+	return true;
+}
+
+/*
+ * Open the scopes a thread was already in when the trace started, so the
+ * END events that close them have a BEGIN in the file.
+ */
+static void
+FmGui::Profiler::BeginThreadTrace(ThreadHistory &history,
+								  std::uint32_t threadId)
+{
+	history.traceSerial = traceSerial;
+	history.traceDepth = 0;
+	history.traceSkippedCount = 0;
+	for (std::uint32_t depth = 0; depth < history.openDepth; ++depth) {
+		FmGuiProfileEvent event;
+		event.name = depth < ThreadHistory::depthLimit ?
+			history.openNames[depth] : "(unknown)";
+		event.timestamp = traceStartTime;
+		event.type = FmGuiProfileEventType::BEGIN;
+		TraceCollectedEvent(history, event, threadId);
+	}
+}
+
+/*
+ * Keep the BEGIN and END events of a thread paired. An END is written only if
+ * its BEGIN was, and ticks from before the start are left out.
+ */
+static void
+FmGui::Profiler::TraceCollectedEvent(ThreadHistory &history,
+									 const FmGuiProfileEvent &event,
+									 std::uint32_t threadId)
+{
+	switch (event.type) {
+	case FmGuiProfileEventType::BEGIN:
+		if (history.traceSkippedCount == 0 && TraceEvent(event, threadId))
+			++history.traceDepth;
+		else
+			++history.traceSkippedCount;
+		break;
+	case FmGuiProfileEventType::END:
+		if (history.traceSkippedCount != 0)
+			--history.traceSkippedCount;
+		else if (history.traceDepth != 0 && TraceEvent(event, threadId))
+			--history.traceDepth;
+		break;
+	case FmGuiProfileEventType::TICK:
+		if (event.timestamp >= traceStartTime)
+			TraceEvent(event, threadId);
+		break;
+	}
+}
+
+static void
+FmGui::Profiler::FlushTraceChunk(void)
+{
+	if (traceCurrentChunk == traceNoChunk)
+		return;
+	// Never fails, the queue holds every chunk.
+	traceFullChunks.Push(traceCurrentChunk);
+	traceCurrentChunk = traceNoChunk;
+	traceCondition.notify_one();
+}
+
+/*
+ * Close the scopes of a thread that are still open in the trace, so every
+ * BEGIN in the file has its END.
+ */
+static void
+FmGui::Profiler::EndThreadTrace(ThreadHistory &history,
+								std::uint32_t threadId)
+{
+	if (history.traceSerial != traceSerial)
+		return;
+	FmGuiProfileEvent event;
+	event.name = nullptr;
+	event.timestamp = Now();
+	event.type = FmGuiProfileEventType::END;
+	for (; history.traceDepth != 0; --history.traceDepth)
+		TraceEvent(event, threadId);
+	history.traceSkippedCount = 0;
+}
+
+/*
+ * Hand the last events to the writer, which then completes the file.
+ */
+static void
+FmGui::Profiler::FinishTrace(void)
+{
+	for (std::size_t index = 0; index < threadLimit; ++index) {
+		ThreadHistory &history = threadHistories[index];
+		EndThreadTrace(history,
+			history.generation * static_cast<std::uint32_t>(threadLimit)
+			+ static_cast<std::uint32_t>(index));
+	}
+	FlushTraceChunk();
+	isTraceEndRequested.store(true, std::memory_order_release);
+	traceCondition.notify_one();
+	traceState.store(TraceState::IDLE, std::memory_order_release);
+}
+
+static void
+FmGui::Profiler::WriteJsonString(const char *string)
+{
+	std::fputc('"', pTraceFile);
+	for (; *string != '\0'; ++string) {
+		const unsigned char character = static_cast<unsigned char>(*string);
+		if (character == '"' || character == '\\')
+			std::fprintf(pTraceFile, "\\%c", character);
+		else if (character < 0x20)
+			std::fprintf(pTraceFile, "\\u%04x", character);
+		else
+			std::fputc(character, pTraceFile);
+	}
+	std::fputc('"', pTraceFile);
+}
+
+/*
+ * Body of the writer thread.
+ */
+static void
+FmGui::Profiler::WriteTrace(void)
+{
+	std::vector<std::uint32_t> namedThreadIds;
+	bool isFirstEvent = true;
+	std::fputs("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n", pTraceFile);
+	for (;;) {
+		// Checked before the queue, so no chunk pushed before the request is
+		// missed.
+		const bool isEndRequested =
+			isTraceEndRequested.load(std::memory_order_acquire);
+		std::size_t chunkIndex;
+		if (!traceFullChunks.Pop(chunkIndex)) {
+			if (isEndRequested)
+				break;
+			std::unique_lock<std::mutex> lock(traceMutex);
+			traceCondition.wait_for(lock, std::chrono::milliseconds(50));
+			continue;
+		}
+		const TraceChunk &chunk = traceChunks[chunkIndex];
+		for (std::size_t index = 0; index < chunk.recordCount; ++index) {
+			const TraceRecord &record = chunk.records[index];
+			// Scopes that began before the start are clamped to it.
+			const std::int64_t elapsed = static_cast<std::int64_t>(
+				record.event.timestamp - traceStartTime);
+			const double timestamp =
+				static_cast<double>(std::max<std::int64_t>(elapsed, 0))
+				* 1.0e-3;
+			if (std::find(namedThreadIds.begin(), namedThreadIds.end(),
+				record.threadId) == namedThreadIds.end()) {
+				namedThreadIds.push_back(record.threadId);
+				const char *const name = threadBuffers[record.threadId
+					% threadLimit].name.load(std::memory_order_relaxed);
+				if (name != nullptr) {
+					std::fprintf(pTraceFile, "%s{\"name\":\"thread_name\","
+								 "\"ph\":\"M\",\"pid\":1,\"tid\":%u,"
+								 "\"args\":{\"name\":",
+								 isFirstEvent ? "" : ",\n",
+								 static_cast<unsigned int>(record.threadId));
+					WriteJsonString(name);
+					std::fputs("}}", pTraceFile);
+					isFirstEvent = false;
+				}
+			}
+			std::fputs(isFirstEvent ? "{" : ",\n{", pTraceFile);
+			isFirstEvent = false;
+			switch (record.event.type) {
+			case FmGuiProfileEventType::BEGIN:
+				std::fputs("\"name\":", pTraceFile);
+				WriteJsonString(record.event.name);
+				std::fputs(",\"ph\":\"B\"", pTraceFile);
+				break;
+			case FmGuiProfileEventType::END:
+				std::fputs("\"ph\":\"E\"", pTraceFile);
+				break;
+			case FmGuiProfileEventType::TICK:
+				std::fputs("\"name\":\"Tick\",\"ph\":\"i\",\"s\":\"t\"",
+						   pTraceFile);
+				break;
+			}
+			std::fprintf(pTraceFile, ",\"pid\":1,\"tid\":%u,\"ts\":%.3f}",
+						 static_cast<unsigned int>(record.threadId), timestamp);
+		}
+		traceFreeChunks.Push(chunkIndex);
+	}
+	std::fputs("\n]}\n", pTraceFile);
+	std::fclose(pTraceFile);
+	pTraceFile = nullptr;
+}
+
+bool
+FmGui::Profiler::StartTrace(const char *fileName)
+{
+	if (traceState.load(std::memory_order_acquire) != TraceState::IDLE) {
+		FMGUI_PUSH_MSG(FmGuiMessageSeverity::LOW,
+					   "A trace is already being recorded.");
+		return false;
+	}
+	// Wait for the writer of the previous trace to complete its file.
+	if (traceWriter.joinable())
+		traceWriter.join();
+	pTraceFile = std::fopen(fileName, "w");
+	if (pTraceFile == nullptr) {
+		FMGUI_PUSH_MSGF(FmGuiMessageSeverity::HIGH,
+						"Failed to open trace file \"%s\".", fileName);
+		return false;
+	}
+	traceFullChunks.head.store(0, std::memory_order_relaxed);
+	traceFullChunks.tail.store(0, std::memory_order_relaxed);
+	traceFreeChunks.head.store(0, std::memory_order_relaxed);
+	traceFreeChunks.tail.store(0, std::memory_order_relaxed);
+	for (std::size_t index = 0; index < TraceChunkQueue::capacity; ++index)
+		traceFreeChunks.Push(index);
+	traceCurrentChunk = traceNoChunk;
+	traceDroppedCount.store(0, std::memory_order_relaxed);
+	isTraceEndRequested.store(false, std::memory_order_relaxed);
+	traceStartTime = Now();
+	++traceSerial;
+	traceWriter = std::thread(WriteTrace);
+	traceState.store(TraceState::RECORDING, std::memory_order_release);
+	FMGUI_PUSH_MSGF(FmGuiMessageSeverity::NOTIFICATION,
+					"Recording trace to \"%s\".", fileName);
+	return true;
+}
+
+void
+FmGui::Profiler::StopTrace(void)
+{
+	TraceState state = TraceState::RECORDING;
+	traceState.compare_exchange_strong(state, TraceState::STOPPING,
+									   std::memory_order_acq_rel);
+}
+
+bool
+FmGui::Profiler::IsTracing(void)
+{
+	return traceState.load(std::memory_order_acquire) != TraceState::IDLE;
+}
+
+std::uint64_t
+FmGui::Profiler::GetTraceDroppedEventCount(void)
+{
+	return traceDroppedCount.load(std::memory_order_relaxed);
+}
+
+void
+FmGui::Profiler::Shutdown(void)
+{
+	// No more frames run, so the trace is completed here instead.
+	if (traceState.load(std::memory_order_acquire) != TraceState::IDLE)
+		FinishTrace();
+	if (traceWriter.joinable())
+		traceWriter.join();
+}
+
+void
+FmGui::Profiler::Collect(void)
+{
+	const TraceState state = traceState.load(std::memory_order_acquire);
+	for (std::size_t index = 0; index < threadLimit; ++index) {
+		ThreadBuffer &buffer = threadBuffers[index];
+		ThreadHistory &history = threadHistories[index];
+		const std::uint32_t generation =
+			buffer.generation.load(std::memory_order_acquire);
+		if (generation != history.generation) {
+			// A new thread owns the buffer.
+			if (state != TraceState::IDLE) {
+				EndThreadTrace(history,
+					history.generation * static_cast<std::uint32_t>(threadLimit)
+					+ static_cast<std::uint32_t>(index));
+			}
+			history.generation = generation;
+			history.openDepth = 0;
+			history.scopeCount = 0;
+			history.tickCount = 0;
+		}
+		const std::uint64_t head = buffer.head.load(std::memory_order_acquire);
+		std::uint64_t tail = buffer.tail.load(std::memory_order_relaxed);
+		const std::uint32_t threadId =
+			generation * static_cast<std::uint32_t>(threadLimit)
+			+ static_cast<std::uint32_t>(index);
+		if (state == TraceState::RECORDING
+			&& history.traceSerial != traceSerial)
+			BeginThreadTrace(history, threadId);
+		for (; tail != head; ++tail) {
+			const FmGuiProfileEvent &event =
+				buffer.events[tail % threadBufferSize];
+			if (state == TraceState::RECORDING)
+				TraceCollectedEvent(history, event, threadId);
+			CollectEvent(history, event);
+		}
+		buffer.tail.store(tail, std::memory_order_release);
+	}
+	if (state == TraceState::STOPPING)
+		FinishTrace();
+}
+
+/*
+ * Stable color per scope name, hashed from the name pointer.
+ */
+static ImU32
+FmGui::Profiler::GetScopeColor(const char *name)
+{
+	std::uintptr_t hash = reinterpret_cast<std::uintptr_t>(name);
+	hash ^= hash >> 16;
+	hash *= 0x45D9F3B;
+	hash ^= hash >> 16;
+	return IM_COL32(96 + (hash & 0x7F), 96 + ((hash >> 8) & 0x7F),
+					96 + ((hash >> 16) & 0x7F), 255);
+}
+
+static void
+FmGui::Profiler::ShowFlameGraph(const ThreadHistory &history, int tickCount)
+{
+	if (history.tickCount < 2) {
+		ImGui::TextDisabled("No ticks recorded, see FMGUI_PROFILE_TICK().");
+		return;
+	}
+	// The last tickCount complete ticks.
+	const std::uint64_t lastTick = history.tickCount - 1;
+	const std::uint64_t firstTick = lastTick - std::min(lastTick,
+		static_cast<std::uint64_t>(tickCount));
+	const std::uint64_t windowStart =
+		history.ticks[firstTick % ThreadHistory::tickCapacity];
+	const std::uint64_t windowEnd =
+		history.ticks[lastTick % ThreadHistory::tickCapacity];
+	const float windowSpan = static_cast<float>(windowEnd - windowStart);
+	ImGui::Text("%u ticks, %.3f ms", static_cast<unsigned int>(lastTick
+				- firstTick), windowSpan * 1.0e-6f);
+
+	const float rowHeight = ImGui::GetTextLineHeightWithSpacing();
+	const ImVec2 origin = ImGui::GetCursorScreenPos();
+	const float width = ImGui::GetContentRegionAvail().x;
+	ImDrawList *const pDrawList = ImGui::GetWindowDrawList();
+	std::uint32_t maxDepth = 0;
+	// Scopes are stored in the order they ended, so the scan stops at the first
+	// scope ending before the window.
+	const std::uint64_t scopeFirst =
+		history.scopeCount > ThreadHistory::scopeCapacity
+		? history.scopeCount - ThreadHistory::scopeCapacity : 0;
+	for (std::uint64_t index = history.scopeCount; index > scopeFirst;) {
+		const FmGuiProfileScope &scope =
+			history.scopes[--index % ThreadHistory::scopeCapacity];
+		if (scope.end < windowStart)
+			break;
+		if (scope.start > windowEnd)
+			continue;
+		const std::uint64_t start = std::max(scope.start, windowStart);
+		const std::uint64_t end = std::min(scope.end, windowEnd);
+		const float x0 = origin.x + width
+			* static_cast<float>(start - windowStart) / windowSpan;
+		const float x1 = std::max(x0 + 1.0f, origin.x + width
+			* static_cast<float>(end - windowStart) / windowSpan);
+		const float y0 = origin.y + rowHeight * static_cast<float>(scope.depth);
+		const ImVec2 min(x0, y0), max(x1, y0 + rowHeight - 1.0f);
+		pDrawList->AddRectFilled(min, max, GetScopeColor(scope.name));
+		if (x1 - x0 > ImGui::CalcTextSize(scope.name).x) {
+			pDrawList->PushClipRect(min, max, true);
+			pDrawList->AddText(ImVec2(x0 + 2.0f, y0), IM_COL32(0, 0, 0, 255),
+							   scope.name);
+			pDrawList->PopClipRect();
+		}
+		if (ImGui::IsMouseHoveringRect(min, max)) {
+			ImGui::SetTooltip("%s\n%.3f ms", scope.name,
+				static_cast<double>(scope.end - scope.start) * 1.0e-6);
+		}
+		maxDepth = std::max(maxDepth, scope.depth);
+	}
+	const float height = rowHeight * static_cast<float>(maxDepth + 1);
+	for (std::uint64_t tick = firstTick; tick <= lastTick; ++tick) {
+		const float x = origin.x + width * static_cast<float>(
+			history.ticks[tick % ThreadHistory::tickCapacity] - windowStart)
+			/ windowSpan;
+		pDrawList->AddLine(ImVec2(x, origin.y), ImVec2(x, origin.y + height),
+						   IM_COL32(255, 255, 255, 160));
+	}
+	ImGui::Dummy(ImVec2(width, height));
+}
+
+void
+FmGui::Profiler::ShowPanel(void)
+{
+	if (!isPanelVisible.load(std::memory_order_relaxed))
+		return;
+	bool isVisible = true;
+	ImGui::SetNextWindowSize(ImVec2(640.0f, 240.0f), ImGuiCond_FirstUseEver);
+	if (ImGui::Begin("FmGui Profiler", &isVisible)) {
+		char label[64];
+		const auto GetLabel = [&label](std::size_t index) -> const char * {
+			const char *const name =
+				threadBuffers[index].name.load(std::memory_order_relaxed);
+			if (name != nullptr)
+				return name;
+			std::snprintf(label, sizeof(label), "Thread %u",
+						  static_cast<unsigned int>(index));
+			return label;
+		};
+		if (ImGui::BeginCombo("Thread", GetLabel(panelThreadIndex))) {
+			for (std::size_t index = 0; index < threadLimit; ++index) {
+				if (threadHistories[index].generation == 0)
+					continue;
+				const bool isSelected =
+					(index == static_cast<std::size_t>(panelThreadIndex));
+				if (ImGui::Selectable(GetLabel(index), isSelected))
+					panelThreadIndex = static_cast<int>(index);
+			}
+			ImGui::EndCombo();
+		}
+		ImGui::SliderInt("Ticks", &panelTickCount, 1,
+						 static_cast<int>(ThreadHistory::tickCapacity) - 1);
+		ImGui::Text("Dropped events: %llu", static_cast<unsigned long long>(
+					GetDroppedEventCount()));
+		if (IsTracing()) {
+			ImGui::Text("Tracing, dropped events: %llu",
+				static_cast<unsigned long long>(GetTraceDroppedEventCount()));
+		}
+		ImGui::Separator();
+		ShowFlameGraph(threadHistories[panelThreadIndex], panelTickCount);
+	}
+	ImGui::End();
+	if (!isVisible)
+		isPanelVisible.store(false, std::memory_order_relaxed);
+}
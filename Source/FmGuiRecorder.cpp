@@ -0,0 +1,581 @@
+/* =============================================================================
+** DCS-EFM-ImGui, file: FmGuiRecorder.cpp Created: 17-OCT-2026
+**
+** Copyright 2022 Brian Hoffpauir, USA
+** All rights reserved.
+**
+** Redistribution and use of this source file, with or without modification, is
+** permitted provided that the following conditions are met:
+**
+** 1. Redistributions of this source file must retain the above copyright
+**    notice, this list of conditions and the following disclaimer.
+**
+** 2. Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and/or other materials provided with the distribution.
+**
+** THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+** WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO
+** EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+** PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+** OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+** WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+** OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+** ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+** =============================================================================
+**/
+#include "FmGuiRecorder.hpp"
+#include "FmGuiCore.hpp"
+
+#include <cstring>
+#include <algorithm>
+#include <chrono>
+
+namespace FmGui
+{
+// Functions
+static bool SeekFile(std::FILE *pFile, std::uint64_t offset);
+static bool WriteBytes(std::FILE *pFile, const void *pData, std::size_t size,
+					   std::uint64_t &offset);
+static bool ReadBytes(std::FILE *pFile, void *pData, std::size_t size);
+// Variables
+static constexpr char recordingMagic[8] = {
+	'F', 'M', 'G', 'U', 'I', 'R', 'E', 'C'
+};
+static constexpr std::uint32_t recordingVersion = 1;
+static constexpr std::uint32_t chunkTag = 0x4B4E4843; // "CHNK"
+static constexpr std::uint32_t indexTag = 0x58444E49; // "INDX"
+static constexpr std::uint32_t trailerTag = 0x444E4546; // "FEND"
+// Sizes of the fixed parts of the records.
+static constexpr std::size_t chunkHeaderSize = 24;
+static constexpr std::size_t indexHeaderSize = 16;
+static constexpr std::size_t indexEntrySize = 24;
+static constexpr std::size_t trailerSize = 16;
+// Longer names are taken as a corrupt header.
+static constexpr std::uint32_t channelNameLimit = 1024;
+} // namespace FmGui
+
+static bool
+FmGui::SeekFile(std::FILE *pFile, std::uint64_t offset)
+{
+#if defined _MSC_VER
+	return _fseeki64(pFile, static_cast<__int64>(offset), SEEK_SET) == 0;
+#else
+	return fseeko(pFile, static_cast<off_t>(offset), SEEK_SET) == 0;
+#endif
+}
+
+static bool
+FmGui::WriteBytes(std::FILE *pFile, const void *pData, std::size_t size,
+				  std::uint64_t &offset)
+{
+	if (size != 0 && std::fwrite(pData, size, 1, pFile) != 1)
+		return false;
+	offset += size;
+	return true;
+}
+
+static bool
+FmGui::ReadBytes(std::FILE *pFile, void *pData, std::size_t size)
+{
+	return size == 0 || std::fread(pData, size, 1, pFile) == 1;
+}
+
+FmGui::Recorder::Recorder(void)
+	: currentChunk(noChunk),
+	  isRecording(false),
+	  droppedRowCount(0),
+	  pFile(nullptr),
+	  fileOffset(0),
+	  lastIndexOffset(0),
+	  isEndRequested(false)
+{
+}
+
+FmGui::Recorder::~Recorder(void)
+{
+	Stop();
+}
+
+bool
+FmGui::Recorder::Start(const char *fileName, const FmGuiRecorderConfig &config)
+{
+	if (isRecording.load(std::memory_order_relaxed) || writer.joinable()) {
+		FMGUI_PUSH_MSG(FmGuiMessageSeverity::LOW, "Already recording.");
+		return false;
+	}
+	if (config.channelNames.empty() || config.chunkRows == 0) {
+		FMGUI_PUSH_MSG(FmGuiMessageSeverity::MEDIUM,
+					   "A recording needs at least one channel and row.");
+		return false;
+	}
+	pFile = std::fopen(fileName, "wb");
+	if (pFile == nullptr) {
+		FMGUI_PUSH_MSGF(FmGuiMessageSeverity::HIGH,
+						"Failed to create recording \"%s\".", fileName);
+		return false;
+	}
+	this->config = config;
+	this->config.chunkPoolSize =
+		std::min<std::size_t>(std::max<std::size_t>(config.chunkPoolSize, 2),
+							  64);
+	this->config.checkpointInterval =
+		std::max<std::size_t>(config.checkpointInterval, 1);
+	const std::size_t channelCount = config.channelNames.size();
+	const std::size_t chunkRows = config.chunkRows;
+	const std::size_t chunkPoolSize = this->config.chunkPoolSize;
+	chunkTimes.assign(chunkPoolSize * chunkRows, 0.0);
+	chunkValues.assign(chunkPoolSize * chunkRows * channelCount, 0.0f);
+	chunkRowCounts.assign(chunkPoolSize, 0);
+	std::uint32_t chunk;
+	while (fullChunks.Pop(chunk)) {
+	}
+	while (freeChunks.Pop(chunk)) {
+	}
+	for (chunk = 0; chunk < chunkPoolSize; ++chunk)
+		freeChunks.Publish(chunk);
+	currentChunk = noChunk;
+	droppedRowCount.store(0, std::memory_order_relaxed);
+
+	// Buffered, so chunks reach the disk in large sequential writes.
+	fileBuffer.resize(1 << 20);
+	std::setvbuf(pFile, fileBuffer.data(), _IOFBF, fileBuffer.size());
+	fileOffset = 0;
+	lastIndexOffset = 0;
+	const std::uint32_t header[3] = {
+		recordingVersion, static_cast<std::uint32_t>(channelCount),
+		static_cast<std::uint32_t>(chunkRows)
+	};
+	bool isWritten = WriteBytes(pFile, recordingMagic, sizeof(recordingMagic),
+								fileOffset)
+		&& WriteBytes(pFile, header, sizeof(header), fileOffset);
+	for (const std::string &name : config.channelNames) {
+		const std::uint32_t length = static_cast<std::uint32_t>(name.size());
+		isWritten = isWritten
+			&& WriteBytes(pFile, &length, sizeof(length), fileOffset)
+			&& WriteBytes(pFile, name.data(), name.size(), fileOffset);
+	}
+	if (!isWritten) {
+		FMGUI_PUSH_MSGF(FmGuiMessageSeverity::HIGH,
+						"Failed to write recording \"%s\".", fileName);
+		std::fclose(pFile);
+		pFile = nullptr;
+		return false;
+	}
+	isEndRequested.store(false, std::memory_order_relaxed);
+	writer = std::thread(&Recorder::RunWriter, this);
+	isRecording.store(true, std::memory_order_release);
+	FMGUI_PUSH_MSGF(FmGuiMessageSeverity::NOTIFICATION,
+					"Recording to \"%s\".", fileName);
+	return true;
+}
+
+void
+FmGui::Recorder::Stop(void)
+{
+	if (!writer.joinable())
+		return;
+	isRecording.store(false, std::memory_order_relaxed);
+	HandOffChunk();
+	{
+		std::lock_guard<std::mutex> lock(writerMutex);
+		isEndRequested.store(true, std::memory_order_release);
+	}
+	writerCondition.notify_one();
+	writer.join();
+}
+
+bool
+FmGui::Recorder::IsRecording(void) const
+{
+	return isRecording.load(std::memory_order_relaxed);
+}
+
+bool
+FmGui::Recorder::Record(double time, const float *pValues)
+{
+	if (!isRecording.load(std::memory_order_acquire))
+		return false;
+	if (currentChunk == noChunk) {
+		if (!freeChunks.Pop(currentChunk)) {
+			currentChunk = noChunk;
+			droppedRowCount.fetch_add(1, std::memory_order_relaxed);
+			return false;
+		}
+		chunkRowCounts[currentChunk] = 0;
+	}
+	const std::size_t chunkRows = config.chunkRows;
+	const std::size_t channelCount = config.channelNames.size();
+	const std::uint32_t row = chunkRowCounts[currentChunk]++;
+	chunkTimes[currentChunk * chunkRows + row] = time;
+	float *const pColumns = &chunkValues[currentChunk * chunkRows
+										 * channelCount];
+	for (std::size_t channel = 0; channel < channelCount; ++channel)
+		pColumns[channel * chunkRows + row] = pValues[channel];
+	if (row + 1 == chunkRows)
+		HandOffChunk();
+	return true;
+}
+
+std::uint64_t
+FmGui::Recorder::GetDroppedRowCount(void) const
+{
+	return droppedRowCount.load(std::memory_order_relaxed);
+}
+
+void
+FmGui::Recorder::HandOffChunk(void)
+{
+	if (currentChunk == noChunk)
+		return;
+	// Never fails, the queue holds every chunk.
+	fullChunks.Publish(currentChunk);
+	currentChunk = noChunk;
+	// The recording thread never waits on the writer, which polls instead.
+}
+
+/*
+ * Body of the writer thread.
+ */
+void
+FmGui::Recorder::RunWriter(void)
+{
+	std::vector<FmGuiRecordingChunkInfo> pendingIndex;
+	pendingIndex.reserve(config.checkpointInterval);
+	bool isWritten = true;
+	for (;;) {
+		// Checked before the queue, so no chunk handed off before the request
+		// is missed.
+		const bool isEnd = isEndRequested.load(std::memory_order_acquire);
+		std::uint32_t chunk;
+		if (!fullChunks.Pop(chunk)) {
+			if (isEnd)
+				break;
+			std::unique_lock<std::mutex> lock(writerMutex);
+			writerCondition.wait_for(lock, std::chrono::milliseconds(20));
+			continue;
+		}
+		isWritten = isWritten && WriteChunk(chunk, pendingIndex);
+		freeChunks.Publish(chunk);
+		if (isWritten && pendingIndex.size() >= config.checkpointInterval)
+			isWritten = WriteIndex(pendingIndex) && std::fflush(pFile) == 0;
+	}
+	if (isWritten && !pendingIndex.empty())
+		isWritten = WriteIndex(pendingIndex);
+	const std::uint32_t trailer[2] = { trailerTag, 0 };
+	isWritten = isWritten
+		&& WriteBytes(pFile, trailer, sizeof(trailer), fileOffset)
+		&& WriteBytes(pFile, &lastIndexOffset, sizeof(lastIndexOffset),
+					  fileOffset);
+	if (std::fclose(pFile) != 0 || !isWritten) {
+		FMGUI_PUSH_MSG(FmGuiMessageSeverity::HIGH,
+					   "Failed to write the recording.");
+	}
+	pFile = nullptr;
+}
+
+bool
+FmGui::Recorder::WriteChunk(std::uint32_t chunk,
+							std::vector<FmGuiRecordingChunkInfo> &pendingIndex)
+{
+	const std::size_t chunkRows = config.chunkRows;
+	const std::size_t channelCount = config.channelNames.size();
+	const std::uint32_t rowCount = chunkRowCounts[chunk];
+	if (rowCount == 0)
+		return true;
+	const double *const pTimes = &chunkTimes[chunk * chunkRows];
+	FmGuiRecordingChunkInfo info;
+	info.firstTime = pTimes[0];
+	info.lastTime = pTimes[rowCount - 1];
+	info.offset = fileOffset;
+	const std::uint32_t header[2] = { chunkTag, rowCount };
+	bool isWritten = WriteBytes(pFile, header, sizeof(header), fileOffset)
+		&& WriteBytes(pFile, &info.firstTime, sizeof(double), fileOffset)
+		&& WriteBytes(pFile, &info.lastTime, sizeof(double), fileOffset)
+		&& WriteBytes(pFile, pTimes, rowCount * sizeof(double), fileOffset);
+	const float *const pColumns = &chunkValues[chunk * chunkRows
+											   * channelCount];
+	for (std::size_t channel = 0; channel < channelCount; ++channel) {
+		isWritten = isWritten && WriteBytes(pFile, pColumns + channel
+			* chunkRows, rowCount * sizeof(float), fileOffset);
+	}
+	pendingIndex.push_back(info);
+	return isWritten;
+}
+
+bool
+FmGui::Recorder::WriteIndex(std::vector<FmGuiRecordingChunkInfo> &pendingIndex)
+{
+	const std::uint64_t indexOffset = fileOffset;
+	const std::uint32_t header[2] = {
+		indexTag, static_cast<std::uint32_t>(pendingIndex.size())
+	};
+	bool isWritten = WriteBytes(pFile, header, sizeof(header), fileOffset)
+		&& WriteBytes(pFile, &lastIndexOffset, sizeof(lastIndexOffset),
+					  fileOffset);
+	for (const FmGuiRecordingChunkInfo &info : pendingIndex) {
+		isWritten = isWritten
+			&& WriteBytes(pFile, &info.firstTime, sizeof(double), fileOffset)
+			&& WriteBytes(pFile, &info.lastTime, sizeof(double), fileOffset)
+			&& WriteBytes(pFile, &info.offset, sizeof(info.offset),
+						  fileOffset);
+	}
+	lastIndexOffset = indexOffset;
+	pendingIndex.clear();
+	return isWritten;
+}
+
+FmGui::Recording::Recording(void)
+	: pFile(nullptr),
+	  chunkRows(0),
+	  isRecovered(false)
+{
+}
+
+FmGui::Recording::~Recording(void)
+{
+	Close();
+}
+
+bool
+FmGui::Recording::Open(const char *fileName)
+{
+	Close();
+	pFile = std::fopen(fileName, "rb");
+	if (pFile == nullptr) {
+		FMGUI_PUSH_MSGF(FmGuiMessageSeverity::HIGH,
+						"Failed to open recording \"%s\".", fileName);
+		return false;
+	}
+	char magic[sizeof(recordingMagic)];
+	std::uint32_t header[3];
+	bool isRead = ReadBytes(pFile, magic, sizeof(magic))
+		&& std::memcmp(magic, recordingMagic, sizeof(magic)) == 0
+		&& ReadBytes(pFile, header, sizeof(header))
+		&& header[0] == recordingVersion
+		&& header[2] != 0;
+	chunkRows = isRead ? header[2] : 0;
+	std::uint64_t offset = sizeof(magic) + sizeof(header);
+	for (std::uint32_t channel = 0; isRead && channel < header[1];
+		 ++channel) {
+		std::uint32_t length = 0;
+		isRead = ReadBytes(pFile, &length, sizeof(length))
+			&& length <= channelNameLimit;
+		std::string name(isRead ? length : 0, '\0');
+		isRead = isRead && ReadBytes(pFile, &name[0], length);
+		channelNames.push_back(name);
+		offset += sizeof(length) + length;
+	}
+	if (!isRead) {
+		FMGUI_PUSH_MSGF(FmGuiMessageSeverity::HIGH,
+						"\"%s\" is not a recording.", fileName);
+		Close();
+		return false;
+	}
+	// Use the index the trailer points at, else scan the chunks.
+	std::uint32_t trailer[2] = { 0, 0 };
+	std::uint64_t indexOffset = 0;
+#if defined _MSC_VER
+	const bool isAtTrailer =
+		_fseeki64(pFile, -static_cast<__int64>(trailerSize), SEEK_END) == 0;
+#else
+	const bool isAtTrailer =
+		fseeko(pFile, -static_cast<off_t>(trailerSize), SEEK_END) == 0;
+#endif
+	if (isAtTrailer && ReadBytes(pFile, trailer, sizeof(trailer))
+		&& trailer[0] == trailerTag
+		&& ReadBytes(pFile, &indexOffset, sizeof(indexOffset))
+		&& ReadIndex(indexOffset)) {
+		isRecovered = false;
+	} else {
+		chunks.clear();
+		isRecovered = true;
+		ScanChunks(offset);
+		FMGUI_PUSH_MSGF(FmGuiMessageSeverity::MEDIUM,
+						"Recording \"%s\" has no trailer, recovered %u chunks.",
+						fileName, static_cast<unsigned int>(chunks.size()));
+	}
+	return true;
+}
+
+void
+FmGui::Recording::Close(void)
+{
+	if (pFile != nullptr) {
+		std::fclose(pFile);
+		pFile = nullptr;
+	}
+	channelNames.clear();
+	chunkRows = 0;
+	chunks.clear();
+	isRecovered = false;
+}
+
+/*
+ * Follow the chain of index records back from the last one.
+ */
+bool
+FmGui::Recording::ReadIndex(std::uint64_t indexOffset)
+{
+	while (indexOffset != 0) {
+		std::uint32_t header[2];
+		std::uint64_t previousOffset;
+		if (!SeekFile(pFile, indexOffset)
+			|| !ReadBytes(pFile, header, sizeof(header))
+			|| header[0] != indexTag
+			|| !ReadBytes(pFile, &previousOffset, sizeof(previousOffset))
+			|| previousOffset >= indexOffset) {
+			return false;
+		}
+		for (std::uint32_t entry = 0; entry < header[1]; ++entry) {
+			FmGuiRecordingChunkInfo info;
+			if (!ReadBytes(pFile, &info.firstTime, sizeof(double))
+				|| !ReadBytes(pFile, &info.lastTime, sizeof(double))
+				|| !ReadBytes(pFile, &info.offset, sizeof(info.offset))) {
+				return false;
+			}
+			chunks.push_back(info);
+		}
+		indexOffset = previousOffset;
+	}
+	std::sort(chunks.begin(), chunks.end(),
+		[](const FmGuiRecordingChunkInfo &left,
+		   const FmGuiRecordingChunkInfo &right) {
+			return left.offset < right.offset;
+		});
+	return true;
+}
+
+/*
+ * Walk the records from offset, keeping every complete chunk. Stops at the
+ * first truncated or unknown record, or chunk with more rows than chunkRows.
+ */
+bool
+FmGui::Recording::ScanChunks(std::uint64_t offset)
+{
+	const std::uint64_t columnSize =
+		sizeof(double) + channelNames.size() * sizeof(float);
+	for (;;) {
+		std::uint32_t header[2];
+		if (!SeekFile(pFile, offset) || !ReadBytes(pFile, header,
+												   sizeof(header))) {
+			return true;
+		}
+		if (header[0] == chunkTag) {
+			if (header[1] == 0 || header[1] > chunkRows)
+				return false;
+			FmGuiRecordingChunkInfo info;
+			info.offset = offset;
+			if (!ReadBytes(pFile, &info.firstTime, sizeof(double))
+				|| !ReadBytes(pFile, &info.lastTime, sizeof(double))) {
+				return true;
+			}
+			offset += chunkHeaderSize + header[1] * columnSize;
+			// The last value of the chunk must be there.
+			char last;
+			if (!SeekFile(pFile, offset - 1) || !ReadBytes(pFile, &last, 1))
+				return true;
+			chunks.push_back(info);
+		} else if (header[0] == indexTag) {
+			offset += indexHeaderSize
+				+ static_cast<std::uint64_t>(header[1]) * indexEntrySize;
+		} else {
+			return header[0] == trailerTag;
+		}
+	}
+}
+
+std::size_t
+FmGui::Recording::GetChannelCount(void) const
+{
+	return channelNames.size();
+}
+
+const std::string &
+FmGui::Recording::GetChannelName(std::size_t channel) const
+{
+	return channelNames[channel];
+}
+
+std::size_t
+FmGui::Recording::FindChannel(const std::string &name) const
+{
+	return static_cast<std::size_t>(std::find(channelNames.begin(),
+		channelNames.end(), name) - channelNames.begin());
+}
+
+const std::vector<FmGuiRecordingChunkInfo> &
+FmGui::Recording::GetChunks(void) const
+{
+	return chunks;
+}
+
+double
+FmGui::Recording::GetStartTime(void) const
+{
+	return chunks.empty() ? 0.0 : chunks.front().firstTime;
+}
+
+double
+FmGui::Recording::GetEndTime(void) const
+{
+	return chunks.empty() ? 0.0 : chunks.back().lastTime;
+}
+
+bool
+FmGui::Recording::IsRecovered(void) const
+{
+	return isRecovered;
+}
+
+std::size_t
+FmGui::Recording::FindChunk(double time) const
+{
+	if (chunks.empty())
+		return 0;
+	// First chunk not ending before time.
+	const std::vector<FmGuiRecordingChunkInfo>::const_iterator chunk =
+		std::lower_bound(chunks.begin(), chunks.end(), time,
+			[](const FmGuiRecordingChunkInfo &info, double time) {
+				return info.lastTime < time;
+			});
+	if (chunk == chunks.end())
+		return chunks.size() - 1;
+	return static_cast<std::size_t>(chunk - chunks.begin());
+}
+
+bool
+FmGui::Recording::ReadChunk(std::size_t chunk,
+							FmGuiRecordingChunk &columns) const
+{
+	if (pFile == nullptr || chunk >= chunks.size())
+		return false;
+	std::uint32_t header[2];
+	if (!SeekFile(pFile, chunks[chunk].offset)
+		|| !ReadBytes(pFile, header, sizeof(header))
+		|| header[0] != chunkTag || header[1] == 0
+		|| header[1] > chunkRows) {
+		return false;
+	}
+	const std::size_t rowCount = header[1];
+	columns.times.resize(rowCount);
+	columns.values.resize(rowCount * channelNames.size());
+	return SeekFile(pFile, chunks[chunk].offset + chunkHeaderSize)
+		&& ReadBytes(pFile, columns.times.data(), rowCount * sizeof(double))
+		&& ReadBytes(pFile, columns.values.data(),
+					 columns.values.size() * sizeof(float));
+}
+
+/*
+ * FmGuiRecorderConfig's members, defined next to the Recorder that checks
+ * them.
+ */
+FmGuiRecorderConfig::FmGuiRecorderConfig(void)
+	: channelNames(),
+	  chunkRows(4096),
+	  chunkPoolSize(16),
+	  checkpointInterval(16)
+{
+}
@@ -0,0 +1,303 @@
+/* =============================================================================
+** DCS-EFM-ImGui, file: FmGuiSpectrum.cpp Created: 17-OCT-2026
+**
+** Copyright 2022 Brian Hoffpauir, USA
+** All rights reserved.
+**
+** Redistribution and use of this source file, with or without modification, is
+** permitted provided that the following conditions are met:
+**
+** 1. Redistributions of this source file must retain the above copyright
+**    notice, this list of conditions and the following disclaimer.
+**
+** 2. Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and/or other materials provided with the distribution.
+**
+** THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+** WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO
+** EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+** PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+** OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+** WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+** OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+** ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+** =============================================================================
+**/
+#include "FmGuiSpectrum.hpp"
+#include "FmGuiCore.hpp"
+
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+#include <chrono>
+
+FmGui::Spectrum::Spectrum(const FmGuiSpectrumConfig &config)
+	: config(config),
+	  windowHead(0),
+	  hopCount(0),
+	  sampleCount(0),
+	  magnitudeScale(0.0f),
+	  droppedRowCount(0),
+	  historyHead(0),
+	  historyCount(0),
+	  isStopRequested(false)
+{
+	std::size_t &fftSize = this->config.fftSize;
+	if (fftSize < 2 || fftSize > fftSizeLimit
+		|| (fftSize & (fftSize - 1)) != 0) {
+		FMGUI_PUSH_MSGF(FmGuiMessageSeverity::MEDIUM,
+						"Invalid spectrum FFT size %u, using 1024.",
+						static_cast<unsigned int>(fftSize));
+		fftSize = 1024;
+	}
+	float &sampleRate = this->config.sampleRate;
+	if (!(sampleRate > 0.0f)) {
+		FMGUI_PUSH_MSGF(FmGuiMessageSeverity::MEDIUM,
+						"Invalid spectrum sample rate %g Hz, using 1000 Hz.",
+						static_cast<double>(sampleRate));
+		sampleRate = 1000.0f;
+	}
+	this->config.hopSize = std::max<std::size_t>(this->config.hopSize, 1);
+	this->config.historySize =
+		std::max<std::size_t>(this->config.historySize, 1);
+	binCount = fftSize / 2 + 1;
+
+	window.assign(fftSize, 0.0f);
+	hannWindow.resize(fftSize);
+	fftReal.resize(fftSize);
+	fftImaginary.resize(fftSize);
+	twiddleReal.resize(fftSize / 2);
+	twiddleImaginary.resize(fftSize / 2);
+	bitReversal.resize(fftSize);
+	const double pi = 3.14159265358979323846;
+	double windowSum = 0.0;
+	for (std::size_t index = 0; index < fftSize; ++index) {
+		hannWindow[index] = static_cast<float>(0.5 - 0.5
+			* std::cos(2.0 * pi * static_cast<double>(index)
+					   / static_cast<double>(fftSize)));
+		windowSum += hannWindow[index];
+	}
+	// A full scale sine peaks at 0 dB.
+	magnitudeScale = static_cast<float>(2.0 / windowSum);
+	for (std::size_t index = 0; index < fftSize / 2; ++index) {
+		const double angle = -2.0 * pi * static_cast<double>(index)
+			/ static_cast<double>(fftSize);
+		twiddleReal[index] = static_cast<float>(std::cos(angle));
+		twiddleImaginary[index] = static_cast<float>(std::sin(angle));
+	}
+	std::size_t bitCount = 0;
+	while ((std::size_t(1) << bitCount) < fftSize)
+		++bitCount;
+	for (std::size_t index = 0; index < fftSize; ++index) {
+		std::uint32_t reversed = 0;
+		for (std::size_t bit = 0; bit < bitCount; ++bit) {
+			reversed |= static_cast<std::uint32_t>((index >> bit) & 1)
+				<< (bitCount - 1 - bit);
+		}
+		bitReversal[index] = reversed;
+	}
+
+	rowPool.assign(rowPoolSize * binCount, 0.0f);
+	for (std::uint32_t slot = 0; slot < rowPoolSize; ++slot)
+		freeRows.Publish(slot);
+	history.assign(this->config.historySize * binCount, 0.0f);
+	worker = std::thread(&Spectrum::RunWorker, this);
+}
+
+FmGui::Spectrum::~Spectrum(void)
+{
+	Stop();
+}
+
+void
+FmGui::Spectrum::Stop(void)
+{
+	if (!worker.joinable())
+		return;
+	{
+		std::lock_guard<std::mutex> lock(workerMutex);
+		isStopRequested.store(true, std::memory_order_relaxed);
+	}
+	workerCondition.notify_one();
+	worker.join();
+}
+
+bool
+FmGui::Spectrum::Push(float sample)
+{
+	return samples.Publish(sample);
+}
+
+std::size_t
+FmGui::Spectrum::Update(void)
+{
+	const std::size_t historySize = config.historySize;
+	return finishedRows.Drain([this, historySize](std::uint32_t slot) {
+		// Newest first, so the history head moves backwards.
+		historyHead = (historyHead == 0 ? historySize : historyHead) - 1;
+		std::memcpy(&history[historyHead * binCount],
+					&rowPool[slot * binCount], binCount * sizeof(float));
+		historyCount = std::min(historyCount + 1, historySize);
+		freeRows.Publish(slot);
+	});
+}
+
+/*
+ * Body of the worker thread. The producer never signals, so the worker polls
+ * every few milliseconds while there are no samples.
+ */
+void
+FmGui::Spectrum::RunWorker(void)
+{
+	const std::size_t windowMask = config.fftSize - 1;
+	while (!isStopRequested.load(std::memory_order_relaxed)) {
+		const std::size_t drainedCount = samples.Drain(
+			[this, windowMask](float sample) {
+				window[windowHead] = sample;
+				windowHead = (windowHead + 1) & windowMask;
+				++sampleCount;
+				if (++hopCount >= config.hopSize
+					&& sampleCount >= config.fftSize) {
+					hopCount = 0;
+					ComputeRow();
+				}
+			});
+		if (drainedCount == 0) {
+			std::unique_lock<std::mutex> lock(workerMutex);
+			workerCondition.wait_for(lock, std::chrono::milliseconds(2),
+				[this] {
+					return isStopRequested.load(std::memory_order_relaxed);
+				});
+		}
+	}
+}
+
+/*
+ * Transform the last fftSize samples into a row of magnitudes in dB. The row
+ * is dropped if the render thread still holds every pool slot.
+ */
+void
+FmGui::Spectrum::ComputeRow(void)
+{
+	std::uint32_t slot;
+	if (!freeRows.Pop(slot)) {
+		droppedRowCount.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+	const std::size_t fftSize = config.fftSize;
+	// The oldest sample is at the window head.
+	for (std::size_t index = 0; index < fftSize; ++index) {
+		const std::size_t bitReversed = bitReversal[index];
+		fftReal[bitReversed] =
+			window[(windowHead + index) & (fftSize - 1)] * hannWindow[index];
+		fftImaginary[bitReversed] = 0.0f;
+	}
+	TransformFft();
+	float *const pRow = &rowPool[slot * binCount];
+	for (std::size_t bin = 0; bin < binCount; ++bin) {
+		const float magnitude = magnitudeScale
+			* std::sqrt(fftReal[bin] * fftReal[bin]
+						+ fftImaginary[bin] * fftImaginary[bin]);
+		// Floor at -240 dB instead of taking the log of zero.
+		pRow[bin] = 20.0f * std::log10(std::max(magnitude, 1.0e-12f));
+	}
+	finishedRows.Publish(slot);
+}
+
+/*
+ * In place iterative radix-2 FFT of the bit reversed input.
+ */
+void
+FmGui::Spectrum::TransformFft(void)
+{
+	const std::size_t fftSize = config.fftSize;
+	for (std::size_t span = 1; span < fftSize; span *= 2) {
+		const std::size_t twiddleStep = fftSize / (2 * span);
+		for (std::size_t start = 0; start < fftSize; start += 2 * span) {
+			for (std::size_t offset = 0; offset < span; ++offset) {
+				const float wr = twiddleReal[offset * twiddleStep];
+				const float wi = twiddleImaginary[offset * twiddleStep];
+				const std::size_t even = start + offset, odd = even + span;
+				const float oddReal =
+					fftReal[odd] * wr - fftImaginary[odd] * wi;
+				const float oddImaginary =
+					fftReal[odd] * wi + fftImaginary[odd] * wr;
+				fftReal[odd] = fftReal[even] - oddReal;
+				fftImaginary[odd] = fftImaginary[even] - oddImaginary;
+				fftReal[even] += oddReal;
+				fftImaginary[even] += oddImaginary;
+			}
+		}
+	}
+}
+
+const FmGuiSpectrumConfig &
+FmGui::Spectrum::GetConfig(void) const
+{
+	return config;
+}
+
+std::size_t
+FmGui::Spectrum::GetBinCount(void) const
+{
+	return binCount;
+}
+
+float
+FmGui::Spectrum::GetBinWidth(void) const
+{
+	return config.sampleRate / static_cast<float>(config.fftSize);
+}
+
+float
+FmGui::Spectrum::GetRowPeriod(void) const
+{
+	return static_cast<float>(config.hopSize) / config.sampleRate;
+}
+
+const float *
+FmGui::Spectrum::GetHistory(void) const
+{
+	return history.data();
+}
+
+std::size_t
+FmGui::Spectrum::GetHistoryHead(void) const
+{
+	return historyHead;
+}
+
+std::size_t
+FmGui::Spectrum::GetHistoryCount(void) const
+{
+	return historyCount;
+}
+
+const float *
+FmGui::Spectrum::GetNewestRow(void) const
+{
+	if (historyCount == 0)
+		return nullptr;
+	return &history[historyHead * binCount];
+}
+
+std::uint64_t
+FmGui::Spectrum::GetDroppedRowCount(void) const
+{
+	return droppedRowCount.load(std::memory_order_relaxed);
+}
+
+/*
+ * FmGuiSpectrumConfig's members, defined next to the Spectrum that checks
+ * them.
+ */
+FmGuiSpectrumConfig::FmGuiSpectrumConfig(void)
+	: fftSize(1024),
+	  hopSize(256),
+	  sampleRate(1000.0f),
+	  historySize(256)
+{
+}
@@ -0,0 +1,364 @@
+/* =============================================================================
+** DCS-EFM-ImGui, file: FmGuiStats.cpp Created: 17-OCT-2026
+**
+** Copyright 2022 Brian Hoffpauir, USA
+** All rights reserved.
+**
+** Redistribution and use of this source file, with or without modification, is
+** permitted provided that the following conditions are met:
+**
+** 1. Redistributions of this source file must retain the above copyright
+**    notice, this list of conditions and the following disclaimer.
+**
+** 2. Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and/or other materials provided with the distribution.
+**
+** THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+** WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO
+** EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+** PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+** OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+** WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+** OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+** ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+** =============================================================================
+**/
+#include "FmGuiStats.hpp"
+
+#include <cstdint>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+#if defined _M_X64 || defined _M_IX86 || defined __x86_64__ || defined __i386__
+#define FMGUI_STATS_X86 1
+#if defined _MSC_VER
+#include <intrin.h>
+#endif
+#include <immintrin.h>
+// GCC and Clang only emit AVX2 instructions in functions targeting AVX2.
+#if defined __GNUC__
+#define FMGUI_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define FMGUI_TARGET_AVX2
+#endif
+#endif
+
+namespace FmGui
+{
+/*
+ * Partial reduction of one or more spans.
+ */
+struct StatsAccumulator
+{
+	float minimum, maximum;
+	double sum, sumOfSquares;
+};
+using ReducePtr = std::add_pointer<void(const float *pValues,
+	std::size_t count, StatsAccumulator &accumulator)>::type;
+using ReduceRangePtr = std::add_pointer<void(const float *pValues,
+	std::size_t count, float &minimum, float &maximum)>::type;
+// Functions
+static void ReduceScalar(const float *pValues, std::size_t count,
+						 StatsAccumulator &accumulator);
+static void ReduceRangeScalar(const float *pValues, std::size_t count,
+							  float &minimum, float &maximum);
+#if defined FMGUI_STATS_X86
+static void ReduceSse2(const float *pValues, std::size_t count,
+					   StatsAccumulator &accumulator);
+static void ReduceRangeSse2(const float *pValues, std::size_t count,
+							float &minimum, float &maximum);
+FMGUI_TARGET_AVX2 static void ReduceAvx2(const float *pValues,
+	std::size_t count, StatsAccumulator &accumulator);
+FMGUI_TARGET_AVX2 static void ReduceRangeAvx2(const float *pValues,
+	std::size_t count, float &minimum, float &maximum);
+static bool IsAvx2Supported(void);
+#endif
+static FmGuiSimdLevel GetSupportedSimdLevel(void);
+static FmGuiSimdLevel GetActiveSimdLevel(void);
+// Variables
+static constexpr std::uint8_t simdLevelUnset = 0xFF;
+// Selected on first use.
+static std::atomic<std::uint8_t> activeSimdLevel(simdLevelUnset);
+} // namespace FmGui
+
+static void
+FmGui::ReduceScalar(const float *pValues, std::size_t count,
+					StatsAccumulator &accumulator)
+{
+	for (std::size_t index = 0; index < count; ++index) {
+		const float value = pValues[index];
+		accumulator.minimum = std::min(accumulator.minimum, value);
+		accumulator.maximum = std::max(accumulator.maximum, value);
+		accumulator.sum += value;
+		accumulator.sumOfSquares += static_cast<double>(value) * value;
+	}
+}
+
+static void
+FmGui::ReduceRangeScalar(const float *pValues, std::size_t count,
+						 float &minimum, float &maximum)
+{
+	for (std::size_t index = 0; index < count; ++index) {
+		minimum = std::min(minimum, pValues[index]);
+		maximum = std::max(maximum, pValues[index]);
+	}
+}
+
+#if defined FMGUI_STATS_X86
+/*
+ * Four floats per step. The minimum and maximum stay in single precision,
+ * the sums are widened to double precision.
+ */
+static void
+FmGui::ReduceSse2(const float *pValues, std::size_t count,
+				  StatsAccumulator &accumulator)
+{
+	__m128 minimum = _mm_set1_ps(accumulator.minimum);
+	__m128 maximum = _mm_set1_ps(accumulator.maximum);
+	__m128d sum = _mm_setzero_pd(), sumOfSquares = _mm_setzero_pd();
+	std::size_t index = 0;
+	for (; index + 4 <= count; index += 4) {
+		const __m128 values = _mm_loadu_ps(pValues + index);
+		minimum = _mm_min_ps(minimum, values);
+		maximum = _mm_max_ps(maximum, values);
+		const __m128d low = _mm_cvtps_pd(values);
+		const __m128d high = _mm_cvtps_pd(_mm_movehl_ps(values, values));
+		sum = _mm_add_pd(sum, _mm_add_pd(low, high));
+		sumOfSquares = _mm_add_pd(sumOfSquares,
+			_mm_add_pd(_mm_mul_pd(low, low), _mm_mul_pd(high, high)));
+	}
+	alignas(16) float minimums[4], maximums[4];
+	alignas(16) double sums[2], sumsOfSquares[2];
+	_mm_store_ps(minimums, minimum);
+	_mm_store_ps(maximums, maximum);
+	_mm_store_pd(sums, sum);
+	_mm_store_pd(sumsOfSquares, sumOfSquares);
+	accumulator.minimum = *std::min_element(minimums, minimums + 4);
+	accumulator.maximum = *std::max_element(maximums, maximums + 4);
+	accumulator.sum += sums[0] + sums[1];
+	accumulator.sumOfSquares += sumsOfSquares[0] + sumsOfSquares[1];
+	ReduceScalar(pValues + index, count - index, accumulator);
+}
+
+static void
+FmGui::ReduceRangeSse2(const float *pValues, std::size_t count,
+					   float &minimum, float &maximum)
+{
+	__m128 minimums = _mm_set1_ps(minimum), maximums = _mm_set1_ps(maximum);
+	std::size_t index = 0;
+	for (; index + 4 <= count; index += 4) {
+		const __m128 values = _mm_loadu_ps(pValues + index);
+		minimums = _mm_min_ps(minimums, values);
+		maximums = _mm_max_ps(maximums, values);
+	}
+	alignas(16) float lanes[4];
+	_mm_store_ps(lanes, minimums);
+	minimum = *std::min_element(lanes, lanes + 4);
+	_mm_store_ps(lanes, maximums);
+	maximum = *std::max_element(lanes, lanes + 4);
+	ReduceRangeScalar(pValues + index, count - index, minimum, maximum);
+}
+
+/*
+ * Eight floats per step, otherwise the same as ReduceSse2.
+ */
+FMGUI_TARGET_AVX2 static void
+FmGui::ReduceAvx2(const float *pValues, std::size_t count,
+				  StatsAccumulator &accumulator)
+{
+	__m256 minimum = _mm256_set1_ps(accumulator.minimum);
+	__m256 maximum = _mm256_set1_ps(accumulator.maximum);
+	__m256d sum = _mm256_setzero_pd(), sumOfSquares = _mm256_setzero_pd();
+	std::size_t index = 0;
+	for (; index + 8 <= count; index += 8) {
+		const __m256 values = _mm256_loadu_ps(pValues + index);
+		minimum = _mm256_min_ps(minimum, values);
+		maximum = _mm256_max_ps(maximum, values);
+		const __m256d low = _mm256_cvtps_pd(_mm256_castps256_ps128(values));
+		const __m256d high = _mm256_cvtps_pd(_mm256_extractf128_ps(values, 1));
+		sum = _mm256_add_pd(sum, _mm256_add_pd(low, high));
+		sumOfSquares = _mm256_add_pd(sumOfSquares,
+			_mm256_add_pd(_mm256_mul_pd(low, low), _mm256_mul_pd(high, high)));
+	}
+	alignas(32) float minimums[8], maximums[8];
+	alignas(32) double sums[4], sumsOfSquares[4];
+	_mm256_store_ps(minimums, minimum);
+	_mm256_store_ps(maximums, maximum);
+	_mm256_store_pd(sums, sum);
+	_mm256_store_pd(sumsOfSquares, sumOfSquares);
+	accumulator.minimum = *std::min_element(minimums, minimums + 8);
+	accumulator.maximum = *std::max_element(maximums, maximums + 8);
+	accumulator.sum += (sums[0] + sums[1]) + (sums[2] + sums[3]);
+	accumulator.sumOfSquares += (sumsOfSquares[0] + sumsOfSquares[1])
+		+ (sumsOfSquares[2] + sumsOfSquares[3]);
+	ReduceScalar(pValues + index, count - index, accumulator);
+}
+
+FMGUI_TARGET_AVX2 static void
+FmGui::ReduceRangeAvx2(const float *pValues, std::size_t count,
+					   float &minimum, float &maximum)
+{
+	__m256 minimums = _mm256_set1_ps(minimum);
+	__m256 maximums = _mm256_set1_ps(maximum);
+	std::size_t index = 0;
+	for (; index + 8 <= count; index += 8) {
+		const __m256 values = _mm256_loadu_ps(pValues + index);
+		minimums = _mm256_min_ps(minimums, values);
+		maximums = _mm256_max_ps(maximums, values);
+	}
+	alignas(32) float lanes[8];
+	_mm256_store_ps(lanes, minimums);
+	minimum = *std::min_element(lanes, lanes + 8);
+	_mm256_store_ps(lanes, maximums);
+	maximum = *std::max_element(lanes, lanes + 8);
+	ReduceRangeScalar(pValues + index, count - index, minimum, maximum);
+}
+
+/*
+ * AVX2 needs both the CPU feature and the operating system saving the YMM
+ * registers.
+ */
+static bool
+FmGui::IsAvx2Supported(void)
+{
+#if defined _MSC_VER
+	int cpuInfo[4];
+	__cpuid(cpuInfo, 0);
+	if (cpuInfo[0] < 7)
+		return false;
+	__cpuid(cpuInfo, 1);
+	const bool isOsxsaveSupported = (cpuInfo[2] & (1 << 27)) != 0;
+	const bool isAvxSupported = (cpuInfo[2] & (1 << 28)) != 0;
+	if (!isOsxsaveSupported || !isAvxSupported)
+		return false;
+	if ((_xgetbv(0) & 0x6) != 0x6)
+		return false;
+	__cpuidex(cpuInfo, 7, 0);
+	return (cpuInfo[1] & (1 << 5)) != 0;
+#elif defined __GNUC__
+	__builtin_cpu_init();
+	return __builtin_cpu_supports("avx2");
+#else
+	return false;
+#endif
+}
+#endif
+
+static FmGuiSimdLevel
+FmGui::GetSupportedSimdLevel(void)
+{
+#if defined FMGUI_STATS_X86
+	if (IsAvx2Supported())
+		return FmGuiSimdLevel::AVX2;
+#if defined _M_X64 || defined __x86_64__ || defined __SSE2__ \
+	|| (defined _M_IX86_FP && _M_IX86_FP >= 2)
+	return FmGuiSimdLevel::SSE2;
+#endif
+#endif
+	return FmGuiSimdLevel::SCALAR;
+}
+
+static FmGuiSimdLevel
+FmGui::GetActiveSimdLevel(void)
+{
+	std::uint8_t simdLevel = activeSimdLevel.load(std::memory_order_relaxed);
+	if (simdLevel == simdLevelUnset) {
+		simdLevel = static_cast<std::uint8_t>(GetSupportedSimdLevel());
+		activeSimdLevel.store(simdLevel, std::memory_order_relaxed);
+	}
+	return static_cast<FmGuiSimdLevel>(simdLevel);
+}
+
+FmGuiSimdLevel
+FmGui::GetSimdLevel(void)
+{
+	return GetActiveSimdLevel();
+}
+
+FmGuiSimdLevel
+FmGui::SetSimdLevel(FmGuiSimdLevel simdLevel)
+{
+	simdLevel = std::min(simdLevel, GetSupportedSimdLevel());
+	activeSimdLevel.store(static_cast<std::uint8_t>(simdLevel),
+						  std::memory_order_relaxed);
+	return simdLevel;
+}
+
+FmGuiWindowStats
+FmGui::ComputeWindowStats(const float *pValues, std::size_t count)
+{
+	return ComputeWindowStats(pValues, count, nullptr, 0);
+}
+
+FmGuiWindowStats
+FmGui::ComputeWindowStats(const float *pFirst, std::size_t firstCount,
+						  const float *pSecond, std::size_t secondCount)
+{
+	FmGuiWindowStats stats = { firstCount + secondCount, 0.0f, 0.0f,
+							   0.0, 0.0, 0.0 };
+	if (stats.count == 0)
+		return stats;
+	ReducePtr pReduce = ReduceScalar;
+#if defined FMGUI_STATS_X86
+	switch (GetActiveSimdLevel()) {
+	case FmGuiSimdLevel::AVX2:
+		pReduce = ReduceAvx2;
+		break;
+	case FmGuiSimdLevel::SSE2:
+		pReduce = ReduceSse2;
+		break;
+	case FmGuiSimdLevel::SCALAR:
+		break;
+	}
+#endif
+	StatsAccumulator accumulator = {
+		std::numeric_limits<float>::infinity(),
+		-std::numeric_limits<float>::infinity(), 0.0, 0.0
+	};
+	pReduce(pFirst, firstCount, accumulator);
+	pReduce(pSecond, secondCount, accumulator);
+	const double count = static_cast<double>(stats.count);
+	const double meanOfSquares = accumulator.sumOfSquares / count;
+	stats.minimum = accumulator.minimum;
+	stats.maximum = accumulator.maximum;
+	stats.mean = accumulator.sum / count;
+	stats.rms = std::sqrt(meanOfSquares);
+	stats.standardDeviation =
+		std::sqrt(std::max(0.0, meanOfSquares - stats.mean * stats.mean));
+	return stats;
+}
+
+void
+FmGui::ComputeWindowRange(const float *pFirst, std::size_t firstCount,
+						  const float *pSecond, std::size_t secondCount,
+						  float &minimum, float &maximum)
+{
+	if (firstCount + secondCount == 0) {
+		minimum = 0.0f;
+		maximum = 0.0f;
+		return;
+	}
+	ReduceRangePtr pReduceRange = ReduceRangeScalar;
+#if defined FMGUI_STATS_X86
+	switch (GetActiveSimdLevel()) {
+	case FmGuiSimdLevel::AVX2:
+		pReduceRange = ReduceRangeAvx2;
+		break;
+	case FmGuiSimdLevel::SSE2:
+		pReduceRange = ReduceRangeSse2;
+		break;
+	case FmGuiSimdLevel::SCALAR:
+		break;
+	}
+#endif
+	minimum = std::numeric_limits<float>::infinity();
+	maximum = -std::numeric_limits<float>::infinity();
+	pReduceRange(pFirst, firstCount, minimum, maximum);
+	pReduceRange(pSecond, secondCount, minimum, maximum);
+}
@@ -0,0 +1,213 @@
+/* =============================================================================
+** DCS-EFM-ImGui, file: FmGuiCoreInitTest.cpp Created: 17-OCT-2026
+**
+** Copyright 2022 Brian Hoffpauir, USA
+** All rights reserved.
+**
+** Redistribution and use of this source file, with or without modification, is
+** permitted provided that the following conditions are met:
+**
+** 1. Redistributions of this source file must retain the above copyright
+**    notice, this list of conditions and the following disclaimer.
+**
+** 2. Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and/or other materials provided with the distribution.
+**
+** THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+** WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO
+** EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+** PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+** OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+** WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+** OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+** ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+** =============================================================================
+**/
+#include "FmGuiCore.hpp"
+
+#include <imgui.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+/*
+ * Drives the initialization of the headless core through injected faults and
+ * a failing renderer, and checks the retries, their backoff and giving up.
+ * Returns EXIT_FAILURE and prints what went wrong if a check fails.
+ */
+
+#define FMGUI_TEST_CHECK(CONDITION) \
+	CheckCondition((CONDITION), #CONDITION, __LINE__)
+
+static void CheckCondition(bool condition, const char *text, int line);
+static void RecordMessage(const FmGuiMessage &message);
+static bool FailingRendererInitialize(void *pUserData);
+static void Start(const FmGuiConfig &config, bool hasFailingRenderer);
+static void RunFrames(unsigned int count);
+static void TestContextRetries(void);
+static void TestRendererRetries(void);
+static void TestGiveUp(void);
+static void TestBackoffLimit(void);
+
+static FmGuiNullRendererData nullRendererData = { 1280.0f, 720.0f,
+												  1.0f / 60.0f };
+static unsigned int frame = 0;
+// Frames with an initialization attempt, counted from 1.
+static std::vector<unsigned int> attemptFrames;
+static unsigned int rendererFailureCount = 0;
+static bool hasFailed = false;
+
+static void
+CheckCondition(bool condition, const char *text, int line)
+{
+	if (!condition) {
+		std::fprintf(stderr, "FmGuiCoreInitTest: line %d: %s failed\n", line,
+					 text);
+		hasFailed = true;
+	}
+}
+
+static void
+RecordMessage(const FmGuiMessage &message)
+{
+	if (std::strncmp(message.content, "FmGui initialization attempt", 28) == 0
+		|| std::strncmp(message.content, "FmGui gave up", 13) == 0) {
+		attemptFrames.push_back(frame);
+	}
+}
+
+static bool
+FailingRendererInitialize(void *pUserData)
+{
+	if (rendererFailureCount == 0)
+		return true;
+	--rendererFailureCount;
+	return false;
+}
+
+static void
+Start(const FmGuiConfig &config, bool hasFailingRenderer)
+{
+	FmGuiRenderer renderer = FmGui::Core::MakeNullRenderer(&nullRendererData);
+	if (hasFailingRenderer)
+		renderer.pInitialize = FailingRendererInitialize;
+	FmGui::Core::SetRenderer(renderer);
+	FmGui::Core::Startup(config);
+	FmGui::SetWidgetVisibility(true);
+	frame = 0;
+	attemptFrames.clear();
+}
+
+static void
+RunFrames(unsigned int count)
+{
+	for (unsigned int index = 0; index < count; ++index) {
+		++frame;
+		FmGui::Core::Frame();
+	}
+}
+
+/*
+ * Three failed context attempts, each retried after twice the delay of the
+ * previous one, then the fourth attempt succeeds.
+ */
+static void
+TestContextRetries(void)
+{
+	FmGuiConfig config;
+	config.initRetryDelay = 1;
+	Start(config, false);
+	FmGui::Core::InjectInitFault(FmGuiInitState::CONTEXT, 3);
+	RunFrames(10);
+	FMGUI_TEST_CHECK(FmGui::Core::GetInitState() == FmGuiInitState::CONTEXT);
+	const unsigned int expectedFrames[] = { 1, 3, 6 };
+	FMGUI_TEST_CHECK(attemptFrames.size() == 3);
+	for (std::size_t index = 0;
+		 index < attemptFrames.size() && index < 3; ++index) {
+		FMGUI_TEST_CHECK(attemptFrames[index] == expectedFrames[index]);
+	}
+	++frame;
+	FMGUI_TEST_CHECK(FmGui::Core::Frame());
+	FMGUI_TEST_CHECK(FmGui::Core::GetInitState() == FmGuiInitState::READY);
+	FmGui::Core::Shutdown();
+}
+
+/*
+ * A failing renderer is retried without creating the context again.
+ */
+static void
+TestRendererRetries(void)
+{
+	FmGuiConfig config;
+	config.initRetryDelay = 1;
+	rendererFailureCount = 2;
+	Start(config, true);
+	RunFrames(1);
+	FMGUI_TEST_CHECK(FmGui::Core::GetInitState()
+					 == FmGuiInitState::RENDERER);
+	ImGuiContext *const pContext = ImGui::GetCurrentContext();
+	FMGUI_TEST_CHECK(pContext != nullptr);
+	RunFrames(5);
+	FMGUI_TEST_CHECK(attemptFrames.size() == 2);
+	FMGUI_TEST_CHECK(FmGui::Core::GetInitState() == FmGuiInitState::READY);
+	FMGUI_TEST_CHECK(ImGui::GetCurrentContext() == pContext);
+	FmGui::Core::Shutdown();
+}
+
+/*
+ * Once the attempt limit is reached no further attempt is made.
+ */
+static void
+TestGiveUp(void)
+{
+	FmGuiConfig config;
+	config.initAttemptLimit = 3;
+	config.initRetryDelay = 1;
+	Start(config, false);
+	FmGui::Core::InjectInitFault(FmGuiInitState::CONTEXT, 100);
+	RunFrames(1000);
+	FMGUI_TEST_CHECK(FmGui::Core::GetInitState() == FmGuiInitState::GAVE_UP);
+	FMGUI_TEST_CHECK(attemptFrames.size() == 3);
+	FMGUI_TEST_CHECK(!FmGui::Core::Frame());
+	FmGui::Core::Shutdown();
+}
+
+/*
+ * The delay is capped at 600 frames, also when doubling a large configured
+ * delay would overflow.
+ */
+static void
+TestBackoffLimit(void)
+{
+	FmGuiConfig config;
+	config.initRetryDelay = 0x80000000u;
+	Start(config, false);
+	FmGui::Core::InjectInitFault(FmGuiInitState::CONTEXT, 3);
+	RunFrames(1203);
+	const unsigned int expectedFrames[] = { 1, 602, 1203 };
+	FMGUI_TEST_CHECK(attemptFrames.size() == 3);
+	for (std::size_t index = 0;
+		 index < attemptFrames.size() && index < 3; ++index) {
+		FMGUI_TEST_CHECK(attemptFrames[index] == expectedFrames[index]);
+	}
+	FmGui::Core::Shutdown();
+}
+
+int
+main(void)
+{
+	FmGui::SetMessageCallback(RecordMessage);
+	TestContextRetries();
+	TestRendererRetries();
+	TestGiveUp();
+	TestBackoffLimit();
+	if (hasFailed)
+		return EXIT_FAILURE;
+	std::printf("FmGuiCoreInitTest: passed\n");
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,225 @@
+/* =============================================================================
+** DCS-EFM-ImGui, file: FmGuiFrameAllocTest.cpp Created: 17-OCT-2026
+**
+** Copyright 2022 Brian Hoffpauir, USA
+** All rights reserved.
+**
+** Redistribution and use of this source file, with or without modification, is
+** permitted provided that the following conditions are met:
+**
+** 1. Redistributions of this source file must retain the above copyright
+**    notice, this list of conditions and the following disclaimer.
+**
+** 2. Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and/or other materials provided with the distribution.
+**
+** THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+** WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO
+** EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+** PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+** OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+** WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+** OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+** ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+** =============================================================================
+**/
+#include "FmGuiCore.hpp"
+#include "FmGuiAllocator.hpp"
+#include "FmGuiInput.hpp"
+#include "FmGuiPanels.hpp"
+#include "FmGuiProfiler.hpp"
+
+#include <imgui.h>
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+
+/*
+ * Runs the headless core with widgets, registered panels, profiler scopes,
+ * the built-in windows and a recorded stream of mouse input, and fails if a
+ * frame after the warm up allocates more than the given number of times. The
+ * count covers ImGui's allocations through FmGui::Allocator and every
+ * operator new of the main thread, which this file replaces.
+ *
+ * Usage: FmGuiFrameAllocTest <max frame allocations> [directory]
+ */
+
+static void PrintMessage(const FmGuiMessage &message);
+static void WidgetRoutine(void);
+static void EnginePanel(void);
+static void FuelPanel(void);
+static bool CheckFrame(unsigned int frame, unsigned long maxAllocations);
+
+static constexpr unsigned int warmupFrameCount = 120;
+static constexpr unsigned int checkedFrameCount = 600;
+static FmGuiNullRendererData nullRendererData = { 1280.0f, 720.0f,
+												  1.0f / 60.0f };
+static unsigned int overLimitFrameCount = 0;
+// Only the main thread runs frames.
+static thread_local bool isMainThread = false;
+
+void *
+operator new(std::size_t size)
+{
+	if (isMainThread)
+		FmGui::Allocator::CountExternalAllocation();
+	void *pMemory = std::malloc(size != 0 ? size : 1);
+	if (pMemory == nullptr)
+		throw std::bad_alloc();
+	return pMemory;
+}
+
+void
+operator delete(void *pMemory) noexcept
+{
+	std::free(pMemory);
+}
+
+static void
+PrintMessage(const FmGuiMessage &message)
+{
+	std::fprintf(stderr, "FmGuiFrameAllocTest: %s\n", message.content);
+}
+
+static void
+WidgetRoutine(void)
+{
+	FmGui::Profiler::Scope scope("WidgetRoutine");
+	static float throttle = 0.5f;
+	static bool isAutopilotEngaged = false;
+	if (ImGui::Begin("Controls")) {
+		ImGui::Text("Throttle %.0f %%", throttle * 100.0f);
+		ImGui::SliderFloat("Throttle", &throttle, 0.0f, 1.0f);
+		ImGui::Checkbox("Autopilot", &isAutopilotEngaged);
+		if (ImGui::Button("Reset"))
+			throttle = 0.5f;
+		if (ImGui::BeginTable("Gauges", 2)) {
+			for (int row = 0; row < 8; ++row) {
+				ImGui::TableNextRow();
+				ImGui::TableNextColumn();
+				ImGui::Text("Gauge %d", row);
+				ImGui::TableNextColumn();
+				ImGui::Text("%.3f", throttle * static_cast<float>(row));
+			}
+			ImGui::EndTable();
+		}
+	}
+	ImGui::End();
+}
+
+static void
+EnginePanel(void)
+{
+	FmGui::Profiler::Scope scope("EnginePanel");
+	if (ImGui::Begin("Engine")) {
+		for (int stage = 0; stage < 16; ++stage)
+			ImGui::Text("Stage %d: %.1f K", stage, 600.0f + 10.0f * stage);
+	}
+	ImGui::End();
+}
+
+static void
+FuelPanel(void)
+{
+	FmGui::Profiler::Scope scope("FuelPanel");
+	if (ImGui::Begin("Fuel")) {
+		static float volumes[32] = {};
+		static unsigned int runCount = 0;
+		volumes[runCount % 32] = static_cast<float>(runCount % 97);
+		++runCount;
+		ImGui::PlotLines("Volume", volumes, 32);
+	}
+	ImGui::End();
+}
+
+static bool
+CheckFrame(unsigned int frame, unsigned long maxAllocations)
+{
+	const FmGuiAllocatorStats stats = FmGui::Allocator::GetStats();
+	if (stats.frameAllocationCount <= maxAllocations)
+		return true;
+	const FmGuiFrameStats frameStats = FmGui::GetFrameStats();
+	const FmGuiStageStats *const stages = frameStats.stages;
+	if (++overLimitFrameCount <= 10) {
+		std::fprintf(stderr, "FmGuiFrameAllocTest: frame %u made %u "
+					 "allocations, over the limit of %lu (NewFrame %u, "
+					 "Routine %u, Render %u, RenderDrawData %u, Present %u)\n",
+					 frame, static_cast<unsigned int>(
+						 stats.frameAllocationCount), maxAllocations,
+					 stages[0].lastAllocationCount,
+					 stages[1].lastAllocationCount,
+					 stages[2].lastAllocationCount,
+					 stages[3].lastAllocationCount,
+					 stages[4].lastAllocationCount);
+	}
+	return false;
+}
+
+int
+main(int argc, char **argv)
+{
+	isMainThread = true;
+	char *pEnd = nullptr;
+	const unsigned long maxAllocations =
+		(argc >= 2) ? std::strtoul(argv[1], &pEnd, 10) : 0;
+	if (argc < 2 || argc > 3 || pEnd == argv[1] || *pEnd != '\0') {
+		std::fprintf(stderr, "Usage: FmGuiFrameAllocTest "
+					 "<max frame allocations> [directory]\n");
+		return EXIT_FAILURE;
+	}
+	const std::string inputFileName = (argc == 3)
+		? std::string(argv[2]) + "/FmGuiFrameAllocTest.fminp"
+		: std::string("FmGuiFrameAllocTest.fminp");
+	FmGui::SetMessageCallback(PrintMessage);
+	FmGuiPanelConfig fuelConfig;
+	fuelConfig.refreshRate = 10.0f;
+	FmGui::Panels::Register("Engine", EnginePanel);
+	FmGui::Panels::Register("Fuel", FuelPanel, fuelConfig);
+	FmGui::Core::SetRenderer(FmGui::Core::MakeNullRenderer(&nullRendererData));
+	if (!FmGui::Core::Startup())
+		return EXIT_FAILURE;
+	FmGui::SetRoutinePtr(WidgetRoutine);
+	FmGui::SetWidgetVisibility(true);
+	FmGui::SetFrameStatsVisibility(true);
+	FmGui::Profiler::SetPanelVisibility(true);
+	FmGui::Panels::SetListVisibility(true);
+	if (!FmGui::Input::StartRecording(inputFileName.c_str()))
+		return EXIT_FAILURE;
+
+	unsigned int frame = 0, checkedFrame = 0;
+	while (checkedFrame < checkedFrameCount && frame < 10000) {
+		// Circle over the windows so they are hovered in turn.
+		const float angle = static_cast<float>(frame) * 0.05f;
+		FmGui::Input::PushMousePos(400.0f + 300.0f * std::cos(angle),
+								   300.0f + 200.0f * std::sin(angle));
+		++frame;
+		if (FmGui::Core::Frame() && frame > warmupFrameCount) {
+			CheckFrame(frame, maxAllocations);
+			++checkedFrame;
+		} else if (FmGui::Core::GetInitState() == FmGuiInitState::GAVE_UP) {
+			break;
+		}
+	}
+	FmGui::Input::StopRecording();
+	FmGui::Core::Shutdown();
+	std::remove(inputFileName.c_str());
+	if (checkedFrame < checkedFrameCount) {
+		std::fprintf(stderr, "FmGuiFrameAllocTest: only %u frames ran\n",
+					 checkedFrame);
+		return EXIT_FAILURE;
+	}
+	if (overLimitFrameCount != 0) {
+		std::fprintf(stderr, "FmGuiFrameAllocTest: %u of %u frames over the "
+					 "limit\n", overLimitFrameCount, checkedFrame);
+		return EXIT_FAILURE;
+	}
+	std::printf("FmGuiFrameAllocTest: passed\n");
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,274 @@
+/* =============================================================================
+** DCS-EFM-ImGui, file: FmGuiHistoryTest.cpp Created: 17-OCT-2026
+**
+** Copyright 2022 Brian Hoffpauir, USA
+** All rights reserved.
+**
+** Redistribution and use of this source file, with or without modification, is
+** permitted provided that the following conditions are met:
+**
+** 1. Redistributions of this source file must retain the above copyright
+**    notice, this list of conditions and the following disclaimer.
+**
+** 2. Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and/or other materials provided with the distribution.
+**
+** THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+** WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO
+** EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+** PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+** OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+** WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+** OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+** ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+** =============================================================================
+**/
+#include "FmGuiHistory.hpp"
+#include "FmGuiCore.hpp"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+/*
+ * Records generated states into histories small enough to wrap many times
+ * and checks every kept state is reconstructed bit for bit, including while
+ * scrubbing forwards and backwards through the reconstruction cache. Returns
+ * EXIT_FAILURE and prints what went wrong if a check fails.
+ */
+
+#define FMGUI_TEST_CHECK(CONDITION) \
+	CheckCondition((CONDITION), #CONDITION, __LINE__)
+
+/*
+ * Not a multiple of 8 bytes, so the padded last word is covered too.
+ */
+struct TestState
+{
+	std::uint8_t bytes[1003];
+};
+
+using TestHistory = FmGui::StateHistory<TestState>;
+
+static void CheckCondition(bool condition, const char *text, int line);
+static void PrintMessage(const FmGuiMessage &message);
+static double TickTime(unsigned int tick);
+static unsigned int TimeTick(double time);
+static void GenerateState(unsigned int tick, TestState &state);
+static bool IsReconstructed(TestHistory &history, std::size_t index);
+static void CheckEveryState(TestHistory &history);
+static void TestWrapByBytes(void);
+static void TestWrapByStates(void);
+static void TestScrub(void);
+
+static constexpr std::size_t stateSize = sizeof(TestState);
+static bool hasFailed = false;
+
+static void
+CheckCondition(bool condition, const char *text, int line)
+{
+	if (!condition) {
+		std::fprintf(stderr, "FmGuiHistoryTest: line %d: %s failed\n", line,
+					 text);
+		hasFailed = true;
+	}
+}
+
+static void
+PrintMessage(const FmGuiMessage &message)
+{
+	std::fprintf(stderr, "FmGuiHistoryTest: %s\n", message.content);
+}
+
+static double
+TickTime(unsigned int tick)
+{
+	return static_cast<double>(tick) * 0.01;
+}
+
+static unsigned int
+TimeTick(double time)
+{
+	return static_cast<unsigned int>(std::lround(time * 100.0));
+}
+
+/*
+ * Every 50 ticks the whole state changes, otherwise only a few bytes do,
+ * which gives both large and small deltas.
+ */
+static void
+GenerateState(unsigned int tick, TestState &state)
+{
+	const unsigned int epoch = tick / 50;
+	for (std::size_t index = 0; index < stateSize; ++index) {
+		state.bytes[index] =
+			static_cast<std::uint8_t>(index * 7 + epoch * 13);
+	}
+	for (unsigned int change = 0; change < 3; ++change) {
+		const std::size_t index = (tick * 31 + change * 337) % stateSize;
+		state.bytes[index] = static_cast<std::uint8_t>(tick + change);
+	}
+	// The last byte lives in the padded word.
+	state.bytes[stateSize - 1] = static_cast<std::uint8_t>(tick >> 2);
+}
+
+/*
+ * Whether the state at index is the one generated for its time.
+ */
+static bool
+IsReconstructed(TestHistory &history, std::size_t index)
+{
+	TestState expected, actual;
+	std::memset(&actual, 0xCD, sizeof(actual));
+	GenerateState(TimeTick(history.GetTime(index)), expected);
+	return history.Reconstruct(index, actual)
+		&& std::memcmp(&expected, &actual, sizeof(actual)) == 0;
+}
+
+static void
+CheckEveryState(TestHistory &history)
+{
+	for (std::size_t index = 0; index < history.GetSize(); ++index) {
+		const bool isExact = IsReconstructed(history, index);
+		// Report the first differing state only.
+		FMGUI_TEST_CHECK(isExact);
+		if (!isExact)
+			return;
+	}
+	TestState state;
+	FMGUI_TEST_CHECK(!history.Reconstruct(history.GetSize(), state));
+}
+
+/*
+ * The ring of bytes fills before the state limit, so whole keyframe groups
+ * are evicted to make room. Checked after every few states to cover many
+ * positions of the wrap around.
+ */
+static void
+TestWrapByBytes(void)
+{
+	FmGuiStateHistoryConfig config;
+	config.byteCapacity = 16 * 1024;
+	config.stateCapacity = 100000;
+	config.keyframeInterval = 8;
+	static TestHistory history(config);
+	const unsigned int tickCount = 5000;
+	TestState state;
+	for (unsigned int tick = 0; tick < tickCount; ++tick) {
+		GenerateState(tick, state);
+		history.Record(TickTime(tick), state);
+		FMGUI_TEST_CHECK(history.GetMemoryUsage() <= config.byteCapacity);
+		if (tick % 97 == 0)
+			CheckEveryState(history);
+	}
+	FMGUI_TEST_CHECK(history.GetSize() < tickCount);
+	FMGUI_TEST_CHECK(TimeTick(history.GetTime(0)) > 0);
+	FMGUI_TEST_CHECK(TimeTick(history.GetTime(history.GetSize() - 1))
+					 == tickCount - 1);
+	// The oldest state kept is always a keyframe.
+	FMGUI_TEST_CHECK(history.GetKeyframeCount() > 0);
+	CheckEveryState(history);
+}
+
+/*
+ * The state limit is reached first, so the oldest keyframe and its deltas are
+ * evicted whenever the history is full, leaving fewer states than the limit.
+ */
+static void
+TestWrapByStates(void)
+{
+	FmGuiStateHistoryConfig config;
+	config.byteCapacity = 4 * 1024 * 1024;
+	config.stateCapacity = 300;
+	config.keyframeInterval = 16;
+	static TestHistory history(config);
+	const unsigned int tickCount = 2000;
+	TestState state;
+	for (unsigned int tick = 0; tick < tickCount; ++tick) {
+		GenerateState(tick, state);
+		history.Record(TickTime(tick), state);
+		FMGUI_TEST_CHECK(history.GetSize() <= config.stateCapacity);
+		if (tick % 89 == 0)
+			CheckEveryState(history);
+	}
+	FMGUI_TEST_CHECK(history.GetSize() > 0);
+	FMGUI_TEST_CHECK(TimeTick(history.GetTime(history.GetSize() - 1))
+					 == tickCount - 1);
+	CheckEveryState(history);
+	for (std::size_t index = 0; index < history.GetSize(); index += 37) {
+		FMGUI_TEST_CHECK(history.FindIndex(history.GetTime(index)) == index);
+	}
+	FMGUI_TEST_CHECK(history.FindIndex(history.GetTime(0) - 1.0) == 0);
+}
+
+/*
+ * Scrubbing steps from the last reconstruction. The cache must give the same
+ * states forwards, backwards, in place and across keyframes, and stay
+ * correct when recording evicts the states it was built from.
+ */
+static void
+TestScrub(void)
+{
+	FmGuiStateHistoryConfig config;
+	config.byteCapacity = 12 * 1024;
+	config.keyframeInterval = 8;
+	static TestHistory history(config);
+	TestState state;
+	unsigned int tick = 0;
+	for (; tick < 1000; ++tick) {
+		GenerateState(tick, state);
+		history.Record(TickTime(tick), state);
+	}
+	const std::size_t size = history.GetSize();
+	FMGUI_TEST_CHECK(size > 20);
+	if (size <= 20)
+		return;
+	bool isExact = true;
+	// Forwards across several keyframes, then backwards over the same states.
+	for (std::size_t index = 0; index < size; ++index)
+		isExact = isExact && IsReconstructed(history, index);
+	FMGUI_TEST_CHECK(isExact);
+	for (std::size_t index = size; index-- > 0;)
+		isExact = isExact && IsReconstructed(history, index);
+	FMGUI_TEST_CHECK(isExact);
+	// The same state twice, then back and forth around a keyframe.
+	const std::size_t middle = size / 2;
+	const std::size_t steps[] = { middle, middle, middle + 1, middle - 1,
+								  middle + 9, middle - 9, middle + 3 };
+	for (std::size_t step : steps)
+		isExact = isExact && IsReconstructed(history, step);
+	FMGUI_TEST_CHECK(isExact);
+	// Scrub while recording keeps evicting the oldest states.
+	for (unsigned int round = 0; round < 200; ++round, ++tick) {
+		GenerateState(tick, state);
+		history.Record(TickTime(tick), state);
+		const std::size_t index = (round % 2 == 0)
+			? history.GetSize() - 1 - (round % 11)
+			: round % 5;
+		isExact = isExact && IsReconstructed(history, index);
+		isExact = isExact && IsReconstructed(history, index / 2);
+	}
+	FMGUI_TEST_CHECK(isExact);
+	history.Clear();
+	FMGUI_TEST_CHECK(history.GetSize() == 0);
+	FMGUI_TEST_CHECK(!history.Reconstruct(0, state));
+}
+
+int
+main(void)
+{
+	FmGui::SetMessageCallback(PrintMessage);
+	TestWrapByBytes();
+	TestWrapByStates();
+	TestScrub();
+	if (hasFailed)
+		return EXIT_FAILURE;
+	std::printf("FmGuiHistoryTest: passed\n");
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,320 @@
+/* =============================================================================
+** DCS-EFM-ImGui, file: FmGuiRecorderTest.cpp Created: 17-OCT-2026
+**
+** Copyright 2022 Brian Hoffpauir, USA
+** All rights reserved.
+**
+** Redistribution and use of this source file, with or without modification, is
+** permitted provided that the following conditions are met:
+**
+** 1. Redistributions of this source file must retain the above copyright
+**    notice, this list of conditions and the following disclaimer.
+**
+** 2. Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and/or other materials provided with the distribution.
+**
+** THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+** WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO
+** EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+** PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+** OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+** WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+** OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+** ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+** =============================================================================
+**/
+#include "FmGuiRecorder.hpp"
+#include "FmGuiCore.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+/*
+ * Writes a recording and reads it back whole, without its trailer and cut
+ * off in the middle of a chunk, and checks chunk lookups at the chunk
+ * boundaries. Returns EXIT_FAILURE and prints what went wrong if a check
+ * fails.
+ *
+ * Usage: FmGuiRecorderTest [directory for the recordings]
+ */
+
+#define FMGUI_TEST_CHECK(CONDITION) \
+	CheckCondition((CONDITION), #CONDITION, __LINE__)
+
+static void CheckCondition(bool condition, const char *text, int line);
+static void PrintMessage(const FmGuiMessage &message);
+static double RowTime(unsigned int row);
+static float RowValue(unsigned int row, std::size_t channel);
+static bool WriteRecording(const std::string &fileName);
+static bool ReadFile(const std::string &fileName, std::vector<char> &bytes);
+static bool WriteFile(const std::string &fileName,
+					  const std::vector<char> &bytes, std::size_t size);
+static void CheckRows(const FmGui::Recording &recording,
+					  unsigned int expectedRowCount);
+static void TestRoundTrip(void);
+static void TestWithoutTrailer(void);
+static void TestTruncatedChunk(void);
+static void TestFindChunk(void);
+
+static constexpr unsigned int rowCount = 1000;
+static constexpr std::size_t chunkRows = 64;
+static constexpr std::size_t channelCount = 3;
+// Chunks in a complete recording, the last one partial.
+static constexpr std::size_t chunkCount =
+	(rowCount + chunkRows - 1) / chunkRows;
+// Tag, zero and the offset of the last index.
+static constexpr std::size_t trailerSize = 16;
+static std::string recordingFileName, recoveredFileName, truncatedFileName;
+static bool hasFailed = false;
+
+static void
+CheckCondition(bool condition, const char *text, int line)
+{
+	if (!condition) {
+		std::fprintf(stderr, "FmGuiRecorderTest: line %d: %s failed\n", line,
+					 text);
+		hasFailed = true;
+	}
+}
+
+static void
+PrintMessage(const FmGuiMessage &message)
+{
+	std::fprintf(stderr, "FmGuiRecorderTest: %s\n", message.content);
+}
+
+/*
+ * Times are not evenly spaced, so a chunk boundary is never halfway between
+ * two rows by accident.
+ */
+static double
+RowTime(unsigned int row)
+{
+	return static_cast<double>(row) * 0.01
+		+ static_cast<double>(row % 7) * 0.001;
+}
+
+static float
+RowValue(unsigned int row, std::size_t channel)
+{
+	return static_cast<float>(row) * 0.25f
+		+ static_cast<float>(channel) * 1000.0f;
+}
+
+static bool
+WriteRecording(const std::string &fileName)
+{
+	FmGuiRecorderConfig config;
+	config.channelNames = { "Alpha", "Nz", "Pitch rate" };
+	config.chunkRows = chunkRows;
+	config.chunkPoolSize = 4;
+	config.checkpointInterval = 4;
+	static FmGui::Recorder recorder;
+	if (!recorder.Start(fileName.c_str(), config))
+		return false;
+	for (unsigned int row = 0; row < rowCount; ++row) {
+		float values[channelCount];
+		for (std::size_t channel = 0; channel < channelCount; ++channel)
+			values[channel] = RowValue(row, channel);
+		// Retry a dropped row once the writer has caught up.
+		while (!recorder.Record(RowTime(row), values))
+			std::this_thread::yield();
+	}
+	recorder.Stop();
+	return true;
+}
+
+static bool
+ReadFile(const std::string &fileName, std::vector<char> &bytes)
+{
+	std::FILE *const pFile = std::fopen(fileName.c_str(), "rb");
+	if (pFile == nullptr)
+		return false;
+	bytes.clear();
+	char buffer[4096];
+	std::size_t readSize = 0;
+	while ((readSize = std::fread(buffer, 1, sizeof(buffer), pFile)) > 0)
+		bytes.insert(bytes.end(), buffer, buffer + readSize);
+	std::fclose(pFile);
+	return true;
+}
+
+static bool
+WriteFile(const std::string &fileName, const std::vector<char> &bytes,
+		  std::size_t size)
+{
+	std::FILE *const pFile = std::fopen(fileName.c_str(), "wb");
+	if (pFile == nullptr)
+		return false;
+	const bool isWritten = std::fwrite(bytes.data(), 1, size, pFile) == size;
+	return std::fclose(pFile) == 0 && isWritten;
+}
+
+/*
+ * The chunks of the recording hold exactly the first rowCount rows, bit for
+ * bit, with the chunk times matching their rows.
+ */
+static void
+CheckRows(const FmGui::Recording &recording, unsigned int expectedRowCount)
+{
+	FMGUI_TEST_CHECK(recording.GetChannelCount() == channelCount);
+	FMGUI_TEST_CHECK(recording.GetChannelName(2) == "Pitch rate");
+	FMGUI_TEST_CHECK(recording.FindChannel("Nz") == 1);
+	FMGUI_TEST_CHECK(recording.FindChannel("Beta") == channelCount);
+	const std::vector<FmGuiRecordingChunkInfo> &chunks = recording.GetChunks();
+	FmGuiRecordingChunk columns;
+	unsigned int row = 0;
+	for (std::size_t chunk = 0; chunk < chunks.size(); ++chunk) {
+		const bool isRead = recording.ReadChunk(chunk, columns);
+		FMGUI_TEST_CHECK(isRead);
+		if (!isRead)
+			return;
+		const std::size_t size = columns.times.size();
+		FMGUI_TEST_CHECK(size > 0 && size <= chunkRows);
+		FMGUI_TEST_CHECK(chunks[chunk].firstTime == columns.times.front());
+		FMGUI_TEST_CHECK(chunks[chunk].lastTime == columns.times.back());
+		for (std::size_t index = 0; index < size; ++index, ++row) {
+			const double time = RowTime(row);
+			bool isExact = std::memcmp(&columns.times[index], &time,
+									   sizeof(time)) == 0;
+			for (std::size_t channel = 0; channel < channelCount; ++channel) {
+				const float value = RowValue(row, channel);
+				isExact = isExact && std::memcmp(
+					&columns.GetColumn(channel)[index], &value,
+					sizeof(value)) == 0;
+			}
+			// Report the first differing row only.
+			FMGUI_TEST_CHECK(isExact);
+			if (!isExact)
+				return;
+		}
+	}
+	FMGUI_TEST_CHECK(row == expectedRowCount);
+	FMGUI_TEST_CHECK(!recording.ReadChunk(chunks.size(), columns));
+}
+
+static void
+TestRoundTrip(void)
+{
+	FmGui::Recording recording;
+	FMGUI_TEST_CHECK(recording.Open(recordingFileName.c_str()));
+	FMGUI_TEST_CHECK(!recording.IsRecovered());
+	FMGUI_TEST_CHECK(recording.GetChunks().size() == chunkCount);
+	FMGUI_TEST_CHECK(recording.GetStartTime() == RowTime(0));
+	FMGUI_TEST_CHECK(recording.GetEndTime() == RowTime(rowCount - 1));
+	CheckRows(recording, rowCount);
+}
+
+/*
+ * A file whose writer never got to the trailer, e.g. after a crash, is
+ * scanned and loses nothing that was written.
+ */
+static void
+TestWithoutTrailer(void)
+{
+	std::vector<char> bytes;
+	FMGUI_TEST_CHECK(ReadFile(recordingFileName, bytes));
+	FMGUI_TEST_CHECK(bytes.size() > trailerSize);
+	FMGUI_TEST_CHECK(WriteFile(recoveredFileName, bytes,
+							   bytes.size() - trailerSize));
+	FmGui::Recording recording;
+	FMGUI_TEST_CHECK(recording.Open(recoveredFileName.c_str()));
+	FMGUI_TEST_CHECK(recording.IsRecovered());
+	FMGUI_TEST_CHECK(recording.GetChunks().size() == chunkCount);
+	CheckRows(recording, rowCount);
+}
+
+/*
+ * A file cut off in the middle of a chunk keeps the complete chunks before
+ * it and drops the partial one.
+ */
+static void
+TestTruncatedChunk(void)
+{
+	std::vector<FmGuiRecordingChunkInfo> chunks;
+	{
+		FmGui::Recording recording;
+		FMGUI_TEST_CHECK(recording.Open(recordingFileName.c_str()));
+		chunks = recording.GetChunks();
+	}
+	const std::size_t keptCount = 9;
+	FMGUI_TEST_CHECK(chunks.size() > keptCount);
+	if (chunks.size() <= keptCount)
+		return;
+	std::vector<char> bytes;
+	FMGUI_TEST_CHECK(ReadFile(recordingFileName, bytes));
+	// Past the chunk header and into the times of chunk keptCount.
+	const std::size_t size =
+		static_cast<std::size_t>(chunks[keptCount].offset) + 24 + 8 * 10;
+	FMGUI_TEST_CHECK(WriteFile(truncatedFileName, bytes, size));
+	FmGui::Recording recording;
+	FMGUI_TEST_CHECK(recording.Open(truncatedFileName.c_str()));
+	FMGUI_TEST_CHECK(recording.IsRecovered());
+	FMGUI_TEST_CHECK(recording.GetChunks().size() == keptCount);
+	FMGUI_TEST_CHECK(recording.GetEndTime()
+					 == RowTime(keptCount * chunkRows - 1));
+	CheckRows(recording, keptCount * chunkRows);
+}
+
+/*
+ * Each chunk is found by its own first and last time, a time in the gap
+ * after a chunk finds the next one and times outside the recording find the
+ * first and last chunk.
+ */
+static void
+TestFindChunk(void)
+{
+	FmGui::Recording recording;
+	FMGUI_TEST_CHECK(recording.Open(recordingFileName.c_str()));
+	const std::vector<FmGuiRecordingChunkInfo> &chunks = recording.GetChunks();
+	FMGUI_TEST_CHECK(chunks.size() == chunkCount);
+	for (std::size_t chunk = 0; chunk < chunks.size(); ++chunk) {
+		FMGUI_TEST_CHECK(recording.FindChunk(chunks[chunk].firstTime)
+						 == chunk);
+		FMGUI_TEST_CHECK(recording.FindChunk(chunks[chunk].lastTime)
+						 == chunk);
+		if (chunk + 1 < chunks.size()) {
+			const double gapTime = 0.5 * (chunks[chunk].lastTime
+										  + chunks[chunk + 1].firstTime);
+			FMGUI_TEST_CHECK(recording.FindChunk(gapTime) == chunk + 1);
+		}
+	}
+	FMGUI_TEST_CHECK(recording.FindChunk(RowTime(0) - 1.0) == 0);
+	FMGUI_TEST_CHECK(recording.FindChunk(RowTime(rowCount) + 1.0)
+					 == chunks.size() - 1);
+}
+
+int
+main(int argc, char **argv)
+{
+	FmGui::SetMessageCallback(PrintMessage);
+	const std::string directory = (argc > 1) ? std::string(argv[1]) + "/" : "";
+	recordingFileName = directory + "FmGuiRecorderTest.fmrec";
+	recoveredFileName = directory + "FmGuiRecorderTestRecovered.fmrec";
+	truncatedFileName = directory + "FmGuiRecorderTestTruncated.fmrec";
+	if (!WriteRecording(recordingFileName)) {
+		std::fprintf(stderr, "FmGuiRecorderTest: cannot write %s\n",
+					 recordingFileName.c_str());
+		return EXIT_FAILURE;
+	}
+	TestRoundTrip();
+	TestWithoutTrailer();
+	TestTruncatedChunk();
+	TestFindChunk();
+	std::remove(recordingFileName.c_str());
+	std::remove(recoveredFileName.c_str());
+	std::remove(truncatedFileName.c_str());
+	if (hasFailed)
+		return EXIT_FAILURE;
+	std::printf("FmGuiRecorderTest: passed\n");
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,80 @@
+/* =============================================================================
+** DCS-EFM-ImGui, file: FmGuiReplayFixture.cpp Created: 17-OCT-2026
+**
+** Copyright 2022 Brian Hoffpauir, USA
+** All rights reserved.
+**
+** Redistribution and use of this source file, with or without modification, is
+** permitted provided that the following conditions are met:
+**
+** 1. Redistributions of this source file must retain the above copyright
+**    notice, this list of conditions and the following disclaimer.
+**
+** 2. Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and/or other materials provided with the distribution.
+**
+** THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+** WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO
+** EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+** PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+** OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+** WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+** OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+** ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+** =============================================================================
+**/
+#include "FmGuiRecorder.hpp"
+#include "FmGuiCore.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+
+/*
+ * Writes the recording FmGuiReplay is run on by the FmGuiReplayAllocations
+ * test: 20 seconds of three 100 Hz channels, in chunks small enough that the
+ * replay loads several of them after its warm up.
+ *
+ * Usage: FmGuiReplayFixture <recording>
+ */
+
+static void PrintMessage(const FmGuiMessage &message);
+
+static void
+PrintMessage(const FmGuiMessage &message)
+{
+	std::fprintf(stderr, "FmGuiReplayFixture: %s\n", message.content);
+}
+
+int
+main(int argc, char **argv)
+{
+	if (argc != 2) {
+		std::fprintf(stderr, "Usage: FmGuiReplayFixture <recording>\n");
+		return EXIT_FAILURE;
+	}
+	FmGui::SetMessageCallback(PrintMessage);
+	FmGuiRecorderConfig config;
+	config.channelNames = { "Alpha", "Nz", "Pitch rate" };
+	config.chunkRows = 256;
+	static FmGui::Recorder recorder;
+	if (!recorder.Start(argv[1], config))
+		return EXIT_FAILURE;
+	for (unsigned int row = 0; row < 2000; ++row) {
+		const double time = static_cast<double>(row) * 0.01;
+		const float values[3] = {
+			static_cast<float>(5.0 + 3.0 * std::sin(0.5 * time)),
+			static_cast<float>(1.0 + 0.2 * std::sin(2.0 * time)),
+			static_cast<float>(4.0 * std::cos(0.5 * time))
+		};
+		// Wait for the writer rather than drop rows of the fixture.
+		while (!recorder.Record(time, values))
+			std::this_thread::yield();
+	}
+	recorder.Stop();
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,119 @@
+/* =============================================================================
+** DCS-EFM-ImGui, file: FmGuiHiddenFrameBenchmark.cpp Created: 17-OCT-2026
+**
+** Copyright 2022 Brian Hoffpauir, USA
+** All rights reserved.
+**
+** Redistribution and use of this source file, with or without modification, is
+** permitted provided that the following conditions are met:
+**
+** 1. Redistributions of this source file must retain the above copyright
+**    notice, this list of conditions and the following disclaimer.
+**
+** 2. Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and/or other materials provided with the distribution.
+**
+** THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+** WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO
+** EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+** PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+** OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+** WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+** OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+** ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+** =============================================================================
+**/
+#include "FmGuiCore.hpp"
+
+#include <imgui.h>
+
+#include <cstdio>
+#include <chrono>
+
+/*
+ * Times FmGui::Core::Frame with the widgets hidden, which is all the present
+ * hook runs per Present before forwarding to DCS: World, against a call that
+ * does nothing. The difference is what FmGui costs while hidden. A frame with
+ * the widgets shown is timed as well for scale. Runs on the null renderer.
+ * Build with -DFMGUI_BUILD_BENCHMARKS=ON.
+ */
+
+static void DoNothing(void);
+static void DemoRoutine(void);
+template <typename Function>
+static double TimeCalls(Function function);
+
+// Called through a volatile pointer so the baseline call is not optimized out.
+static void (*volatile pBaseline)(void) = DoNothing;
+
+static void
+DoNothing(void)
+{
+}
+
+static void
+DemoRoutine(void)
+{
+	ImGui::Begin("Benchmark");
+	for (int line = 0; line < 20; ++line)
+		ImGui::Text("Line %d: %f", line, line * 0.5f);
+	ImGui::End();
+}
+
+/*
+ * Nanoseconds per call of function, repeated until about 200 ms were spent.
+ */
+template <typename Function>
+static double
+TimeCalls(Function function)
+{
+	std::size_t callCount = 0;
+	const std::chrono::steady_clock::time_point start =
+		std::chrono::steady_clock::now();
+	std::chrono::steady_clock::duration elapsed;
+	do {
+		for (int repetition = 0; repetition < 1000; ++repetition)
+			function();
+		callCount += 1000;
+		elapsed = std::chrono::steady_clock::now() - start;
+	} while (elapsed < std::chrono::milliseconds(200));
+	return std::chrono::duration<double, std::nano>(elapsed).count()
+		/ static_cast<double>(callCount);
+}
+
+int
+main(void)
+{
+	FmGuiNullRendererData nullRendererData = { 1920.0f, 1080.0f,
+											   1.0f / 60.0f };
+	FmGui::Core::SetRenderer(FmGui::Core::MakeNullRenderer(&nullRendererData));
+	FmGui::Core::Startup();
+	FmGui::SetRoutinePtr(DemoRoutine);
+	// Initialize and warm up with the widgets shown.
+	FmGui::SetWidgetVisibility(true);
+	for (int frame = 0; frame < 60; ++frame)
+		FmGui::Core::Frame();
+	if (FmGui::Core::GetInitState() != FmGuiInitState::READY) {
+		std::fprintf(stderr, "FmGuiHiddenFrameBenchmark: initialization "
+					 "failed\n");
+		return 1;
+	}
+
+	const double baselineTime = TimeCalls([]() { pBaseline(); });
+	FmGui::SetWidgetVisibility(false);
+	const double hiddenTime = TimeCalls([]() { FmGui::Core::Frame(); });
+	FmGui::SetWidgetVisibility(true);
+	const double shownTime = TimeCalls([]() { FmGui::Core::Frame(); });
+	FmGui::Core::Shutdown();
+
+	std::printf("%-10s %14s %14s\n", "Frame", "Time (ns)", "Overhead (ns)");
+	std::printf("%-10s %14.1f %14s\n", "Baseline", baselineTime, "-");
+	std::printf("%-10s %14.1f %14.1f\n", "Hidden", hiddenTime,
+				hiddenTime - baselineTime);
+	std::printf("%-10s %14.1f %14.1f\n", "Shown", shownTime,
+				shownTime - baselineTime);
+	return 0;
+}
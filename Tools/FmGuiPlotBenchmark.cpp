@@ -0,0 +1,178 @@
+/* =============================================================================
+** DCS-EFM-ImGui, file: FmGuiPlotBenchmark.cpp Created: 17-OCT-2026
+**
+** Copyright 2022 Brian Hoffpauir, USA
+** All rights reserved.
+**
+** Redistribution and use of this source file, with or without modification, is
+** permitted provided that the following conditions are met:
+**
+** 1. Redistributions of this source file must retain the above copyright
+**    notice, this list of conditions and the following disclaimer.
+**
+** 2. Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and/or other materials provided with the distribution.
+**
+** THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+** WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO
+** EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+** PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+** OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+** WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+** OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+** ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+** =============================================================================
+**/
+#include "FmGuiCore.hpp"
+#include "FmGuiPlot.hpp"
+
+#include <imgui.h>
+#include <implot.h>
+
+#include <cmath>
+#include <cstdio>
+#include <chrono>
+#include <vector>
+
+/*
+ * Times a 1M point FmGui::PlotSeries against the usual vector that is
+ * appended to and erased from the front. Appending is timed per sample, and
+ * FmGui::Core::Frame is timed with a routine that plots the full series in
+ * place and one that first copies it into a contiguous vector, which is what
+ * the vector pattern costs ImPlot per frame. Runs on the null renderer.
+ * Build with -DFMGUI_BUILD_BENCHMARKS=ON.
+ */
+
+struct Point
+{
+	double x, y;
+};
+
+static void AppendToVector(std::vector<Point> &points, double x, double y);
+static void InPlaceRoutine(void);
+static void CopyRoutine(void);
+template <typename Function>
+static double TimeCalls(Function function, int batchSize);
+
+static constexpr std::size_t pointCount = 1000000;
+static FmGui::PlotSeries<double> series(pointCount);
+static std::vector<Point> vectorPoints;
+static std::vector<Point> copiedPoints;
+static double nextX = 0.0;
+
+static void
+AppendToVector(std::vector<Point> &points, double x, double y)
+{
+	if (points.size() == pointCount)
+		points.erase(points.begin());
+	const Point point = { x, y };
+	points.push_back(point);
+}
+
+static void
+InPlaceRoutine(void)
+{
+	ImGui::SetNextWindowSize(ImVec2(1280.0f, 720.0f));
+	ImGui::Begin("Benchmark");
+	if (ImPlot::BeginPlot("Series", ImVec2(-1.0f, -1.0f))) {
+		series.PlotLine("In place");
+		ImPlot::EndPlot();
+	}
+	ImGui::End();
+}
+
+static void
+CopyRoutine(void)
+{
+	copiedPoints.resize(series.GetSize());
+	for (std::size_t index = 0; index < copiedPoints.size(); ++index) {
+		copiedPoints[index].x = series[index].x;
+		copiedPoints[index].y = series[index].y;
+	}
+	ImGui::SetNextWindowSize(ImVec2(1280.0f, 720.0f));
+	ImGui::Begin("Benchmark");
+	if (ImPlot::BeginPlot("Series", ImVec2(-1.0f, -1.0f))) {
+		ImPlot::PlotLine("Copied", &copiedPoints[0].x, &copiedPoints[0].y,
+						 static_cast<int>(copiedPoints.size()), 0,
+						 static_cast<int>(sizeof(Point)));
+		ImPlot::EndPlot();
+	}
+	ImGui::End();
+}
+
+/*
+ * Nanoseconds per call of function, called in batches of batchSize until
+ * about 200 ms were spent.
+ */
+template <typename Function>
+static double
+TimeCalls(Function function, int batchSize)
+{
+	std::size_t callCount = 0;
+	const std::chrono::steady_clock::time_point start =
+		std::chrono::steady_clock::now();
+	std::chrono::steady_clock::duration elapsed;
+	do {
+		for (int repetition = 0; repetition < batchSize; ++repetition)
+			function();
+		callCount += static_cast<std::size_t>(batchSize);
+		elapsed = std::chrono::steady_clock::now() - start;
+	} while (elapsed < std::chrono::milliseconds(200));
+	return std::chrono::duration<double, std::nano>(elapsed).count()
+		/ static_cast<double>(callCount);
+}
+
+int
+main(void)
+{
+	// Fill both to capacity, so every timed append replaces the oldest point.
+	vectorPoints.reserve(pointCount);
+	for (std::size_t index = 0; index < pointCount; ++index) {
+		const double y = std::sin(nextX);
+		series.Append(nextX, y);
+		AppendToVector(vectorPoints, nextX, y);
+		nextX += 0.001;
+	}
+	const double seriesAppendTime = TimeCalls([]() {
+		series.Append(nextX, std::sin(nextX));
+		nextX += 0.001;
+	}, 1000);
+	const double vectorAppendTime = TimeCalls([]() {
+		AppendToVector(vectorPoints, nextX, std::sin(nextX));
+		nextX += 0.001;
+	}, 10);
+
+	FmGuiNullRendererData nullRendererData = { 1920.0f, 1080.0f,
+											   1.0f / 60.0f };
+	FmGui::Core::SetRenderer(FmGui::Core::MakeNullRenderer(&nullRendererData));
+	FmGui::Core::Startup();
+	FmGui::SetRoutinePtr(InPlaceRoutine);
+	FmGui::SetWidgetVisibility(true);
+	for (int frame = 0; frame < 10; ++frame)
+		FmGui::Core::Frame();
+	if (FmGui::Core::GetInitState() != FmGuiInitState::READY) {
+		std::fprintf(stderr, "FmGuiPlotBenchmark: initialization failed\n");
+		return 1;
+	}
+	const double inPlaceFrameTime =
+		TimeCalls([]() { FmGui::Core::Frame(); }, 1);
+	FmGui::SetRoutinePtr(CopyRoutine);
+	FmGui::Core::Frame();
+	const double copyFrameTime = TimeCalls([]() { FmGui::Core::Frame(); }, 1);
+	FmGui::Core::Shutdown();
+
+	std::printf("%u points\n", static_cast<unsigned int>(pointCount));
+	std::printf("%-18s %14s %10s\n", "Case", "Time (us)", "Speedup");
+	std::printf("%-18s %14.3f %9.2fx\n", "Append vector",
+				vectorAppendTime * 1.0e-3, 1.0);
+	std::printf("%-18s %14.3f %9.2fx\n", "Append series",
+				seriesAppendTime * 1.0e-3, vectorAppendTime / seriesAppendTime);
+	std::printf("%-18s %14.3f %9.2fx\n", "Frame copied", copyFrameTime * 1.0e-3,
+				1.0);
+	std::printf("%-18s %14.3f %9.2fx\n", "Frame in place",
+				inPlaceFrameTime * 1.0e-3, copyFrameTime / inPlaceFrameTime);
+	return 0;
+}
@@ -0,0 +1,149 @@
+/* =============================================================================
+** DCS-EFM-ImGui, file: DefaultPanels.cpp Created: 17-OCT-2026
+**
+** Copyright 2022 Brian Hoffpauir, USA
+** All rights reserved.
+**
+** Redistribution and use of this source file, with or without modification, is
+** permitted provided that the following conditions are met:
+**
+** 1. Redistributions of this source file must retain the above copyright
+**    notice, this list of conditions and the following disclaimer.
+**
+** 2. Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and/or other materials provided with the distribution.
+**
+** THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+** WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO
+** EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+** PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+** OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+** WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+** OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+** ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+** =============================================================================
+**/
+#include "FmGuiReplay.hpp"
+
+#if defined FMGUI_ENABLE_IMPLOT
+#include "FmGuiPlot.hpp"
+#endif
+
+#include <imgui.h>
+
+#include <cfloat>
+#include <cstddef>
+#include <cstdio>
+#include <vector>
+
+/*
+ * Panels FmGuiReplay draws when FMGUI_REPLAY_PANEL_SOURCES is not set: a plot
+ * of every recorded channel. They are also a template for your own panel
+ * sources.
+ */
+
+static void PublishRow(double time, const float *pValues);
+static void ResetPanels(void);
+static void PanelRoutine(void);
+
+static const FmGui::Recording *pRecording = nullptr;
+static std::vector<float> latestValues;
+#if defined FMGUI_ENABLE_IMPLOT
+// Long enough for half an hour at 100 Hz at any zoom level.
+static constexpr std::size_t historyCapacity = 1 << 18;
+static std::vector<FmGui::PlotHistory<double>> histories;
+#else
+// Ring of the last samples of each channel, channel after channel.
+static constexpr std::size_t historyCapacity = 1024;
+static std::vector<float> histories;
+static std::size_t historyHead = 0, historyCount = 0;
+#endif
+
+bool
+FmGui::Replay::SetupPanels(const Recording &recording,
+						   FmGuiReplayPanels &panels)
+{
+	const std::size_t channelCount = recording.GetChannelCount();
+	pRecording = &recording;
+	latestValues.assign(channelCount, 0.0f);
+#if defined FMGUI_ENABLE_IMPLOT
+	histories.clear();
+	histories.reserve(channelCount);
+	for (std::size_t channel = 0; channel < channelCount; ++channel)
+		histories.emplace_back(historyCapacity);
+#else
+	histories.assign(channelCount * historyCapacity, 0.0f);
+	historyHead = historyCount = 0;
+#endif
+	panels.pRoutine = PanelRoutine;
+	panels.pPublish = PublishRow;
+	panels.pReset = ResetPanels;
+	return true;
+}
+
+static void
+PublishRow(double time, const float *pValues)
+{
+	latestValues.assign(pValues, pValues + latestValues.size());
+#if defined FMGUI_ENABLE_IMPLOT
+	for (std::size_t channel = 0; channel < histories.size(); ++channel)
+		histories[channel].Append(time, static_cast<double>(pValues[channel]));
+#else
+	for (std::size_t channel = 0; channel < latestValues.size(); ++channel)
+		histories[channel * historyCapacity + historyHead] = pValues[channel];
+	historyHead = (historyHead + 1) % historyCapacity;
+	if (historyCount < historyCapacity)
+		++historyCount;
+#endif
+}
+
+static void
+ResetPanels(void)
+{
+#if defined FMGUI_ENABLE_IMPLOT
+	for (FmGui::PlotHistory<double> &history : histories)
+		history.Clear();
+#else
+	historyHead = historyCount = 0;
+#endif
+}
+
+static void
+PanelRoutine(void)
+{
+	if (!pRecording)
+		return;
+	ImGui::Begin("Channels");
+	for (std::size_t channel = 0; channel < latestValues.size(); ++channel) {
+		const char *name = pRecording->GetChannelName(channel).c_str();
+		if (!ImGui::CollapsingHeader(name, ImGuiTreeNodeFlags_DefaultOpen))
+			continue;
+		char overlay[32];
+		std::snprintf(overlay, sizeof(overlay), "%g",
+					  static_cast<double>(latestValues[channel]));
+		ImGui::PushID(static_cast<int>(channel));
+#if defined FMGUI_ENABLE_IMPLOT
+		ImGui::TextUnformatted(overlay);
+		if (ImPlot::BeginPlot("##Channel", ImVec2(-1.0f, 150.0f))) {
+			ImPlot::SetupAxes("Time (s)", nullptr, ImPlotAxisFlags_AutoFit,
+							  ImPlotAxisFlags_AutoFit);
+			histories[channel].PlotLine(name);
+			ImPlot::EndPlot();
+		}
+#else
+		// The oldest sample is at the head once the ring is full.
+		const std::size_t offset = historyCount < historyCapacity ? 0
+			: historyHead;
+		ImGui::PlotLines("##Channel",
+						 histories.data() + channel * historyCapacity,
+						 static_cast<int>(historyCount),
+						 static_cast<int>(offset), overlay, FLT_MAX, FLT_MAX,
+						 ImVec2(-1.0f, 80.0f));
+#endif
+		ImGui::PopID();
+	}
+	ImGui::End();
+}
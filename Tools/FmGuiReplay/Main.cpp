@@ -0,0 +1,575 @@
+/* =============================================================================
+** DCS-EFM-ImGui, file: Main.cpp Created: 17-OCT-2026
+**
+** Copyright 2022 Brian Hoffpauir, USA
+** All rights reserved.
+**
+** Redistribution and use of this source file, with or without modification, is
+** permitted provided that the following conditions are met:
+**
+** 1. Redistributions of this source file must retain the above copyright
+**    notice, this list of conditions and the following disclaimer.
+**
+** 2. Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and/or other materials provided with the distribution.
+**
+** THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+** WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO
+** EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+** PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+** OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+** WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+** OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+** ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+** =============================================================================
+**/
+#include "FmGuiCore.hpp"
+#include "FmGuiAllocator.hpp"
+#include "FmGuiInput.hpp"
+#include "FmGuiRecorder.hpp"
+#include "FmGuiReplay.hpp"
+
+#include <imgui.h>
+#if defined FMGUI_REPLAY_GLFW
+#include <imgui_impl_glfw.h>
+#include <imgui_impl_opengl3.h>
+#include <GLFW/glfw3.h>
+#endif
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <chrono>
+#include <new>
+#include <vector>
+
+/*
+ * FmGuiReplay plays a recording of FmGui::Recorder back through the panels
+ * compiled in from FMGUI_REPLAY_PANEL_SOURCES, see FmGuiReplay.hpp.
+ *
+ * Usage: FmGuiReplay [options] <recording>
+ *     --headless    Run with the null renderer, even if GLFW is available.
+ *     --speed <x>   Replay speed, 1 is real time. Default: 1.
+ *     --start <s>   Recording time to start from. Default: the start.
+ *     --frames <n>  Stop after n frames. Default: at the end of the recording.
+ *     --dt <s>      Time step of a headless frame. Default: 1/60.
+ *     --input <f>   Replay an input recording of FmGui::Input, one recorded
+ *                   frame of events per frame.
+ *     --max-frame-allocs <n>
+ *                   Fail a headless run if a frame after the warm up makes
+ *                   more than n allocations.
+ *     --warmup <n>  Frames before the steady state. Default: 60.
+ *
+ * A headless run advances the replay by the fixed time step every frame and
+ * runs the frames back to back, so the same command line renders the same
+ * frames on every machine. It prints the frame statistics at the end, which
+ * makes it a load generator for measuring the cost of the panels on a CI box.
+ * With --input it runs until both the recording and the input have ended.
+ *
+ * With --max-frame-allocs it guards the steady state against allocations. The
+ * count of a frame covers ImGui's allocations through FmGui::Allocator and
+ * every operator new of the main thread, which this file replaces, so FmGui's
+ * own containers and those of the panels are caught as well.
+ */
+
+struct ReplayOptions
+{
+	const char *fileName;
+	const char *inputFileName;
+	bool isHeadless;
+	double speed;
+	double startTime;
+	unsigned long frameLimit;
+	float deltaTime;
+	long maxFrameAllocations; // Negative for no limit.
+	unsigned long warmupFrameCount;
+};
+
+static bool ParseOptions(int argc, char **argv, ReplayOptions &options);
+static void PrintMessage(const FmGuiMessage &message);
+static void LoadChunk(std::size_t chunk);
+static void Seek(double time);
+static void Advance(double deltaTime);
+static void ReplayRoutine(void);
+static void PrintFrameStats(unsigned long frameCount);
+static bool CheckFrameAllocations(unsigned long frame, long maxAllocations,
+								  bool isReported);
+static int RunHeadless(const ReplayOptions &options);
+#if defined FMGUI_REPLAY_GLFW
+static bool GlfwRendererInitialize(void *pUserData);
+static bool GlfwRendererNewFrame(void *pUserData);
+static void GlfwRendererRenderDrawData(ImDrawData *pDrawData,
+									   void *pUserData);
+static void GlfwRendererPresent(void *pUserData);
+static void *GlfwRendererCreateTexture(unsigned int width,
+									   unsigned int height, void *pUserData);
+static bool GlfwRendererUpdateTexture(void *pTexture, unsigned int y,
+									  unsigned int height,
+									  const std::uint32_t *pPixels,
+									  void *pUserData);
+static void GlfwRendererDestroyTexture(void *pTexture, void *pUserData);
+static int RunWindowed(const ReplayOptions &options);
+#endif
+// Playback state. Everything runs on the main thread.
+static FmGui::Recording recording;
+static FmGuiReplayPanels panels;
+static FmGuiRecordingChunk currentChunk;
+static std::size_t chunkIndex = 0, chunkRow = 0;
+static std::vector<float> rowValues;
+static double replayTime = 0.0, replaySpeed = 1.0;
+static bool isPlaying = true;
+static std::uint64_t publishedRowCount = 0;
+// Only the main thread runs frames.
+static thread_local bool isMainThread = false;
+
+void *
+operator new(std::size_t size)
+{
+	if (isMainThread)
+		FmGui::Allocator::CountExternalAllocation();
+	void *pMemory = std::malloc(size != 0 ? size : 1);
+	if (pMemory == nullptr)
+		throw std::bad_alloc();
+	return pMemory;
+}
+
+void
+operator delete(void *pMemory) noexcept
+{
+	std::free(pMemory);
+}
+
+int
+main(int argc, char **argv)
+{
+	isMainThread = true;
+	ReplayOptions options;
+	if (!ParseOptions(argc, argv, options)) {
+		std::fprintf(stderr,
+					 "Usage: FmGuiReplay [--headless] [--speed x] "
+					 "[--start s] [--frames n] [--dt s] [--input file] "
+					 "[--max-frame-allocs n] [--warmup n] <recording>\n");
+		return EXIT_FAILURE;
+	}
+	FmGui::SetMessageCallback(PrintMessage);
+	if (!recording.Open(options.fileName)) {
+		std::fprintf(stderr, "FmGuiReplay: cannot open %s\n",
+					 options.fileName);
+		return EXIT_FAILURE;
+	}
+	if (recording.GetChunks().empty()) {
+		std::fprintf(stderr, "FmGuiReplay: %s holds no data\n",
+					 options.fileName);
+		return EXIT_FAILURE;
+	}
+	if (!FmGui::Replay::SetupPanels(recording, panels)
+		|| panels.pPublish == nullptr) {
+		std::fprintf(stderr, "FmGuiReplay: the panels failed to set up\n");
+		return EXIT_FAILURE;
+	}
+	if (options.inputFileName != nullptr
+		&& !FmGui::Input::StartReplay(options.inputFileName)) {
+		return EXIT_FAILURE;
+	}
+	rowValues.resize(recording.GetChannelCount());
+	replaySpeed = options.speed;
+	Seek(std::max(options.startTime, recording.GetStartTime()));
+
+#if defined FMGUI_REPLAY_GLFW
+	if (!options.isHeadless)
+		return RunWindowed(options);
+#endif
+	return RunHeadless(options);
+}
+
+static bool
+ParseOptions(int argc, char **argv, ReplayOptions &options)
+{
+	options.fileName = nullptr;
+	options.inputFileName = nullptr;
+	options.isHeadless = false;
+	options.speed = 1.0;
+	options.startTime = 0.0;
+	options.frameLimit = 0;
+	options.deltaTime = 1.0f / 60.0f;
+	options.maxFrameAllocations = -1;
+	options.warmupFrameCount = 60;
+	for (int index = 1; index < argc; ++index) {
+		const char *argument = argv[index];
+		const bool hasValue = index + 1 < argc;
+		if (std::strcmp(argument, "--headless") == 0) {
+			options.isHeadless = true;
+		} else if (std::strcmp(argument, "--speed") == 0 && hasValue) {
+			options.speed = std::strtod(argv[++index], nullptr);
+		} else if (std::strcmp(argument, "--start") == 0 && hasValue) {
+			options.startTime = std::strtod(argv[++index], nullptr);
+		} else if (std::strcmp(argument, "--frames") == 0 && hasValue) {
+			options.frameLimit = std::strtoul(argv[++index], nullptr, 10);
+		} else if (std::strcmp(argument, "--dt") == 0 && hasValue) {
+			options.deltaTime = std::strtof(argv[++index], nullptr);
+		} else if (std::strcmp(argument, "--input") == 0 && hasValue) {
+			options.inputFileName = argv[++index];
+		} else if (std::strcmp(argument, "--max-frame-allocs") == 0
+				   && hasValue) {
+			options.maxFrameAllocations =
+				std::strtol(argv[++index], nullptr, 10);
+		} else if (std::strcmp(argument, "--warmup") == 0 && hasValue) {
+			options.warmupFrameCount = std::strtoul(argv[++index], nullptr, 10);
+		} else if (argument[0] != '-' && options.fileName == nullptr) {
+			options.fileName = argument;
+		} else {
+			return false;
+		}
+	}
+	return options.fileName != nullptr && options.speed > 0.0
+		&& options.deltaTime > 0.0f;
+}
+
+static void
+PrintMessage(const FmGuiMessage &message)
+{
+	std::fprintf(stderr, "FmGui: %s\n", message.content);
+}
+
+static void
+LoadChunk(std::size_t chunk)
+{
+	chunkIndex = chunk;
+	chunkRow = 0;
+	// A chunk that cannot be read is skipped.
+	if (!recording.ReadChunk(chunk, currentChunk)) {
+		currentChunk.times.clear();
+		currentChunk.values.clear();
+	}
+}
+
+/*
+ * Positions the replay at time. Rows at or after time are published by the
+ * next Advance.
+ */
+static void
+Seek(double time)
+{
+	time = std::min(std::max(time, recording.GetStartTime()),
+					recording.GetEndTime());
+	if (panels.pReset != nullptr)
+		panels.pReset();
+	LoadChunk(recording.FindChunk(time));
+	chunkRow = static_cast<std::size_t>(
+		std::lower_bound(currentChunk.times.begin(), currentChunk.times.end(),
+						 time) - currentChunk.times.begin());
+	replayTime = time;
+}
+
+/*
+ * Publishes every row up to the replay time advanced by deltaTime seconds
+ * of wall time at the replay speed.
+ */
+static void
+Advance(double deltaTime)
+{
+	if (!isPlaying)
+		return;
+	const double endTime = recording.GetEndTime();
+	const double targetTime = replayTime + deltaTime * replaySpeed;
+	const std::size_t chunkCount = recording.GetChunks().size();
+	for (;;) {
+		const std::size_t rowCount = currentChunk.times.size();
+		if (chunkRow >= rowCount) {
+			if (chunkIndex + 1 >= chunkCount)
+				break;
+			LoadChunk(chunkIndex + 1);
+			continue;
+		}
+		const double rowTime = currentChunk.times[chunkRow];
+		if (rowTime > targetTime)
+			break;
+		// Gather the row from the columns of the chunk.
+		for (std::size_t channel = 0; channel < rowValues.size(); ++channel)
+			rowValues[channel] = currentChunk.GetColumn(channel)[chunkRow];
+		panels.pPublish(rowTime, rowValues.data());
+		++chunkRow;
+		++publishedRowCount;
+	}
+	replayTime = std::min(targetTime, endTime);
+	if (replayTime >= endTime)
+		isPlaying = false;
+}
+
+static void
+ReplayRoutine(void)
+{
+	const double startTime = recording.GetStartTime();
+	const double endTime = recording.GetEndTime();
+	ImGui::Begin("FmGui Replay");
+	if (ImGui::Button(isPlaying ? "Pause" : "Play")) {
+		// Playing from the end starts over.
+		if (!isPlaying && replayTime >= endTime)
+			Seek(startTime);
+		isPlaying = !isPlaying;
+	}
+	ImGui::SameLine();
+	float speed = static_cast<float>(replaySpeed);
+	if (ImGui::SliderFloat("Speed", &speed, 0.1f, 100.0f, "%.1fx",
+						   ImGuiSliderFlags_Logarithmic)) {
+		replaySpeed = speed;
+	}
+	float position = static_cast<float>(replayTime - startTime);
+	if (ImGui::SliderFloat("Time", &position, 0.0f,
+						   static_cast<float>(endTime - startTime), "%.3f s")) {
+		Seek(startTime + position);
+	}
+	ImGui::Text("Chunk %zu of %zu, %llu rows published%s", chunkIndex + 1,
+				recording.GetChunks().size(),
+				static_cast<unsigned long long>(publishedRowCount),
+				recording.IsRecovered() ? ", recovered file" : "");
+	ImGui::End();
+	if (panels.pRoutine != nullptr)
+		panels.pRoutine();
+}
+
+static void
+PrintFrameStats(unsigned long frameCount)
+{
+	static constexpr const char *stageNames[] = {
+		"NewFrame", "Routine", "Render", "RenderDrawData", "Present"
+	};
+	const FmGuiFrameStats frameStats = FmGui::GetFrameStats();
+	std::printf("%lu frames, %llu rows published, statistics of the last "
+				"%zu frames:\n", frameCount,
+				static_cast<unsigned long long>(publishedRowCount),
+				frameStats.frameCount);
+	std::printf("%-16s %10s %10s %10s %10s %8s %8s\n", "Stage (us)", "Last",
+				"Min", "Average", "p99", "Allocs", "Max");
+	const std::size_t stageCount = sizeof(stageNames) / sizeof(stageNames[0]);
+	for (std::size_t row = 0; row < stageCount + 2; ++row) {
+		const bool isOverhead = row == stageCount;
+		const bool isTotal = row == stageCount + 1;
+		const FmGuiStageStats &stats = isOverhead ? frameStats.overhead
+			: isTotal ? frameStats.total : frameStats.stages[row];
+		std::printf("%-16s %10.1f %10.1f %10.1f %10.1f %8u %8u\n",
+					isOverhead ? "FmGui" : isTotal ? "Total" : stageNames[row],
+					stats.last, stats.minimum, stats.average, stats.p99,
+					stats.lastAllocationCount, stats.maxAllocationCount);
+	}
+}
+
+/*
+ * Returns false if the last frame made more than maxAllocations allocations,
+ * and with isReported prints them by stage.
+ */
+static bool
+CheckFrameAllocations(unsigned long frame, long maxAllocations,
+					  bool isReported)
+{
+	const FmGuiFrameStats frameStats = FmGui::GetFrameStats();
+	const FmGuiStageStats *const stages = frameStats.stages;
+	if (frameStats.total.lastAllocationCount
+		<= static_cast<unsigned long>(maxAllocations)) {
+		return true;
+	}
+	if (!isReported)
+		return false;
+	std::fprintf(stderr, "FmGuiReplay: frame %lu made %u allocations, over "
+				 "the limit of %ld (NewFrame %u, Routine %u, Render %u, "
+				 "RenderDrawData %u, Present %u)\n", frame,
+				 frameStats.total.lastAllocationCount, maxAllocations,
+				 stages[0].lastAllocationCount, stages[1].lastAllocationCount,
+				 stages[2].lastAllocationCount, stages[3].lastAllocationCount,
+				 stages[4].lastAllocationCount);
+	return false;
+}
+
+static int
+RunHeadless(const ReplayOptions &options)
+{
+	FmGuiNullRendererData nullRendererData;
+	nullRendererData.displayWidth = 1920.0f;
+	nullRendererData.displayHeight = 1080.0f;
+	nullRendererData.deltaTime = options.deltaTime;
+	FmGui::Core::SetRenderer(FmGui::Core::MakeNullRenderer(&nullRendererData));
+	if (!FmGui::Core::Startup())
+		return EXIT_FAILURE;
+	FmGui::SetRoutinePtr(ReplayRoutine);
+	FmGui::SetWidgetVisibility(true);
+
+	unsigned long frameCount = 0, overLimitFrameCount = 0;
+	while (options.frameLimit != 0 ? frameCount < options.frameLimit
+		   : isPlaying || FmGui::Input::IsReplaying()) {
+		Advance(options.deltaTime);
+		if (FmGui::Core::Frame()) {
+			++frameCount;
+			if (options.maxFrameAllocations >= 0
+				&& frameCount > options.warmupFrameCount
+				&& !CheckFrameAllocations(frameCount,
+										  options.maxFrameAllocations,
+										  overLimitFrameCount < 10)) {
+				++overLimitFrameCount;
+			}
+		} else if (FmGui::Core::GetInitState() == FmGuiInitState::GAVE_UP) {
+			break;
+		}
+	}
+	const bool isReady =
+		FmGui::Core::GetInitState() == FmGuiInitState::READY;
+	if (isReady)
+		PrintFrameStats(frameCount);
+	FmGui::Core::Shutdown();
+	if (overLimitFrameCount > 0) {
+		std::fprintf(stderr, "FmGuiReplay: %lu of %lu frames were over the "
+					 "allocation limit\n", overLimitFrameCount, frameCount);
+		return EXIT_FAILURE;
+	}
+	return isReady ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+#if defined FMGUI_REPLAY_GLFW
+static GLFWwindow *pWindow = nullptr;
+
+static bool
+GlfwRendererInitialize(void *pUserData)
+{
+	// Keeps track of its progress, as a failed attempt is retried.
+	static bool isGlfwInitialized = false;
+	if (!isGlfwInitialized) {
+		if (!ImGui_ImplGlfw_InitForOpenGL(pWindow, true))
+			return false;
+		isGlfwInitialized = true;
+	}
+	return ImGui_ImplOpenGL3_Init("#version 130");
+}
+
+static bool
+GlfwRendererNewFrame(void *pUserData)
+{
+	glfwPollEvents();
+	ImGui_ImplOpenGL3_NewFrame();
+	ImGui_ImplGlfw_NewFrame();
+	return true;
+}
+
+static void
+GlfwRendererRenderDrawData(ImDrawData *pDrawData, void *pUserData)
+{
+	int width = 0, height = 0;
+	glfwGetFramebufferSize(pWindow, &width, &height);
+	glViewport(0, 0, width, height);
+	glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
+	glClear(GL_COLOR_BUFFER_BIT);
+	ImGui_ImplOpenGL3_RenderDrawData(pDrawData);
+}
+
+static void
+GlfwRendererPresent(void *pUserData)
+{
+	glfwSwapBuffers(pWindow);
+}
+
+/*
+ * The OpenGL3 backend takes the texture name as its ImTextureID. Only OpenGL
+ * 1.1 calls are used, so no loader is needed.
+ */
+static void *
+GlfwRendererCreateTexture(unsigned int width, unsigned int height,
+						  void *pUserData)
+{
+	if (width == 0 || height == 0)
+		return nullptr;
+	GLuint texture = 0;
+	glGenTextures(1, &texture);
+	if (texture == 0)
+		return nullptr;
+	glBindTexture(GL_TEXTURE_2D, texture);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, static_cast<GLsizei>(width),
+				 static_cast<GLsizei>(height), 0, GL_RGBA, GL_UNSIGNED_BYTE,
+				 nullptr);
+	return reinterpret_cast<void *>(static_cast<std::intptr_t>(texture));
+}
+
+static bool
+GlfwRendererUpdateTexture(void *pTexture, unsigned int y, unsigned int height,
+						  const std::uint32_t *pPixels, void *pUserData)
+{
+	if (!pTexture || !pPixels || height == 0)
+		return false;
+	const GLuint texture =
+		static_cast<GLuint>(reinterpret_cast<std::intptr_t>(pTexture));
+	GLint width = 0;
+	glBindTexture(GL_TEXTURE_2D, texture);
+	glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_WIDTH, &width);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+	glTexSubImage2D(GL_TEXTURE_2D, 0, 0, static_cast<GLint>(y), width,
+					static_cast<GLsizei>(height), GL_RGBA, GL_UNSIGNED_BYTE,
+					pPixels);
+	return true;
+}
+
+static void
+GlfwRendererDestroyTexture(void *pTexture, void *pUserData)
+{
+	const GLuint texture =
+		static_cast<GLuint>(reinterpret_cast<std::intptr_t>(pTexture));
+	glDeleteTextures(1, &texture);
+}
+
+static int
+RunWindowed(const ReplayOptions &options)
+{
+	if (!glfwInit())
+		return EXIT_FAILURE;
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 0);
+	pWindow = glfwCreateWindow(1600, 900, "FmGuiReplay", nullptr, nullptr);
+	if (!pWindow) {
+		glfwTerminate();
+		return EXIT_FAILURE;
+	}
+	glfwMakeContextCurrent(pWindow);
+	glfwSwapInterval(1);
+
+	FmGuiRenderer glfwRenderer;
+	glfwRenderer.pInitialize = GlfwRendererInitialize;
+	glfwRenderer.pNewFrame = GlfwRendererNewFrame;
+	glfwRenderer.pRenderDrawData = GlfwRendererRenderDrawData;
+	glfwRenderer.pPresent = GlfwRendererPresent;
+	glfwRenderer.pCreateTexture = GlfwRendererCreateTexture;
+	glfwRenderer.pUpdateTexture = GlfwRendererUpdateTexture;
+	glfwRenderer.pDestroyTexture = GlfwRendererDestroyTexture;
+	FmGui::Core::SetRenderer(glfwRenderer);
+	FmGui::Core::Startup();
+	FmGui::SetRoutinePtr(ReplayRoutine);
+	FmGui::SetWidgetVisibility(true);
+
+	unsigned long frameCount = 0;
+	std::chrono::steady_clock::time_point lastTime =
+		std::chrono::steady_clock::now();
+	while (!glfwWindowShouldClose(pWindow)
+		   && (options.frameLimit == 0 || frameCount < options.frameLimit)) {
+		const std::chrono::steady_clock::time_point now =
+			std::chrono::steady_clock::now();
+		Advance(std::chrono::duration<double>(now - lastTime).count());
+		lastTime = now;
+		if (FmGui::Core::Frame())
+			++frameCount;
+		else if (FmGui::Core::GetInitState() == FmGuiInitState::GAVE_UP)
+			break;
+	}
+
+	if (FmGui::Core::GetInitState() == FmGuiInitState::READY) {
+		ImGui_ImplOpenGL3_Shutdown();
+		ImGui_ImplGlfw_Shutdown();
+	}
+	FmGui::Core::Shutdown();
+	glfwDestroyWindow(pWindow);
+	glfwTerminate();
+	return EXIT_SUCCESS;
+}
+#endif
@@ -0,0 +1,93 @@
+/* =============================================================================
+** DCS-EFM-ImGui, file: FmGuiStatsBenchmark.cpp Created: 17-OCT-2026
+**
+** Copyright 2022 Brian Hoffpauir, USA
+** All rights reserved.
+**
+** Redistribution and use of this source file, with or without modification, is
+** permitted provided that the following conditions are met:
+**
+** 1. Redistributions of this source file must retain the above copyright
+**    notice, this list of conditions and the following disclaimer.
+**
+** 2. Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and/or other materials provided with the distribution.
+**
+** THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+** WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO
+** EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+** PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+** OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+** WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+** OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+** ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+** =============================================================================
+**/
+#include "FmGuiStats.hpp"
+
+#include <cstdio>
+#include <chrono>
+#include <random>
+#include <vector>
+
+/*
+ * Times FmGui::ComputeWindowStats at every SIMD level the CPU supports against
+ * the scalar baseline, for window sizes from a panel's second of samples up to
+ * a million samples. Build with -DFMGUI_BUILD_BENCHMARKS=ON.
+ */
+
+static double
+TimeWindowStats(const std::vector<float> &values, std::size_t count,
+				FmGuiWindowStats &stats)
+{
+	// Repeat until about 50 ms were spent, after one warm up call.
+	stats = FmGui::ComputeWindowStats(values.data(), count);
+	std::size_t repetitionCount = 0;
+	const std::chrono::steady_clock::time_point start =
+		std::chrono::steady_clock::now();
+	std::chrono::steady_clock::duration elapsed;
+	do {
+		stats = FmGui::ComputeWindowStats(values.data(), count);
+		++repetitionCount;
+		elapsed = std::chrono::steady_clock::now() - start;
+	} while (elapsed < std::chrono::milliseconds(50));
+	return std::chrono::duration<double, std::micro>(elapsed).count()
+		/ static_cast<double>(repetitionCount);
+}
+
+int
+main(void)
+{
+	static constexpr const char *simdLevelNames[] = { "Scalar", "SSE2", "AVX2" };
+	static constexpr std::size_t windowSizes[] = {
+		1000, 4096, 65536, 1000000
+	};
+	std::vector<float> values(1000000);
+	std::mt19937 generator(1);
+	std::normal_distribution<float> distribution(0.0f, 1.0f);
+	for (float &value : values)
+		value = distribution(generator);
+
+	const FmGuiSimdLevel supportedLevel =
+		FmGui::SetSimdLevel(FmGuiSimdLevel::AVX2);
+	std::printf("%-8s %10s %12s %10s %12s\n", "Level", "Window", "Time (us)",
+				"Speedup", "RMS");
+	for (std::size_t windowSize : windowSizes) {
+		double scalarTime = 0.0;
+		for (int level = 0; level <= static_cast<int>(supportedLevel); ++level) {
+			FmGui::SetSimdLevel(static_cast<FmGuiSimdLevel>(level));
+			FmGuiWindowStats stats;
+			const double time = TimeWindowStats(values, windowSize, stats);
+			if (level == 0)
+				scalarTime = time;
+			std::printf("%-8s %10u %12.3f %9.2fx %12.6f\n",
+						simdLevelNames[level],
+						static_cast<unsigned int>(windowSize), time,
+						scalarTime / time, stats.rms);
+		}
+	}
+	return 0;
+}